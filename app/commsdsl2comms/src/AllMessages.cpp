@@ -15,7 +15,6 @@
 
 #include "AllMessages.h"
 
-#include <fstream>
 
 #include <boost/filesystem.hpp>
 
@@ -64,7 +63,7 @@ bool AllMessages::writeProtocolDefinition() const
         elem.m_realPlatform = false;
     }
 
-    auto allMessages = m_generator.getAllDslMessages();
+    auto& allMessages = m_generator.getAllDslMessages();
 
     for (auto& p : platformsMap) {
         auto updateFunc = 
@@ -173,12 +172,6 @@ bool AllMessages::writeProtocolDefinition() const
                 return true;
             }
 
-            std::ofstream stream(filePath);
-            if (!stream) {
-                m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-                return false;
-            }
-
             common::ReplacementMap replacements;
             auto namespaces = m_generator.namespacesForInput();
             replacements.insert(std::make_pair("GEN_COMMENT", m_generator.fileGeneratedComment()));
@@ -217,14 +210,7 @@ bool AllMessages::writeProtocolDefinition() const
             );
 
             auto str = common::processTemplate(Template, replacements);
-            stream << str;
-
-            stream.flush();
-            if (!stream.good()) {
-                m_generator.logger().error("Failed to write \"" + filePath + "\".");
-                return false;
-            }
-            return true;
+            return m_generator.writeOutputFile(filePath, str);
         };
 
         for (auto& p : platformsMap) {
@@ -271,7 +257,7 @@ bool AllMessages::writeProtocolDefinition() const
 bool AllMessages::writePluginDefinition() const
 {
 
-    auto allMessages = m_generator.getAllDslMessages();
+    auto& allMessages = m_generator.getAllDslMessages();
     common::StringsList messages;
     common::StringsList includes;
     messages.reserve(allMessages.size());
@@ -366,12 +352,6 @@ bool AllMessages::writePluginDefinition() const
                 return true;
             }
 
-            std::ofstream stream(filePath);
-            if (!stream) {
-                m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-                return false;
-            }
-
             common::ReplacementMap replacements;
             auto namespaces = m_generator.namespacesForInputInPlugin();
             replacements.insert(std::make_pair("GEN_COMMENT", m_generator.fileGeneratedComment()));
@@ -400,14 +380,7 @@ bool AllMessages::writePluginDefinition() const
             );            
 
             auto str = common::processTemplate(Template, replacements);
-            stream << str;
-
-            stream.flush();
-            if (!stream.good()) {
-                m_generator.logger().error("Failed to write \"" + filePath + "\".");
-                return false;
-            }
-            return true;
+            return m_generator.writeOutputFile(filePath, str);
         };
 
 
@@ -30,7 +30,7 @@ namespace commsdsl2comms
 namespace
 {
 
-const std::string MembersDefTemplate =
+const common::CompiledTemplate MembersDefTemplate(
     "/// @brief Scope for all the member fields of\n"
     "///     @ref #^#CLASS_NAME#$# bitfield.\n"
     "#^#EXTRA_PREFIX#$#\n"
@@ -42,7 +42,7 @@ const std::string MembersDefTemplate =
     "        std::tuple<\n"
     "           #^#MEMBERS#$#\n"
     "        >;\n"
-    "};\n";
+    "};\n");
 
 const std::string MembersOptionsTemplate =
     "/// @brief Extra options for all the member fields of\n"
@@ -52,7 +52,7 @@ const std::string MembersOptionsTemplate =
     "    #^#OPTIONS#$#\n"
     "};\n";
 
-const std::string ClassTemplate(
+const common::CompiledTemplate ClassTemplate(
     "#^#MEMBERS_STRUCT_DEF#$#\n"
     "#^#PREFIX#$#"
     "class #^#CLASS_NAME#$# : public\n"
@@ -136,11 +136,11 @@ void BitfieldField::updatePluginIncludesImpl(Field::IncludesList& includes) cons
     }
 }
 
-std::string BitfieldField::getClassDefinitionImpl(
+common::Fragment BitfieldField::getClassDefinitionImpl(
     const std::string& scope,
     const std::string& className) const
 {
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("PREFIX", getClassPrefix(className)));
     replacements.insert(std::make_pair("CLASS_NAME", className));
     replacements.insert(std::make_pair("ORIG_CLASS_NAME", common::nameToClassCopy(name())));
@@ -159,14 +159,14 @@ std::string BitfieldField::getClassDefinitionImpl(
     replacements.insert(std::make_pair("PROTECTED", getFullProtected()));
     replacements.insert(std::make_pair("PRIVATE", getFullPrivate()));
     if (!replacements["FIELD_OPTS"].empty()) {
-        replacements["COMMA"] = ',';
+        replacements["COMMA"] = ",";
     }
 
     if (!externalRef().empty()) {
         replacements.insert(std::make_pair("MEMBERS_OPT", "<TOpt>"));
     }
 
-    return common::processTemplate(ClassTemplate, replacements);
+    return ClassTemplate.render(replacements);
 }
 
 std::string BitfieldField::getExtraDefaultOptionsImpl(const std::string& scope) const
@@ -184,7 +184,7 @@ std::string BitfieldField::getExtraDataViewDefaultOptionsImpl(const std::string&
     return getExtraOptions(scope, &Field::getDataViewDefaultOptions, base);
 }
 
-std::string BitfieldField::getPluginAnonNamespaceImpl(
+common::Fragment BitfieldField::getPluginAnonNamespaceImpl(
     const std::string& scope,
     bool forcedSerialisedHidden,
     bool serHiddenParam) const
@@ -196,21 +196,21 @@ std::string BitfieldField::getPluginAnonNamespaceImpl(
     }
     fullScope += "::";
 
-    common::StringsList props;
+    common::FragmentsList props;
     for (auto& f : m_members) {
         props.push_back(f->getPluginCreatePropsFunc(fullScope, true, serHiddenParam));
     }
 
-    static const std::string Templ = 
+    static const common::CompiledTemplate Templ(
         "struct #^#CLASS_NAME#$#Members\n"
         "{\n"
         "    #^#PROPS#$#\n"
-        "};\n";
+        "};\n");
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("CLASS_NAME", common::nameToClassCopy(name())));
-    replacements.insert(std::make_pair("PROPS", common::listToString(props, "\n", common::emptyString())));
-    return common::processTemplate(Templ, replacements);
+    replacements.insert(std::make_pair("PROPS", common::Fragment::join(props, "\n")));
+    return Templ.render(replacements);
 }
 
 std::string BitfieldField::getPluginPropertiesImpl(bool serHiddenParam) const
@@ -363,7 +363,7 @@ std::string BitfieldField::getFieldOpts(const std::string& scope) const
     return common::listToString(options, ",\n", common::emptyString());
 }
 
-std::string BitfieldField::getMembersDef(
+common::Fragment BitfieldField::getMembersDef(
     const std::string& scope) const
 {
     auto className = common::nameToClassCopy(name());
@@ -372,7 +372,7 @@ std::string BitfieldField::getMembersDef(
         memberScope = scope + className + common::membersSuffixStr() + "::";
     }
 
-    StringsList membersDefs;
+    common::FragmentsList membersDefs;
     StringsList membersNames;
 
     membersDefs.reserve(m_members.size());
@@ -388,12 +388,12 @@ std::string BitfieldField::getMembersDef(
         prefix += "template <typename TOpt = " + generator().scopeForOptions(common::defaultOptionsStr(), true, true) + ">";
     }
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("CLASS_NAME", className));
     replacements.insert(std::make_pair("EXTRA_PREFIX", std::move(prefix)));
-    replacements.insert(std::make_pair("MEMBERS_DEFS", common::listToString(membersDefs, "\n", common::emptyString())));
+    replacements.insert(std::make_pair("MEMBERS_DEFS", common::Fragment::join(membersDefs, "\n")));
     replacements.insert(std::make_pair("MEMBERS", common::listToString(membersNames, ",\n", common::emptyString())));
-    return common::processTemplate(MembersDefTemplate, replacements);
+    return MembersDefTemplate.render(replacements);
 
 }
 
@@ -34,13 +34,13 @@ protected:
     virtual void updateIncludesImpl(IncludesList& includes) const override;
     virtual void updateIncludesCommonImpl(IncludesList& includes) const override;
     virtual void updatePluginIncludesImpl(IncludesList& includes) const override;
-    virtual std::string getClassDefinitionImpl(
+    virtual common::Fragment getClassDefinitionImpl(
         const std::string& scope,
         const std::string& className) const override;
     virtual std::string getExtraDefaultOptionsImpl(const std::string& scope) const override;
     virtual std::string getExtraBareMetalDefaultOptionsImpl(const std::string& base, const std::string& scope) const override;
     virtual std::string getExtraDataViewDefaultOptionsImpl(const std::string& base, const std::string& scope) const override;
-    virtual std::string getPluginAnonNamespaceImpl(
+    virtual common::Fragment getPluginAnonNamespaceImpl(
         const std::string& scope,
         bool forcedSerialisedHidden,
         bool serHiddenParam) const override;
@@ -58,7 +58,7 @@ private:
 
     std::string getFieldBaseParams() const;
     std::string getFieldOpts(const std::string& scope) const;
-    std::string getMembersDef(const std::string& scope) const;
+    common::Fragment getMembersDef(const std::string& scope) const;
     std::string getAccess() const;
     std::string getExtraOptions(const std::string& scope, GetExtraOptionsFunc func, const std::string& base) const;
 
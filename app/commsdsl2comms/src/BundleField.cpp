@@ -32,7 +32,7 @@ namespace commsdsl2comms
 namespace
 {
 
-const std::string MembersDefTemplate =
+const common::CompiledTemplate MembersDefTemplate(
     "/// @brief Scope for all the member fields of\n"
     "///     @ref #^#CLASS_NAME#$# bundle.\n"
     "#^#EXTRA_PREFIX#$#\n"
@@ -44,7 +44,7 @@ const std::string MembersDefTemplate =
     "        std::tuple<\n"
     "           #^#MEMBERS#$#\n"
     "        >;\n"
-    "};\n";
+    "};\n");
 
 const std::string MembersOptionsTemplate =
     "/// @brief Extra options for all the member fields of\n"
@@ -54,7 +54,7 @@ const std::string MembersOptionsTemplate =
     "    #^#OPTIONS#$#\n"
     "};\n";
 
-const std::string ClassTemplate(
+const common::CompiledTemplate ClassTemplate(
     "#^#MEMBERS_STRUCT_DEF#$#\n"
     "#^#PREFIX#$#"
     "class #^#CLASS_NAME#$# : public\n"
@@ -220,11 +220,11 @@ std::size_t BundleField::maxLengthImpl() const
             });
 }
 
-std::string BundleField::getClassDefinitionImpl(
+common::Fragment BundleField::getClassDefinitionImpl(
     const std::string& scope,
     const std::string& className) const
 {
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("PREFIX", getClassPrefix(className)));
     replacements.insert(std::make_pair("CLASS_NAME", className));
     replacements.insert(std::make_pair("ORIG_CLASS_NAME", common::nameToClassCopy(name())));
@@ -243,14 +243,14 @@ std::string BundleField::getClassDefinitionImpl(
     replacements.insert(std::make_pair("PUBLIC", getExtraPublic()));
     replacements.insert(std::make_pair("PROTECTED", getFullProtected()));
     if (!replacements["FIELD_OPTS"].empty()) {
-        replacements["COMMA"] = ',';
+        replacements["COMMA"] = ",";
     }
 
     if (!externalRef().empty()) {
         replacements.insert(std::make_pair("MEMBERS_OPT", "<TOpt>"));
     }
 
-    return common::processTemplate(ClassTemplate, replacements);
+    return ClassTemplate.render(replacements);
 }
 
 std::string BundleField::getExtraDefaultOptionsImpl(const std::string& scope) const
@@ -268,7 +268,7 @@ std::string BundleField::getExtraDataViewDefaultOptionsImpl(const std::string& b
     return getExtraOptions(scope, &Field::getDataViewDefaultOptions, base);
 }
 
-std::string BundleField::getPluginAnonNamespaceImpl(
+common::Fragment BundleField::getPluginAnonNamespaceImpl(
     const std::string& scope,
     bool forcedSerialisedHidden,
     bool serHiddenParam) const
@@ -279,21 +279,21 @@ std::string BundleField::getPluginAnonNamespaceImpl(
     }
     fullScope += "::";
 
-    common::StringsList props;
+    common::FragmentsList props;
     for (auto& f : m_members) {
         props.push_back(f->getPluginCreatePropsFunc(fullScope, forcedSerialisedHidden, serHiddenParam));
     }
 
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "struct #^#CLASS_NAME#$#Members\n"
         "{\n"
         "    #^#PROPS#$#\n"
-        "};\n";
+        "};\n");
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("CLASS_NAME", common::nameToClassCopy(name())));
-    replacements.insert(std::make_pair("PROPS", common::listToString(props, "\n", common::emptyString())));
-    return common::processTemplate(Templ, replacements);
+    replacements.insert(std::make_pair("PROPS", common::Fragment::join(props, "\n")));
+    return Templ.render(replacements);
 }
 
 std::string BundleField::getPluginPropertiesImpl(bool serHiddenParam) const
@@ -465,14 +465,14 @@ std::string BundleField::getFieldOpts(const std::string& scope) const
     return common::listToString(options, ",\n", common::emptyString());
 }
 
-std::string BundleField::getMembersDef(const std::string& scope) const
+common::Fragment BundleField::getMembersDef(const std::string& scope) const
 {
     auto className = common::nameToClassCopy(name());
     std::string memberScope;
     if (!scope.empty()) {
         memberScope = scope + className + common::membersSuffixStr() + "::";
     }
-    StringsList membersDefs;
+    common::FragmentsList membersDefs;
     StringsList membersNames;
 
     membersDefs.reserve(m_members.size());
@@ -488,12 +488,12 @@ std::string BundleField::getMembersDef(const std::string& scope) const
         prefix += "template <typename TOpt = " + generator().scopeForOptions(common::defaultOptionsStr(), true, true) + ">";
     }
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("CLASS_NAME", className));
     replacements.insert(std::make_pair("EXTRA_PREFIX", std::move(prefix)));
-    replacements.insert(std::make_pair("MEMBERS_DEFS", common::listToString(membersDefs, "\n", common::emptyString())));
+    replacements.insert(std::make_pair("MEMBERS_DEFS", common::Fragment::join(membersDefs, "\n")));
     replacements.insert(std::make_pair("MEMBERS", common::listToString(membersNames, ",\n", common::emptyString())));
-    return common::processTemplate(MembersDefTemplate, replacements);
+    return MembersDefTemplate.render(replacements);
 
 }
 
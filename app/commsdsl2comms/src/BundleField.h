@@ -41,13 +41,13 @@ protected:
     virtual void updatePluginIncludesImpl(IncludesList& includes) const override;
     virtual std::size_t minLengthImpl() const override;
     virtual std::size_t maxLengthImpl() const override;
-    virtual std::string getClassDefinitionImpl(
+    virtual common::Fragment getClassDefinitionImpl(
         const std::string& scope,
         const std::string& className) const override;
     virtual std::string getExtraDefaultOptionsImpl(const std::string& scope) const override;
     virtual std::string getExtraBareMetalDefaultOptionsImpl(const std::string& base, const std::string& scope) const override;
     virtual std::string getExtraDataViewDefaultOptionsImpl(const std::string& base, const std::string& scope) const override;
-    virtual std::string getPluginAnonNamespaceImpl(
+    virtual common::Fragment getPluginAnonNamespaceImpl(
         const std::string& scope,
         bool forcedSerialisedHidden,
         bool serHiddenParam) const override;
@@ -64,7 +64,7 @@ private:
     using GetExtraOptionsFunc = std::string (Field::*)(const std::string& base, const std::string& scope) const;
 
     std::string getFieldOpts(const std::string& scope) const;
-    std::string getMembersDef(const std::string& scope) const;
+    common::Fragment getMembersDef(const std::string& scope) const;
     std::string getAccess() const;
     std::string getAliases() const;
     std::string getRead() const;
@@ -69,12 +69,12 @@ void ChecksumLayer::updateIncludesImpl(Layer::IncludesList& includes) const
     common::mergeInclude(generator().headerfileForCustomChecksum(obj.customAlgName(), false), includes);
 }
 
-std::string ChecksumLayer::getClassDefinitionImpl(
+common::Fragment ChecksumLayer::getClassDefinitionImpl(
     const std::string& scope,
     std::string& prevLayer,
     bool& hasInputMessages) const
 {
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "#^#FIELD_DEF#$#\n"
         "#^#PREFIX#$#\n"
         "#^#TEMPL_PARAM#$#\n"
@@ -84,10 +84,10 @@ std::string ChecksumLayer::getClassDefinitionImpl(
         "        #^#ALG#$#,\n"
         "        #^#PREV_LAYER#$##^#COMMA#$#\n"
         "        #^#EXTRA_OPT#$#\n"
-        "    >;\n";
+        "    >;\n");
     
     auto obj = checksumLayerDslObj();
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("FIELD_DEF", getFieldDefinition(scope)));
     replacements.insert(std::make_pair("PREFIX", getPrefix()));
     replacements.insert(std::make_pair("FIELD_TYPE", getFieldType()));
@@ -103,7 +103,7 @@ std::string ChecksumLayer::getClassDefinitionImpl(
         static const std::string TemplParam =
             "template <typename TMessage, typename TAllMessages>";
         replacements.insert(std::make_pair("TEMPL_PARAM", TemplParam));
-        replacements["PREV_LAYER"] += "<TMessage, TAllMessages>";
+        replacements["PREV_LAYER"] = prevLayer + "<TMessage, TAllMessages>";
     }
 
     if (obj.verifyBeforeRead()) {
@@ -112,7 +112,7 @@ std::string ChecksumLayer::getClassDefinitionImpl(
     }
 
     prevLayer = common::nameToClassCopy(name());
-    return common::processTemplate(Templ, replacements);
+    return Templ.render(replacements);
 }
 
 bool ChecksumLayer::rearangeImpl(Layer::LayersList& layers, bool& success)
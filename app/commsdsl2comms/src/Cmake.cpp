@@ -15,7 +15,6 @@
 
 #include "Cmake.h"
 
-#include <fstream>
 
 #include <boost/filesystem.hpp>
 
@@ -55,12 +54,6 @@ bool Cmake::writeMain() const
     std::string filePathStr(filePath.string());
 
     m_generator.logger().info("Generating " + filePathStr);
-    std::ofstream stream(filePathStr);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePathStr + "\" for writing.");
-        return false;
-    }
-
     auto allInterfaces = m_generator.getAllInterfaces();
     assert(!allInterfaces.empty());
     auto* firstInterface = allInterfaces.front();
@@ -278,14 +271,7 @@ bool Cmake::writeMain() const
         "#^#APPEND#$#\n";
 
     auto str = common::processTemplate(Template, replacements);
-    stream << str;
-
-    stream.flush();
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePathStr + "\".");
-        return false;
-    }
-    return true;
+    return m_generator.writeOutputFile(filePathStr, str);
 }
 
 bool Cmake::writePlugin() const
@@ -301,12 +287,6 @@ bool Cmake::writePlugin() const
     std::string filePathStr(filePath.string());
 
     m_generator.logger().info("Generating " + filePathStr);
-    std::ofstream stream(filePathStr);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePathStr + "\" for writing.");
-        return false;
-    }
-
     common::StringsList calls;
     auto plugins = m_generator.getPlugins();
     for (auto* p : plugins) {
@@ -434,13 +414,7 @@ bool Cmake::writePlugin() const
         "#^#APPEND#$#\n";
 
     auto str = common::processTemplate(Template, replacements);
-    stream << str;
-    stream.flush();
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePathStr + "\".");
-        return false;
-    }
-    return true;
+    return m_generator.writeOutputFile(filePathStr, str);
 }
 
 bool Cmake::writeTest() const
@@ -456,12 +430,6 @@ bool Cmake::writeTest() const
     std::string filePathStr(filePath.string());
 
     m_generator.logger().info("Generating " + filePathStr);
-    std::ofstream stream(filePathStr);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePathStr + "\" for writing.");
-        return false;
-    }
-
     auto allInterfaces = m_generator.getAllInterfaces();
     assert(!allInterfaces.empty());
     auto* firstInterface = allInterfaces.front();
@@ -554,13 +522,7 @@ bool Cmake::writeTest() const
         "#^#APPEND#$#\n";
 
     auto str = common::processTemplate(Template, replacements);
-    stream << str;
-    stream.flush();
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePathStr + "\".");
-        return false;
-    }
-    return true;
+    return m_generator.writeOutputFile(filePathStr, str);
 }
 
 bool Cmake::writePrefetch() const
@@ -576,12 +538,6 @@ bool Cmake::writePrefetch() const
     std::string filePathStr(filePath.string());
 
     m_generator.logger().info("Generating " + filePathStr);
-    std::ofstream stream(filePathStr);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePathStr + "\" for writing.");
-        return false;
-    }
-
     static const std::string Contents = 
         "set (CC_FETCH_DEFAULT_REPO \"https://github.com/commschamp/comms_champion.git\")\n"
         "set (CC_FETCH_DEFAULT_TAG \"master\")\n\n"
@@ -622,10 +578,7 @@ bool Cmake::writePrefetch() const
         "    endif ()\n\n"
         "endfunction()\n";
 
-    stream << Contents;
-    stream.flush();
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePathStr + "\".");
+    if (!m_generator.writeOutputFile(filePathStr, Contents)) {
         return false;
     }
     return true;        
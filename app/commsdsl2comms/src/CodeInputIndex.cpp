@@ -0,0 +1,234 @@
+//
+// Copyright 2019 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CodeInputIndex.h"
+
+#include <fstream>
+#include <iterator>
+#include <cassert>
+#include <cctype>
+
+namespace bf = boost::filesystem;
+
+namespace commsdsl2comms
+{
+
+namespace
+{
+
+std::string swapCase(const std::string& str)
+{
+    auto result = str;
+    for (auto& ch : result) {
+        auto lower = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+        if (ch != lower) {
+            ch = lower;
+            continue;
+        }
+
+        ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+    }
+    return result;
+}
+
+std::string foldCase(const std::string& str)
+{
+    auto result = str;
+    for (auto& ch : result) {
+        ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    }
+    return result;
+}
+
+} // namespace
+
+bool CodeInputIndex::scan(const DirsList& dirs)
+{
+    m_dirs.clear();
+    for (auto& d : dirs) {
+        auto& info = m_dirs[d.string()];
+        if (!scanDir(d, info)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CodeInputIndex::exists(const boost::filesystem::path& dir, const boost::filesystem::path& relPath) const
+{
+    return findFile(dir, relPath) != nullptr;
+}
+
+bool CodeInputIndex::read(
+    const boost::filesystem::path& dir,
+    const boost::filesystem::path& relPath,
+    std::string& content) const
+{
+    auto* info = findFile(dir, relPath);
+    if (info == nullptr) {
+        return false;
+    }
+
+    // Contents are loaded on first request only, possibly from several
+    // generation jobs in parallel.
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto& infoRef = *info;
+    if (!infoRef.m_loaded) {
+        infoRef.m_loaded = true;
+        std::ifstream stream(infoRef.m_path.string());
+        infoRef.m_valid = static_cast<bool>(stream);
+        if (infoRef.m_valid) {
+            infoRef.m_content.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        }
+    }
+
+    if (!infoRef.m_valid) {
+        return false;
+    }
+
+    content = infoRef.m_content;
+    return true;
+}
+
+CodeInputIndex::FilesList CodeInputIndex::files(const boost::filesystem::path& dir) const
+{
+    FilesList result;
+    auto dirIter = m_dirs.find(dir.string());
+    if (dirIter == m_dirs.end()) {
+        return result;
+    }
+
+    auto& filesMap = dirIter->second.m_files;
+    result.reserve(filesMap.size());
+    for (auto& f : filesMap) {
+        result.push_back(f.second.m_relPath);
+    }
+    return result;
+}
+
+std::string CodeInputIndex::fileKey(const DirInfo& info, const std::string& relPathStr)
+{
+    if (!info.m_ignoreCase) {
+        return relPathStr;
+    }
+
+    return foldCase(relPathStr);
+}
+
+bool CodeInputIndex::scanDir(const boost::filesystem::path& dir, DirInfo& info)
+{
+    bf::path root = dir;
+    if (root.empty()) {
+        root = ".";
+    }
+
+    boost::system::error_code ec;
+    if (!bf::is_directory(root, ec)) {
+        return true;
+    }
+
+    // The symbolic links to directories are not followed to avoid looping on
+    // cycles, the files behind them are found by probing on a miss.
+    auto rootStr = root.string();
+    bool caseChecked = false;
+    auto endIter = bf::recursive_directory_iterator();
+    auto iter = bf::recursive_directory_iterator(root, ec);
+    for (; (!ec) && (iter != endIter); iter.increment(ec)) {
+        if (bf::is_directory(iter->status())) {
+            if (bf::is_symlink(iter->symlink_status())) {
+                info.m_probeOnMiss = true;
+            }
+            continue;
+        }
+
+        if (!bf::is_regular_file(iter->status())) {
+            continue;
+        }
+
+        auto pathStr = iter->path().string();
+        assert(rootStr.size() <= pathStr.size());
+        auto pos = rootStr.size();
+        while ((pos < pathStr.size()) && (pathStr[pos] == bf::path::preferred_separator)) {
+            ++pos;
+        }
+
+        if (pathStr.size() <= pos) {
+            continue;
+        }
+
+        auto relPathStr = bf::path(std::string(pathStr, pos)).generic_string();
+        if (!caseChecked) {
+            auto swappedStr = swapCase(relPathStr);
+            if (swappedStr != relPathStr) {
+                // Detect file system ignoring the case, all the files
+                // recorded so far have no letters and don't need folding.
+                caseChecked = true;
+                boost::system::error_code eqEc;
+                if (bf::equivalent(iter->path(), root / swappedStr, eqEc)) {
+                    info.m_ignoreCase = true;
+                }
+            }
+        }
+
+        auto& fileInfo = info.m_files[fileKey(info, relPathStr)];
+        fileInfo.m_path = iter->path();
+        fileInfo.m_relPath = std::move(relPathStr);
+    }
+
+    if (ec) {
+        m_logger.error("Failed to scan \"" + rootStr + "\" with reason: " + ec.message());
+        return false;
+    }
+
+    return true;
+}
+
+const CodeInputIndex::FileInfo* CodeInputIndex::findFile(
+    const boost::filesystem::path& dir,
+    const boost::filesystem::path& relPath) const
+{
+    auto dirIter = m_dirs.find(dir.string());
+    if (dirIter == m_dirs.end()) {
+        return nullptr;
+    }
+
+    auto& dirInfo = dirIter->second;
+    auto relPathStr = relPath.generic_string();
+    auto key = fileKey(dirInfo, relPathStr);
+    auto iter = dirInfo.m_files.find(key);
+    if (iter != dirInfo.m_files.end()) {
+        return &iter->second;
+    }
+
+    if (!dirInfo.m_probeOnMiss) {
+        return nullptr;
+    }
+
+    // The files behind the symbolic links to directories are not indexed,
+    // behave the same way as the direct access.
+    auto path = dir / relPath;
+    boost::system::error_code ec;
+    if (!bf::is_regular_file(path, ec)) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto& info = dirInfo.m_probedFiles[key];
+    info.m_path = path;
+    info.m_relPath = std::move(relPathStr);
+    return &info;
+}
+
+} // namespace commsdsl2comms
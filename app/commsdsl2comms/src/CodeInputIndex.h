@@ -0,0 +1,74 @@
+//
+// Copyright 2019 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "Logger.h"
+
+namespace commsdsl2comms
+{
+
+class CodeInputIndex
+{
+public:
+    using DirsList = std::vector<boost::filesystem::path>;
+    using FilesList = std::vector<std::string>;
+
+    explicit CodeInputIndex(Logger& logger) : m_logger(logger) {}
+
+    bool scan(const DirsList& dirs);
+    bool exists(const boost::filesystem::path& dir, const boost::filesystem::path& relPath) const;
+    bool read(const boost::filesystem::path& dir, const boost::filesystem::path& relPath, std::string& content) const;
+    FilesList files(const boost::filesystem::path& dir) const;
+
+private:
+    struct FileInfo
+    {
+        boost::filesystem::path m_path;
+        std::string m_relPath;
+        mutable std::string m_content;
+        mutable bool m_loaded = false;
+        mutable bool m_valid = false;
+    };
+
+    using FilesMap = std::map<std::string, FileInfo>;
+
+    struct DirInfo
+    {
+        FilesMap m_files;
+        mutable FilesMap m_probedFiles;
+        bool m_ignoreCase = false;
+        bool m_probeOnMiss = false;
+    };
+
+    using DirsMap = std::map<std::string, DirInfo>;
+
+    static std::string fileKey(const DirInfo& info, const std::string& relPathStr);
+    bool scanDir(const boost::filesystem::path& dir, DirInfo& info);
+    const FileInfo* findFile(const boost::filesystem::path& dir, const boost::filesystem::path& relPath) const;
+
+    Logger& m_logger;
+    DirsMap m_dirs;
+    mutable std::mutex m_mutex;
+};
+
+} // namespace commsdsl2comms
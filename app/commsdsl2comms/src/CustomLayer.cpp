@@ -28,12 +28,12 @@ void CustomLayer::updateIncludesImpl(Layer::IncludesList& includes) const
     common::mergeInclude(generator().headerfileForCustomLayer(name(), false), includes);
 }
 
-std::string CustomLayer::getClassDefinitionImpl(
+common::Fragment CustomLayer::getClassDefinitionImpl(
     const std::string& scope,
     std::string& prevLayer,
     bool& hasInputMessages) const
 {
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "#^#FIELD_DEF#$#\n"
         "#^#PREFIX#$#\n"
         "#^#TEMPL_PARAM#$#\n"
@@ -43,9 +43,9 @@ std::string CustomLayer::getClassDefinitionImpl(
         "        #^#ID_TEMPLATE_PARAMS#$#\n"
         "        #^#PREV_LAYER#$#,\n"
         "        #^#EXTRA_OPT#$#\n"
-        "    >;\n";
+        "    >;\n");
     
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("FIELD_DEF", getFieldDefinition(scope)));
     replacements.insert(std::make_pair("PREFIX", getPrefix()));
     replacements.insert(std::make_pair("FIELD_TYPE", getFieldType()));
@@ -66,11 +66,11 @@ std::string CustomLayer::getClassDefinitionImpl(
     }
     else if (hasInputMessages) {
         replacements.insert(std::make_pair("TEMPL_PARAM", TemplParam));
-        replacements["PREV_LAYER"] += "<TMessage, TAllMessages>";
+        replacements["PREV_LAYER"] = prevLayer + "<TMessage, TAllMessages>";
     }
 
     prevLayer = common::nameToClassCopy(name());
-    return common::processTemplate(Templ, replacements);
+    return Templ.render(replacements);
 }
 
 bool CustomLayer::isCustomizableImpl() const
@@ -32,7 +32,7 @@ namespace commsdsl2comms
 namespace
 {
 
-const std::string ClassTemplate(
+const common::CompiledTemplate ClassTemplate(
     "#^#PREFIX_FIELD#$#\n"
     "#^#PREFIX#$#"
     "class #^#CLASS_NAME#$# : public\n"
@@ -62,7 +62,7 @@ const std::string ClassTemplate(
     "};\n"
 );
 
-const std::string StructTemplate(
+const common::CompiledTemplate StructTemplate(
     "#^#PREFIX_FIELD#$#\n"
     "#^#PREFIX#$#"
     "struct #^#CLASS_NAME#$# : public\n"
@@ -76,7 +76,7 @@ const std::string StructTemplate(
     "};\n"
 );
 
-bool shouldUseStruct(const common::ReplacementMap& replacements)
+bool shouldUseStruct(const common::FragmentsMap& replacements)
 {
     auto hasNoValue =
         [&replacements](const std::string& val)
@@ -166,11 +166,11 @@ std::size_t DataField::maxLengthImpl() const
     return common::maxPossibleLength();
 }
 
-std::string DataField::getClassDefinitionImpl(
+common::Fragment DataField::getClassDefinitionImpl(
     const std::string& scope,
     const std::string& className) const
 {
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("PREFIX", getClassPrefix(className)));
     replacements.insert(std::make_pair("CLASS_NAME", className));
     replacements.insert(std::make_pair("PROT_NAMESPACE", generator().mainNamespace()));
@@ -190,11 +190,11 @@ std::string DataField::getClassDefinitionImpl(
         replacements.insert(std::make_pair("COMMA", ","));
     }
 
-    const std::string* templPtr = &ClassTemplate;
+    const common::CompiledTemplate* templPtr = &ClassTemplate;
     if (shouldUseStruct(replacements)) {
         templPtr = &StructTemplate;
     }
-    return common::processTemplate(*templPtr, replacements);
+    return templPtr->render(replacements);
 }
 
 std::string DataField::getExtraDefaultOptionsImpl(const std::string& scope) const
@@ -485,7 +485,7 @@ std::string DataField::getConstructor(const std::string& className) const
     return common::processTemplate(Templ, replacements);
 }
 
-std::string DataField::getPrefixField(const std::string& scope) const
+common::Fragment DataField::getPrefixField(const std::string& scope) const
 {
     if (!m_prefix) {
         return common::emptyString();
@@ -502,20 +502,20 @@ std::string DataField::getPrefixField(const std::string& scope) const
         prefix += "template <typename TOpt = " + generator().scopeForOptions(common::defaultOptionsStr(), true, true) + ">";
     }
 
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "/// @brief Scope for all the member fields of\n"
         "///     @ref #^#CLASS_NAME#$# list.\n"
         "#^#EXTRA_PREFIX#$#\n"
         "struct #^#CLASS_NAME#$#Members\n"
         "{\n"
         "    #^#FIELD_DEF#$#\n"
-        "};\n";
+        "};\n");
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("CLASS_NAME", common::nameToClassCopy(name())));
     replacements.insert(std::make_pair("EXTRA_PREFIX", std::move(prefix)));
     replacements.insert(std::make_pair("FIELD_DEF", std::move(fieldDef)));
-    return common::processTemplate(Templ, replacements);
+    return Templ.render(replacements);
 }
 
 void DataField::checkFixedLengthOpt(DataField::StringsList& list) const
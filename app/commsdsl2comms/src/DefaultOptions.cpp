@@ -15,7 +15,6 @@
 
 #include "DefaultOptions.h"
 
-#include <fstream>
 
 #include <boost/filesystem.hpp>
 
@@ -64,12 +63,6 @@ bool DefaultOptions::writeDefinition() const
     replacements.insert(std::make_pair("CLASS_NAME", std::move(className)));
     replacements.insert(std::make_pair("BODY", m_generator.getDefaultOptionsBody()));
 
-    std::ofstream stream(fileName);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + fileName + "\" for writing.");
-        return false;
-    }
-
     static const std::string Template(
         "#^#GEN_COMMENT#$#\n"
         "/// @file\n"
@@ -86,15 +79,7 @@ bool DefaultOptions::writeDefinition() const
     );
 
     auto str = common::processTemplate(Template, replacements);
-    stream << str;
-
-    stream.flush();
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + fileName + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(fileName, str);
 }
 
 bool DefaultOptions::writeClientServer(bool client) const
@@ -134,12 +119,6 @@ bool DefaultOptions::writeClientServer(bool client) const
     replacements.insert(std::make_pair("DEFAULT_OPT", m_generator.scopeForOptions(common::defaultOptionsStr(), true, true)));
     replacements.insert(std::make_pair("BASE", BaseTemplateParam));
 
-    std::ofstream stream(fileName);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + fileName + "\" for writing.");
-        return false;
-    }
-
     static const std::string Template(
         "#^#GEN_COMMENT#$#\n"
         "/// @file\n"
@@ -160,15 +139,7 @@ bool DefaultOptions::writeClientServer(bool client) const
     );
 
     auto str = common::processTemplate(Template, replacements);
-    stream << str;
-
-    stream.flush();
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + fileName + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(fileName, str);
 }
 
 bool DefaultOptions::writeBareMetal() const
@@ -200,12 +171,6 @@ bool DefaultOptions::writeBareMetal() const
     replacements.insert(std::make_pair("BASE", BaseTemplateParam));
 
 
-    std::ofstream stream(fileName);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + fileName + "\" for writing.");
-        return false;
-    }
-
     static const std::string Template(
         "#^#GEN_COMMENT#$#\n"
         "/// @file\n"
@@ -233,15 +198,7 @@ bool DefaultOptions::writeBareMetal() const
     );
 
     auto str = common::processTemplate(Template, replacements);
-    stream << str;
-
-    stream.flush();
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + fileName + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(fileName, str);
 }
 
 bool DefaultOptions::writeDataView() const
@@ -272,12 +229,6 @@ bool DefaultOptions::writeDataView() const
     replacements.insert(std::make_pair("BASE", BaseTemplateParam));
 
 
-    std::ofstream stream(fileName);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + fileName + "\" for writing.");
-        return false;
-    }
-
     static const std::string Template(
         "#^#GEN_COMMENT#$#\n"
         "/// @file\n"
@@ -300,15 +251,7 @@ bool DefaultOptions::writeDataView() const
     );
 
     auto str = common::processTemplate(Template, replacements);
-    stream << str;
-
-    stream.flush();
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + fileName + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(fileName, str);
 }
 
 
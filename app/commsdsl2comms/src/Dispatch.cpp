@@ -15,7 +15,6 @@
 
 #include "Dispatch.h"
 
-#include <fstream>
 
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string.hpp>
@@ -68,7 +67,7 @@ bool Dispatch::writeProtocolDefinition() const
         elem.m_realPlatform = false;
     }
 
-    auto allMessages = m_generator.getAllDslMessages();
+    auto& allMessages = m_generator.getAllDslMessages();
 
     for (auto& p : platformsMap) {
         auto updateFunc =
@@ -180,12 +179,6 @@ bool Dispatch::writeProtocolDefinition() const
                 return true;
             }
 
-            std::ofstream stream(filePath);
-            if (!stream) {
-                m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-                return false;
-            }
-
             auto func =
                 getDispatchFunc(
                     common::nameToAccessCopy(fileName),
@@ -221,14 +214,7 @@ bool Dispatch::writeProtocolDefinition() const
                 "#^#END_NAMESPACE#$#\n";
 
             auto str = common::processTemplate(Templ, replacements);
-            stream << str;
-
-            stream.flush();
-            if (!stream.good()) {
-                m_generator.logger().error("Failed to write \"" + filePath + "\".");
-                return false;
-            }
-            return true;
+            return m_generator.writeOutputFile(filePath, str);
         };
 
     for (auto& p : platformsMap) {
@@ -275,50 +261,58 @@ std::string Dispatch::getDispatchFunc(
                 return 1U < elem.second.size();
             });
 
+    static const common::CompiledTemplate MsgCaseTempl(
+        "case #^#MSG_ID#$#:\n"
+        "{\n"
+        "    using MsgType = #^#MSG_TYPE#$#<InterfaceType, TProtOptions>;\n"
+        "    return handler.handle(static_cast<MsgType&>(msg));\n"
+        "}");
+
+    static const common::CompiledTemplate IdxCasesTempl(
+        "case #^#MSG_ID#$#:\n"
+        "{\n"
+        "    switch (idx) {\n"
+        "    #^#IDX_CASES#$#\n"
+        "    default:\n"
+        "        return handler.handle(msg);\n"
+        "    };\n"
+        "    break;\n"
+        "}");
+
+    static const auto MsgCaseIdSlot = MsgCaseTempl.slotIdx("MSG_ID");
+    static const auto MsgCaseTypeSlot = MsgCaseTempl.slotIdx("MSG_TYPE");
+    static const auto IdxCasesIdSlot = IdxCasesTempl.slotIdx("MSG_ID");
+    static const auto IdxCasesCasesSlot = IdxCasesTempl.slotIdx("IDX_CASES");
+
+    common::CompiledTemplate::Values msgCaseValues(MsgCaseTempl.slotsCount());
+    common::CompiledTemplate::Values idxCasesValues(IdxCasesTempl.slotsCount());
+    std::string caseStr;
     common::StringsList cases;
     for (auto& elem : msgMap) {
         auto& msgList = elem.second;
         assert(!msgList.empty());
         auto idStr = getIdString(elem.first);
 
-        static const std::string MsgCaseTempl =
-            "case #^#MSG_ID#$#:\n"
-            "{\n"
-            "    using MsgType = #^#MSG_TYPE#$#<InterfaceType, TProtOptions>;\n"
-            "    return handler.handle(static_cast<MsgType&>(msg));\n"
-            "}";
-
         if (msgList.size() == 1) {
-            common::ReplacementMap repl;
-            repl.insert(std::make_pair("MSG_ID", idStr));
-            repl.insert(std::make_pair("MSG_TYPE", m_generator.scopeForMessage(msgList.front().externalRef(), true, true)));
-            cases.push_back(common::processTemplate(MsgCaseTempl, repl));
+            msgCaseValues[MsgCaseIdSlot] = idStr;
+            msgCaseValues[MsgCaseTypeSlot] = m_generator.scopeForMessage(msgList.front().externalRef(), true, true);
+            MsgCaseTempl.render(msgCaseValues, caseStr);
+            cases.push_back(caseStr);
             continue;
         }
 
         common::StringsList offsetCases;
         for (auto idx=0U; idx < msgList.size(); ++idx) {
-            common::ReplacementMap repl;
-            repl.insert(std::make_pair("MSG_ID", common::numToString(idx)));
-            repl.insert(std::make_pair("MSG_TYPE", m_generator.scopeForMessage(msgList[idx].externalRef(), true, true)));
-            offsetCases.push_back(common::processTemplate(MsgCaseTempl, repl));
+            msgCaseValues[MsgCaseIdSlot] = common::numToString(idx);
+            msgCaseValues[MsgCaseTypeSlot] = m_generator.scopeForMessage(msgList[idx].externalRef(), true, true);
+            MsgCaseTempl.render(msgCaseValues, caseStr);
+            offsetCases.push_back(caseStr);
         }
 
-        common::ReplacementMap repl;
-        repl.insert(std::make_pair("MSG_ID", idStr));
-        repl.insert(std::make_pair("IDX_CASES", common::listToString(offsetCases, "\n", common::emptyString())));
-
-        static const std::string Templ =
-            "case #^#MSG_ID#$#:\n"
-            "{\n"
-            "    switch (idx) {\n"
-            "    #^#IDX_CASES#$#\n"
-            "    default:\n"
-            "        return handler.handle(msg);\n"
-            "    };\n"
-            "    break;\n"
-            "}";
-        cases.push_back(common::processTemplate(Templ, repl));
+        idxCasesValues[IdxCasesIdSlot] = idStr;
+        idxCasesValues[IdxCasesCasesSlot] = common::listToString(offsetCases, "\n", common::emptyString());
+        IdxCasesTempl.render(idxCasesValues, caseStr);
+        cases.push_back(caseStr);
     }
 
     auto allInterfaces = m_generator.getAllInterfaces();
@@ -15,7 +15,6 @@
 
 #include "Doxygen.h"
 
-#include <fstream>
 #include <vector>
 #include <string>
 
@@ -63,12 +62,6 @@ bool Doxygen::writeConf() const
         return true;
     }
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-
     static const std::string Template = 
         "DOXYFILE_ENCODING      = UTF-8\n"
         "PROJECT_NAME           = \"#^#PROJ_NAME#$#\"\n"
@@ -213,14 +206,7 @@ bool Doxygen::writeConf() const
     replacements.insert(std::make_pair("PROJ_NAME", m_generator.schemaName()));
     replacements.insert(std::make_pair("APPEND", m_generator.getExtraAppendForFile(getAppendReq(DocFile))));
 
-    stream << common::processTemplate(Template, replacements);
-
-    stream.flush();
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-    return true;
+    return m_generator.writeOutputFile(filePath, common::processTemplate(Template, replacements));
 }
 
 bool Doxygen::writeLayout() const
@@ -231,12 +217,6 @@ bool Doxygen::writeLayout() const
         return true;
     }
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-
     static const std::string Str =
         "<doxygenlayout version=\"1.0\">\n"
         "<navindex>\n"
@@ -422,14 +402,7 @@ bool Doxygen::writeLayout() const
         "</directory>\n"
         "</doxygenlayout>\n";
 
-    stream << Str;
-
-    stream.flush();
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-    return true;
+    return m_generator.writeOutputFile(filePath, Str);
 }
 
 bool Doxygen::writeNamespaces() const
@@ -441,12 +414,6 @@ bool Doxygen::writeNamespaces() const
         return true;
     }
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-
     static const std::string Template =
         "/// @namespace #^#NS#$#\n"
         "/// @brief Main namespace for all classes / functions of this protocol library.\n\n"
@@ -504,14 +471,7 @@ bool Doxygen::writeNamespaces() const
     replacements.insert(std::make_pair("OTHER_NS", common::listToString(otherNs, "\n", common::emptyString())));
     replacements.insert(std::make_pair("APPEND", m_generator.getExtraAppendForFile(getAppendReq(DocFile))));
 
-    stream << common::processTemplate(Template, replacements);
-
-    stream.flush();
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-    return true;
+    return m_generator.writeOutputFile(filePath, common::processTemplate(Template, replacements));
 }
 
 bool Doxygen::writeMainpage() const
@@ -523,12 +483,6 @@ bool Doxygen::writeMainpage() const
         return true;
     }
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-
     static const std::string Template =
         "/// @mainpage \"#^#PROJ_NAME#$#\" Binary Protocol Library\n"
         "/// @tableofcontents\n"
@@ -566,14 +520,7 @@ bool Doxygen::writeMainpage() const
     replacements.insert(std::make_pair("CUSTOMIZE_DOC", getCustomizeDoc()));
     replacements.insert(std::make_pair("VERSION_DOC", getVersionDoc()));
 
-    stream << common::processTemplate(Template, replacements);
-
-    stream.flush();
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-    return true;
+    return m_generator.writeOutputFile(filePath, common::processTemplate(Template, replacements));
 }
 
 std::string Doxygen::getMessagesDoc() const
@@ -327,7 +327,7 @@ void EnumField::updateIncludesCommonImpl(IncludesList& includes) const
     updateIncludesForCommonInternal(includes);
 }
 
-std::string EnumField::getClassDefinitionImpl(
+common::Fragment EnumField::getClassDefinitionImpl(
     const std::string& scope,
     const std::string& className) const
 {
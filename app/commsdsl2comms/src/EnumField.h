@@ -41,7 +41,7 @@ public:
 protected:
     virtual void updateIncludesImpl(IncludesList& includes) const override;
     virtual void updateIncludesCommonImpl(IncludesList& includes) const override;
-    virtual std::string getClassDefinitionImpl(
+    virtual common::Fragment getClassDefinitionImpl(
         const std::string& scope,
         const std::string& className) const override;
     virtual std::string getCompareToValueImpl(
@@ -19,7 +19,6 @@
 #include <type_traits>
 #include <cassert>
 #include <algorithm>
-#include <fstream>
 
 #include <boost/algorithm/string.hpp>
 
@@ -118,11 +117,10 @@ bool Field::prepare(unsigned parentVersion)
     return prepareImpl();
 }
 
-std::string Field::getClassDefinition(
+common::Fragment Field::getClassDefinition(
     const std::string& scope,
     const std::string& className) const
 {
-    std::string str;
     bool optional = isVersionOptional();
 
     auto classNameCpy(className);
@@ -134,11 +132,11 @@ std::string Field::getClassDefinition(
          classNameCpy += common::optFieldSuffixStr();
     }
 
-    str += getClassDefinitionImpl(scope, classNameCpy);
+    auto result = getClassDefinitionImpl(scope, classNameCpy);
 
     if (optional) {
-        str += '\n';
-        str += getClassPrefix(classNameCpy, false);
+        result.append("\n");
+        result.append(getClassPrefix(classNameCpy, false));
 
         static const std::string Templ =
             "struct #^#CLASS_NAME#$# : public\n"
@@ -191,9 +189,9 @@ std::string Field::getClassDefinition(
         replacements.insert(std::make_pair("FIELD_PARAMS", std::move(fieldParams)));
         replacements.insert(std::make_pair("DEFAULT_MODE_OPT", std::move(defaultModeOpt)));
         replacements.insert(std::make_pair("VERSIONS_OPT", std::move(versionOpt)));
-        str += common::processTemplate(Templ, replacements);
+        result.append(common::processTemplate(Templ, replacements));
     }
-    return str;
+    return result;
 }
 
 std::string Field::getCommonDefinition(
@@ -835,20 +833,20 @@ std::string Field::getPrivateRefreshForFields(const Field::FieldsList& fields)
     return common::listToString(funcs, "\n", common::emptyString());
 }
 
-std::string Field::getPluginCreatePropsFunc(
+common::Fragment Field::getPluginCreatePropsFunc(
     const std::string& scope,
     bool forcedSerialisedHidden,
     bool serHiddenParam) const
 {
-    static const std::string Templ = 
+    static const common::CompiledTemplate Templ(
         "#^#ANON_NAMESPACE#$#\n"
         "static QVariantMap createProps_#^#NAME#$#(#^#SER_HIDDEN#$#)\n"
         "{\n"
         "    #^#SER_HIDDEN_CAST#$#\n"
         "    #^#BODY#$#\n"
-        "}\n";
+        "}\n");
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("NAME", common::nameToAccessCopy(name())));
     replacements.insert(std::make_pair("BODY", getPluginPropsDefFuncBodyImpl(scope, false, forcedSerialisedHidden, serHiddenParam)));
     replacements.insert(std::make_pair("ANON_NAMESPACE", getPluginAnonNamespace(scope, forcedSerialisedHidden, serHiddenParam)));
@@ -856,10 +854,10 @@ std::string Field::getPluginCreatePropsFunc(
         replacements.insert(std::make_pair("SER_HIDDEN", "bool serHidden"));
     }
 
-    return common::processTemplate(Templ, replacements);
+    return Templ.render(replacements);
 }
 
-std::string Field::getPluginAnonNamespace(
+common::Fragment Field::getPluginAnonNamespace(
     const std::string& scope,
     bool forcedSerialisedHidden,
     bool serHiddenParam) const
@@ -868,24 +866,24 @@ std::string Field::getPluginAnonNamespace(
     if (scopeCpy.empty()) {
         scopeCpy = m_generator.scopeForField(m_externalRef, true, false);
     }
-    auto str = getPluginAnonNamespaceImpl(scopeCpy, forcedSerialisedHidden, serHiddenParam);
-    if (str.empty()) {
-        return common::emptyString();
+    auto frag = getPluginAnonNamespaceImpl(scopeCpy, forcedSerialisedHidden, serHiddenParam);
+    if (frag.empty()) {
+        return common::Fragment();
     }
 
     if (!scope.empty()) {
-        return str;
+        return frag;
     }
 
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "namespace\n"
         "{\n\n"
         "#^#STR#$#\n"
-        "} // namespace\n\n";
+        "} // namespace\n\n");
 
-    common::ReplacementMap replacements;
-    replacements.insert(std::make_pair("STR", std::move(str)));
-    return common::processTemplate(Templ, replacements);
+    common::FragmentsMap replacements;
+    replacements.insert(std::make_pair("STR", std::move(frag)));
+    return Templ.render(replacements);
 }
 
 bool Field::verifyAlias(const std::string& fieldName) const
@@ -1118,7 +1116,7 @@ std::string Field::getPluginPropsDefFuncBodyImpl(
     return common::processTemplate(*templ, replacements);
 }
 
-std::string Field::getPluginAnonNamespaceImpl(
+common::Fragment Field::getPluginAnonNamespaceImpl(
     const std::string& scope,
     bool forcedSerialisedHidden,
     bool serHiddenParam) const
@@ -1126,7 +1124,7 @@ std::string Field::getPluginAnonNamespaceImpl(
     static_cast<void>(scope);
     static_cast<void>(forcedSerialisedHidden);
     static_cast<void>(serHiddenParam);
-    return common::emptyString();
+    return common::Fragment();
 }
 
 std::string Field::getPluginPropertiesImpl(bool serHiddenParam) const
@@ -1445,19 +1443,7 @@ bool Field::writeProtocolDefinitionCommonFile() const
 
     std::string str = common::processTemplate(FileTemplate, replacements);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Field::writeProtocolDefinitionFile() const
@@ -1481,7 +1467,7 @@ bool Field::writeProtocolDefinitionFile() const
     auto namespaces = m_generator.namespacesForField(m_externalRef);
 
     auto scope = "TOpt::" + m_generator.scopeForField(m_externalRef);
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("GEN_COMMENT", m_generator.fileGeneratedComment()));
     replacements.insert(std::make_pair("INCLUDES", std::move(incStr)));
     replacements.insert(std::make_pair("BEGIN_NAMESPACE", std::move(namespaces.first)));
@@ -1490,7 +1476,7 @@ bool Field::writeProtocolDefinitionFile() const
     replacements.insert(std::make_pair("FIELD_NAME", displayName()));
     replacements.insert(std::make_pair("APPEND", m_generator.getExtraAppendForField(m_externalRef)));
 
-    static const std::string FileTemplate(
+    static const common::CompiledTemplate FileTemplate(
         "#^#GEN_COMMENT#$#\n"
         "/// @file\n"
         "/// @brief Contains definition of <b>\"#^#FIELD_NAME#$#\"</b> field.\n"
@@ -1504,21 +1490,9 @@ bool Field::writeProtocolDefinitionFile() const
         "#^#APPEND#$#\n"
     );
 
-    std::string str = common::processTemplate(FileTemplate, replacements);
+    auto contents = FileTemplate.render(replacements);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, contents);
 }
 
 bool Field::writePluginHeaderFile() const
@@ -1554,19 +1528,7 @@ bool Field::writePluginHeaderFile() const
     replacements.insert(std::make_pair("NAME", common::nameToAccessCopy(className)));
     auto str = common::processTemplate(Templ, replacements);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Field::writePluginScrFile() const
@@ -1584,7 +1546,7 @@ bool Field::writePluginScrFile() const
         return true;
     }
 
-    static const std::string Templ(
+    static const common::CompiledTemplate Templ(
         "#^#GEN_COMMENT#$#\n"
         "#include \"#^#CLASS_NAME#$#.h\"\n"
         "\n"
@@ -1601,7 +1563,7 @@ bool Field::writePluginScrFile() const
 
     auto namespaces = m_generator.namespacesForFieldInPlugin(m_externalRef);
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("GEN_COMMENT", m_generator.fileGeneratedComment()));
     replacements.insert(std::make_pair("CLASS_NAME", className));
     replacements.insert(std::make_pair("BEGIN_NAMESPACE", std::move(namespaces.first)));
@@ -1611,21 +1573,9 @@ bool Field::writePluginScrFile() const
     replacements.insert(std::make_pair("INCLUDES", getPluginIncludes()));
     replacements.insert(std::make_pair("BODY", getPluginPropsDefFuncBodyImpl(common::emptyString(), true, false, true)));
 
-    auto str = common::processTemplate(Templ, replacements);
-
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
+    auto contents = Templ.render(replacements);
 
-    return true;
+    return m_generator.writeOutputFile(filePath, contents);
 }
 
 std::string Field::getPluginIncludes() const
@@ -18,6 +18,7 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <atomic>
 
 #include "commsdsl/Field.h"
 #include "commsdsl/Endian.h"
@@ -66,7 +67,7 @@ public:
 
     bool prepare(unsigned parentVersion);
 
-    std::string getClassDefinition(
+    common::Fragment getClassDefinition(
         const std::string& scope,
         const std::string& className = common::emptyString()) const;
 
@@ -180,12 +181,12 @@ public:
         return getReadPreparationImpl(fields);
     }
 
-    std::string getPluginCreatePropsFunc(
+    common::Fragment getPluginCreatePropsFunc(
         const std::string& scope,
         bool forcedSerialisedHidden,
         bool serHiddenParam = true) const;
 
-    std::string getPluginAnonNamespace(
+    common::Fragment getPluginAnonNamespace(
         const std::string& scope = common::emptyString(),
         bool forcedSerialisedHidden = false,
         bool serHiddenParam = true) const;
@@ -237,7 +238,7 @@ protected:
     virtual void updatePluginIncludesImpl(IncludesList& includes) const;
     virtual std::size_t minLengthImpl() const;
     virtual std::size_t maxLengthImpl() const;
-    virtual std::string getClassDefinitionImpl(
+    virtual common::Fragment getClassDefinitionImpl(
         const std::string& scope,
         const std::string& className) const = 0;
     virtual std::string getExtraDefaultOptionsImpl(const std::string& scope) const;
@@ -260,7 +261,7 @@ protected:
         bool externalName,
         bool forcedSerialisedHidden,
         bool serHiddenParam) const;
-    virtual std::string getPluginAnonNamespaceImpl(
+    virtual common::Fragment getPluginAnonNamespaceImpl(
         const std::string& scope,
         bool forcedSerialisedHidden,
         bool serHiddenParam) const;
@@ -322,7 +323,7 @@ private:
     bool m_forcedPseudo = false;
     bool m_forcedNoOptionsConfig = false;
     bool m_memberChild = false;
-    bool m_referenced = false;
+    std::atomic<bool> m_referenced{false};
 };
 
 using FieldPtr = Field::Ptr;
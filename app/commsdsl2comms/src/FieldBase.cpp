@@ -15,7 +15,6 @@
 
 #include "FieldBase.h"
 
-#include <fstream>
 
 #include <boost/filesystem.hpp>
 
@@ -68,12 +67,6 @@ bool FieldBase::writeDefinition() const
         return true;
     }
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-
     common::StringsList options;
     options.push_back(common::dslEndianToOpt(m_generator.schemaEndian()));
     // TODO: version type
@@ -89,14 +82,7 @@ bool FieldBase::writeDefinition() const
     replacements.insert(std::make_pair("PROT_NAMESPACE", m_generator.mainNamespace()));
 
     auto str = common::processTemplate(Template, replacements);
-    stream << str;
-
-    stream.flush();
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 } // namespace commsdsl2comms
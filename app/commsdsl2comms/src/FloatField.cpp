@@ -371,7 +371,7 @@ void FloatField::updateIncludesCommonImpl(IncludesList& includes) const
     }
 }
 
-std::string FloatField::getClassDefinitionImpl(
+common::Fragment FloatField::getClassDefinitionImpl(
     const std::string& scope,
     const std::string& className) const
 {
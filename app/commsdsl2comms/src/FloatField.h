@@ -33,7 +33,7 @@ protected:
     virtual bool prepareImpl() override;
     virtual void updateIncludesImpl(IncludesList& includes) const override;
     virtual void updateIncludesCommonImpl(IncludesList& includes) const override;
-    virtual std::string getClassDefinitionImpl(
+    virtual common::Fragment getClassDefinitionImpl(
         const std::string& scope,
         const std::string& className) const override;
     virtual std::string getPluginPropertiesImpl(bool serHiddenParam) const override;
@@ -16,7 +16,6 @@
 #include "Frame.h"
 
 #include <cassert>
-#include <fstream>
 #include <map>
 #include <algorithm>
 #include <iterator>
@@ -37,7 +36,7 @@ namespace commsdsl2comms
 namespace
 {
 
-const std::string Template(
+const common::CompiledTemplate Template(
     "#^#GEN_COMMENT#$#\n"
     "/// @file\n"
     "/// @brief Contains definition of <b>\"#^#CLASS_NAME#$#\"</b> frame class.\n"
@@ -242,19 +241,7 @@ bool Frame::writeProtocolDefinitionCommonFile()
 
     auto str = common::processTemplate(Templ, repl);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Frame::writeProtocol()
@@ -269,7 +256,7 @@ bool Frame::writeProtocol()
         return true;
     }
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("GEN_COMMENT", m_generator.fileGeneratedComment()));
     replacements.insert(std::make_pair("CLASS_NAME", className));
     replacements.insert(std::make_pair("ORIG_CLASS_NAME", common::nameToClassCopy(name())));
@@ -290,21 +277,9 @@ bool Frame::writeProtocol()
     replacements.insert(std::make_pair("BEGIN_NAMESPACE", std::move(namespaces.first)));
     replacements.insert(std::make_pair("END_NAMESPACE", std::move(namespaces.second)));
 
-    auto str = common::processTemplate(Template, replacements);
-
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
+    auto str = Template.render(replacements);
 
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Frame::writePluginTransportMessageHeader()
@@ -429,19 +404,7 @@ bool Frame::writePluginTransportMessageHeader()
 
     std::string str = common::processTemplate(Templ, replacements);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Frame::writePluginTransportMessageSrc()
@@ -455,7 +418,7 @@ bool Frame::writePluginTransportMessageSrc()
         return true;
     }
 
-    static const std::string Templ = 
+    static const common::CompiledTemplate Templ(
         "#^#GEN_COMMENT#$#\n"
         "#include \"#^#CLASS_NAME#$#.h\"\n\n"
         "#include \"comms_champion/property/field.h\"\n"
@@ -479,11 +442,10 @@ bool Frame::writePluginTransportMessageSrc()
         "}\n\n"
         "#^#READ_FUNC#$#\n"
         "#^#END_NAMESPACE#$#\n"
-        "#^#FILE_APPEND#$#\n"
-    ;
+        "#^#FILE_APPEND#$#\n");
 
     common::StringsList includes;
-    common::StringsList fieldsProps;
+    common::FragmentsList fieldsProps;
     common::StringsList appends;
     includes.reserve(m_layers.size());
     fieldsProps.reserve(m_layers.size());
@@ -513,12 +475,17 @@ bool Frame::writePluginTransportMessageSrc()
 
     auto namespaces = m_generator.namespacesForFrameInPlugin(m_externalRef);
 
-    common::ReplacementMap replacements;
+    auto fieldsPropsFrag = common::Fragment::join(fieldsProps, "\n");
+    if (!fieldsPropsFrag.empty()) {
+        fieldsPropsFrag.append("\n");
+    }
+
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("GEN_COMMENT", m_generator.fileGeneratedComment()));
     replacements.insert(std::make_pair("CLASS_NAME", std::move(className)));
     replacements.insert(std::make_pair("BEGIN_NAMESPACE", std::move(namespaces.first)));
     replacements.insert(std::make_pair("END_NAMESPACE", std::move(namespaces.second)));
-    replacements.insert(std::make_pair("FIELDS_PROPS", common::listToString(fieldsProps, "\n", "\n")));
+    replacements.insert(std::make_pair("FIELDS_PROPS", std::move(fieldsPropsFrag)));
     replacements.insert(std::make_pair("APPENDS", common::listToString(appends, "\n", common::emptyString())));
     replacements.insert(std::make_pair("FILE_APPEND", m_generator.getExtraAppendForFrameTransportMessageSrcInPlugin(m_externalRef)));
 
@@ -603,21 +570,9 @@ bool Frame::writePluginTransportMessageSrc()
     }
 
 
-    std::string str = common::processTemplate(Templ, replacements);
-
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
+    auto contents = Templ.render(replacements);
 
-    return true;
+    return m_generator.writeOutputFile(filePath, contents);
 }
 
 bool Frame::writePluginHeader()
@@ -681,19 +636,7 @@ bool Frame::writePluginHeader()
 
     std::string str = common::processTemplate(Templ, replacements);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 std::string Frame::getDescription() const
@@ -733,9 +676,9 @@ std::string Frame::getIncludes() const
     return common::includesToStatements(includes);
 }
 
-std::string Frame::getLayersDef() const
+common::Fragment Frame::getLayersDef() const
 {
-    common::StringsList defs;
+    common::FragmentsList defs;
     defs.reserve(m_layers.size() + 1);
 
     auto scope =
@@ -768,7 +711,7 @@ std::string Frame::getLayersDef() const
     }
     defs.push_back(common::processTemplate(StackDefTempl, replacements));
 
-    return common::listToString(defs, "\n", common::emptyString());
+    return common::Fragment::join(defs, "\n");
 
 }
 
@@ -71,7 +71,7 @@ private:
 
     std::string getDescription() const;
     std::string getIncludes() const;
-    std::string getLayersDef() const;
+    common::Fragment getLayersDef() const;
     std::string getFrameDef() const;
     std::string getLayersAccess() const;
     std::string getLayersAccessDoc() const;
@@ -16,9 +16,12 @@
 #include "Generator.h"
 
 #include <fstream>
+#include <iostream>
 #include <iterator>
 #include <algorithm>
 #include <cctype>
+#include <thread>
+#include <atomic>
 
 #include <boost/algorithm/string.hpp>
 
@@ -404,18 +407,16 @@ std::string Generator::startProtocolPluginCommonWrite(
     auto fullPathStr = fullPath.string();
 
     for (auto iter = m_codeInputDirs.rbegin(); iter != m_codeInputDirs.rend(); ++iter) {
-        auto overwriteFile = *iter / relDirPath / fileName;
-        boost::system::error_code ec;
-        if (bf::exists(overwriteFile, ec)) {
+        auto overwriteFile = relDirPath / fileName;
+        if (m_codeInputIndex.exists(*iter, overwriteFile)) {
             m_logger.info("Skipping generation of " + fullPathStr);
             return common::emptyString();
         }
 
-        auto replaceFile = *iter / relDirPath / (fileName + ReplaceSuffix);
-        if (bf::exists(replaceFile, ec)) {
-            m_logger.info("Replacing " + fullPathStr + " with " + replaceFile.string());
-            bf::copy_file(replaceFile, bf::path(fullPathStr), bf::copy_option::overwrite_if_exists, ec);
-            if (ec) {
+        auto replaceFile = relDirPath / (fileName + ReplaceSuffix);
+        if (m_codeInputIndex.exists(*iter, replaceFile)) {
+            m_logger.info("Replacing " + fullPathStr + " with " + (*iter / replaceFile).string());
+            if (!copyOutputFile(*iter, replaceFile, fullPathStr)) {
                 m_logger.warning("Failed to write " + fullPathStr);
                 static constexpr bool Should_not_happen = false;
                 static_cast<void>(Should_not_happen);
@@ -929,6 +930,11 @@ const Field* Generator::findField(const std::string& externalRef, bool record)
         fromPos = pos + 1U;
     }
     std::string remStr(externalRef, fromPos);
+    std::unique_lock<std::mutex> lock(m_accessedFieldsMutex, std::defer_lock);
+    if (record) {
+        lock.lock();
+    }
+
     auto result = (*nsIter)->findField(remStr, record);
     if (result == nullptr) {
         m_logger.error("Internal error: unknown external reference: " + externalRef);
@@ -1013,6 +1019,10 @@ bool Generator::parseOptions()
         m_codeInputDirs.push_back(std::move(*iter));
     }
 
+    if (!m_codeInputIndex.scan(m_codeInputDirs)) {
+        return false;
+    }
+
     m_mainNamespace = common::adjustName(m_options.getNamespace());
 
     if (!parseCustomization()) {
@@ -1054,17 +1064,40 @@ bool Generator::parseCustomization()
 
 bool Generator::parseSchemaFiles(const FilesList& files)
 {
+    m_jobs = m_options.getJobs();
+    if (m_jobs == 0U) {
+        m_jobs = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    m_protocol.setStatsEnabled(m_options.statsRequested());
+    m_protocol.setValidationJobs(m_jobs);
+
+    auto cacheFile = m_options.getCacheFile();
+    if ((!cacheFile.empty()) && m_protocol.loadCache(cacheFile, files)) {
+        m_logger.info("Using cached schema from " + cacheFile);
+        printStats();
+        return processSchema();
+    }
+
     for (auto& f : files) {
         m_logger.log(commsdsl::ErrorLevel_Info, "Parsing " + f);
-        if (!m_protocol.parse(f)) {
-            return false;
-        }
+    }
 
-        if (m_logger.hadWarning()) {
-            m_logger.log(commsdsl::ErrorLevel_Error, "Warning treated as error");
-            return false;
+    if (m_options.streamParseRequested()) {
+        for (auto& f : files) {
+            if (!m_protocol.parseStreamed(f)) {
+                return false;
+            }
         }
     }
+    else if (!m_protocol.parseAll(files, m_jobs)) {
+        return false;
+    }
+
+    if (m_logger.hadWarning()) {
+        m_logger.log(commsdsl::ErrorLevel_Error, "Warning treated as error");
+        return false;
+    }
 
     if (!m_protocol.validate()) {
         return false;
@@ -1075,6 +1108,85 @@ bool Generator::parseSchemaFiles(const FilesList& files)
         return false;
     }
 
+    if ((!cacheFile.empty()) && (!m_protocol.saveCache(cacheFile, files))) {
+        m_logger.warning("Failed to update schema cache " + cacheFile);
+    }
+
+    printStats();
+    return processSchema();
+}
+
+void Generator::printStats() const
+{
+    if (!m_options.statsRequested()) {
+        return;
+    }
+
+    static const std::string ElementsNames[] = {
+        /* Field */ "fields",
+        /* Message */ "messages",
+        /* Interface */ "interfaces",
+        /* Frame */ "frames"
+    };
+
+    static const std::size_t ElementsNamesCount = std::extent<decltype(ElementsNames)>::value;
+    static_assert(ElementsNamesCount == static_cast<std::size_t>(commsdsl::Protocol::ElementKind::NumOfValues),
+        "Invalid map");
+
+    static const std::string FieldsNames[] = {
+        /* Int */ "int",
+        /* Enum */ "enum",
+        /* Set */ "set",
+        /* Float */ "float",
+        /* Bitfield */ "bitfield",
+        /* Bundle */ "bundle",
+        /* String */ "string",
+        /* Data */ "data",
+        /* List */ "list",
+        /* Ref */ "ref",
+        /* Optional */ "optional",
+        /* Variant */ "variant"
+    };
+
+    static const std::size_t FieldsNamesCount = std::extent<decltype(FieldsNames)>::value;
+    static_assert(FieldsNamesCount == static_cast<std::size_t>(commsdsl::Field::Kind::NumOfValues),
+        "Invalid map");
+
+    auto stats = m_protocol.stats();
+    auto& out = std::cout;
+    out << "Schema statistics:\n";
+    for (auto& f : stats.m_files) {
+        out << "  Parse \"" << f.m_file << "\": " << f.m_parseTimeUs << " us\n";
+    }
+
+    for (auto& p : stats.m_phases) {
+        out << "  Validate " << p.m_name << ": " << p.m_timeUs << " us\n";
+    }
+
+    out << "  Namespaces: " << stats.m_namespacesCount << '\n';
+    for (auto idx = 0U; idx < ElementsNamesCount; ++idx) {
+        out << "  Global " << ElementsNames[idx] << ": " << stats.m_elementsCount[idx] << '\n';
+    }
+
+    out << "  Layers: " << stats.m_layersCount << '\n';
+    for (auto idx = 0U; idx < FieldsNamesCount; ++idx) {
+        if (stats.m_createdFieldsCount[idx] == 0U) {
+            continue;
+        }
+
+        out << "  Created <" << FieldsNames[idx] << "> fields: " << stats.m_createdFieldsCount[idx] << '\n';
+    }
+
+    out << "  Reused fields: " << stats.m_reusedFieldsCount << " (" << stats.m_reuseBytes << " bytes)\n";
+    out << "  Cloned fields: " << stats.m_clonedFieldsCount << '\n';
+    out << "  References lookups: " << stats.m_refLookupsCount <<
+           " (" << stats.m_failedRefLookupsCount << " failed)\n";
+    out << "  Peak model memory: " << stats.m_peakModelMemory << " bytes\n";
+    out << "  Interned strings: " << stats.m_internedStringsCount << std::endl;
+}
+
+bool Generator::processSchema()
+{
     auto schema = m_protocol.schema();
     m_schemaNamespace = common::adjustName(schema.name());
     if (m_mainNamespace.empty()) {
@@ -1102,7 +1214,6 @@ bool Generator::parseSchemaFiles(const FilesList& files)
     }
 
     m_minRemoteVersion = m_options.getMinRemoteVersion();
-
     return true;
 }
 
@@ -1158,6 +1269,7 @@ bool Generator::prepare()
 
 bool Generator::writeFiles()
 {
+    m_outputManifest.load(m_pathPrefix);
     if ((!FieldBase::write(*this)) ||
         (!MsgId::write(*this)) ||
         (!Version::write(*this)) ||
@@ -1166,17 +1278,25 @@ bool Generator::writeFiles()
         return false;
     }
 
+    Namespace::WriteJobsList jobs;
     for (auto& ns : m_namespaces) {
-        if ((!ns->writeInterfaces()) ||
-            (!ns->writeMessages()) ||
-            (!ns->writeFrames())) {
-            return false;
-        }
+        ns->addInterfacesWriteJobs(jobs);
+        ns->addMessagesWriteJobs(jobs);
+        ns->addFramesWriteJobs(jobs);
+    }
 
+    if (!runWriteJobs(jobs)) {
+        return false;
     }
 
+    auto runner =
+        [this](const Namespace::WriteJobsList& fieldsJobs)
+        {
+            return runWriteJobs(fieldsJobs);
+        };
+
     for (auto& ns : m_namespaces) {
-        if (!ns->writeFields()) {
+        if (!ns->writeFields(runner)) {
             return false;
         }
     }
@@ -1197,11 +1317,94 @@ bool Generator::writeFiles()
         }
     }
 
-    return true;
+    return m_outputManifest.finalise();
+}
+
+bool Generator::runWriteJobs(const Namespace::WriteJobsList& jobs)
+{
+    auto threadsCount = std::min(static_cast<std::size_t>(m_jobs), jobs.size());
+    if (threadsCount <= 1U) {
+        return
+            std::all_of(
+                jobs.begin(), jobs.end(),
+                [](auto& j)
+                {
+                    return j();
+                });
+    }
+
+    // The jobs are picked up in order of appearance by whichever thread is
+    // free. The logs of every job are buffered and flushed in the jobs order
+    // afterwards, the output is the same as for the sequential execution.
+    std::vector<Logger::RecordsList> logs(jobs.size());
+    std::atomic<std::size_t> nextJob(0U);
+    std::atomic<std::size_t> failedJob(jobs.size());
+    auto workFunc =
+        [&jobs, &logs, &nextJob, &failedJob]()
+        {
+            while (true) {
+                auto idx = nextJob++;
+                if ((jobs.size() <= idx) || (failedJob < idx)) {
+                    break;
+                }
+
+                Logger::captureThreadRecords(&logs[idx]);
+                bool result = jobs[idx]();
+                Logger::captureThreadRecords(nullptr);
+                if (result) {
+                    continue;
+                }
+
+                auto failedIdx = failedJob.load();
+                while ((idx < failedIdx) && (!failedJob.compare_exchange_weak(failedIdx, idx))) {}
+            }
+        };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadsCount - 1U);
+    for (std::size_t idx = 1U; idx < threadsCount; ++idx) {
+        threads.emplace_back(workFunc);
+    }
+
+    workFunc();
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    auto lastIdx = std::min(static_cast<std::size_t>(failedJob), jobs.size() - 1U);
+    for (std::size_t idx = 0U; idx <= lastIdx; ++idx) {
+        m_logger.flush(logs[idx]);
+    }
+
+    return failedJob == jobs.size();
+}
+
+bool Generator::writeOutputFile(const std::string& filePath, const std::string& contents)
+{
+    return m_outputManifest.write(filePath, contents);
+}
+
+bool Generator::writeOutputFile(const std::string& filePath, const common::Fragment& contents)
+{
+    return writeOutputFile(filePath, contents.str());
+}
+
+bool Generator::copyOutputFile(
+    const boost::filesystem::path& codeInputDir,
+    const boost::filesystem::path& relPath,
+    const std::string& filePath)
+{
+    std::string content;
+    if (!m_codeInputIndex.read(codeInputDir, relPath, content)) {
+        return false;
+    }
+
+    return writeOutputFile(filePath, content);
 }
 
 bool Generator::createDir(const boost::filesystem::path& path)
 {
+    std::lock_guard<std::mutex> guard(m_createdDirsMutex);
     auto iter = m_createdDirs.find(path);
     if (iter != m_createdDirs.end()) {
         return true;
@@ -1264,47 +1467,26 @@ bool Generator::writeExtraFiles()
 
     for (auto& d : m_codeInputDirs) {
         auto outputDir = m_pathPrefix;
-        auto dirStr = d.string();
-        auto pos = dirStr.size();
-        auto endIter = bf::recursive_directory_iterator();
-        for (auto iter = bf::recursive_directory_iterator(d); iter != endIter; ++iter) {
-            if (!bf::is_regular_file(iter->status())) {
-                continue;
-            }
-
-            auto srcPath = iter->path();
-            auto ext = srcPath.extension().string();
+        auto files = m_codeInputIndex.files(d);
+        for (auto& srcRelPath : files) {
+            auto ext = bf::path(srcRelPath).extension().string();
             auto extIter = std::find(std::begin(ReservedExt), std::end(ReservedExt), ext);
             if (extIter != std::end(ReservedExt)) {
                 continue;
             }
 
-            auto pathStr = srcPath.string();
-            auto posTmp = pos;
-            while (posTmp < pathStr.size()) {
-                if (pathStr[posTmp] == bf::path::preferred_separator) {
-                    ++posTmp;
-                    continue;
-                }
-                break;
-            }
-
-            if (pathStr.size() <= posTmp) {
-                continue;
-            }
-
-            std::string relPath(pathStr, posTmp);
+            auto relPath = srcRelPath;
             do {
                 if (m_mainNamespace == m_schemaNamespace) {
                     break;
                 }
 
-                auto srcPrefix = (bf::path(common::includeStr()) / m_schemaNamespace).string();
+                auto srcPrefix = (bf::path(common::includeStr()) / m_schemaNamespace).generic_string();
                 if (!ba::starts_with(relPath, srcPrefix)) {
                     break;
                 }
 
-                auto dstPrefix = (bf::path(common::includeStr()) / m_mainNamespace).string();
+                auto dstPrefix = (bf::path(common::includeStr()) / m_mainNamespace).generic_string();
                 relPath = dstPrefix + std::string(relPath, srcPrefix.size());
             } while (false);
             auto destPath = outputDir / relPath;
@@ -1315,36 +1497,22 @@ bool Generator::writeExtraFiles()
                 return false;
             }
 
-            boost::system::error_code ec;
-            bf::copy_file(srcPath, destPath, bf::copy_option::overwrite_if_exists, ec);
-            if (ec) {
-                m_logger.error("Failed to copy with reason: " + ec.message());
+            std::string content;
+            if (!m_codeInputIndex.read(d, srcRelPath, content)) {
+                m_logger.error("Failed to open " + (d / srcRelPath).string() + " for reading.");
                 return false;
             }
 
+            auto destStr = destPath.string();
             if (m_mainNamespace != m_schemaNamespace) {
                 // The namespace has changed
-
-                auto destStr = destPath.string();
-                std::ifstream stream(destStr);
-                if (!stream) {
-                    m_logger.error("Failed to open " + destStr + " for modification.");
-                    return false;
-                }
-
-                std::string content((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
-                stream.close();
-
                 ba::replace_all(content, "namespace " + m_schemaNamespace, "namespace " + m_mainNamespace);
-                std::ofstream outStream(destStr, std::ios_base::trunc);
-                if (!outStream) {
-                    m_logger.error("Failed to modify " + destStr + ".");
-                    return false;
-                }
-
-                outStream << content;
                 m_logger.info("Updated " + destStr + " to have proper main namespace.");
             }
+
+            if (!writeOutputFile(destStr, content)) {
+                return false;
+            }
         }
     }
     return true;
@@ -1710,21 +1878,18 @@ std::string Generator::getExtraAppendForFile(const std::vector<std::string>& ele
         return common::emptyString();
     }
 
-    for (auto iter = m_codeInputDirs.rbegin(); iter != m_codeInputDirs.rend(); ++iter) {
-        auto filePath = *iter;
-        for (auto& e : elems) {
-            filePath /= e;
-        }
+    bf::path relPath;
+    for (auto& e : elems) {
+        relPath /= e;
+    }
 
-        filePath += AppendSuffix;
+    relPath += AppendSuffix;
 
-        std::ifstream stream(filePath.string());
-        if (!stream) {
-            continue;
+    std::string content;
+    for (auto iter = m_codeInputDirs.rbegin(); iter != m_codeInputDirs.rend(); ++iter) {
+        if (m_codeInputIndex.read(*iter, relPath, content)) {
+            return content;
         }
-
-        std::string content((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
-        return content;
     }
     return common::emptyString();
 }
@@ -1966,28 +2131,25 @@ Generator::startProtocolWrite(
     auto fullPathStr = fullPath.string();
 
     for (auto iter = m_codeInputDirs.rbegin(); iter != m_codeInputDirs.rend(); ++iter) {
-        auto overwriteFile = *iter / relDirPath / fileName;
-        boost::system::error_code ec;
-        if (bf::exists(overwriteFile, ec)) {
+        auto overwriteFile = relDirPath / fileName;
+        if (m_codeInputIndex.exists(*iter, overwriteFile)) {
             m_logger.info("Skipping generation of " + fullPathStr);
             return std::make_pair(common::emptyString(), common::emptyString());
         }
 
-        auto replaceFile = *iter / relDirPath / (fileName + ReplaceSuffix);
-        if (bf::exists(replaceFile, ec)) {
-            m_logger.info("Replacing " + fullPathStr + " with " + replaceFile.string());
-            bf::copy_file(replaceFile, bf::path(fullPathStr), bf::copy_option::overwrite_if_exists, ec);
-            if (ec) {
-                m_logger.warning("Failed to write \"" + fullPathStr + "\": " + ec.message());
+        auto replaceFile = relDirPath / (fileName + ReplaceSuffix);
+        if (m_codeInputIndex.exists(*iter, replaceFile)) {
+            m_logger.info("Replacing " + fullPathStr + " with " + (*iter / replaceFile).string());
+            if (!copyOutputFile(*iter, replaceFile, fullPathStr)) {
+                m_logger.warning("Failed to write \"" + fullPathStr + "\".");
             }
             return std::make_pair(common::emptyString(), common::emptyString());
         }
 
-        auto extendFile = *iter / relDirPath / (fileName + ExtendSuffix);
-        if (bf::exists(extendFile, ec)) {
-            bf::copy_file(extendFile, bf::path(fullPathStr), bf::copy_option::overwrite_if_exists, ec);
-            if (ec) {
-                m_logger.warning("Failed to write \"" + fullPathStr + "\": " + ec.message());
+        auto extendFile = relDirPath / (fileName + ExtendSuffix);
+        if (m_codeInputIndex.exists(*iter, extendFile)) {
+            if (!copyOutputFile(*iter, extendFile, fullPathStr)) {
+                m_logger.warning("Failed to write \"" + fullPathStr + "\".");
             }
             className += common::origSuffixStr();
             fileName = className + common::headerSuffix();
@@ -2041,18 +2203,16 @@ std::pair<std::string, std::string> Generator::startPluginWrite(
     auto fullPathStr = fullPath.string();
 
     for (auto iter = m_codeInputDirs.rbegin(); iter != m_codeInputDirs.rend(); ++iter) {
-        auto overwriteFile = *iter / relDirPath / fileName;
-        boost::system::error_code ec;
-        if (bf::exists(overwriteFile, ec)) {
+        auto overwriteFile = relDirPath / fileName;
+        if (m_codeInputIndex.exists(*iter, overwriteFile)) {
             m_logger.info("Skipping generation of " + fullPathStr);
             return std::make_pair(common::emptyString(), common::emptyString());
         }
 
-        auto replaceFile = *iter / relDirPath / (fileName + ReplaceSuffix);
-        if (bf::exists(replaceFile, ec)) {
-            m_logger.info("Replacing " + fullPathStr + " with " + replaceFile.string());
-            bf::copy_file(replaceFile, bf::path(fullPathStr), bf::copy_option::overwrite_if_exists, ec);
-            if (ec) {
+        auto replaceFile = relDirPath / (fileName + ReplaceSuffix);
+        if (m_codeInputIndex.exists(*iter, replaceFile)) {
+            m_logger.info("Replacing " + fullPathStr + " with " + (*iter / replaceFile).string());
+            if (!copyOutputFile(*iter, replaceFile, fullPathStr)) {
                 m_logger.warning("Failed to write " + fullPathStr);
                 static constexpr bool Should_not_happen = false;
                 static_cast<void>(Should_not_happen);
@@ -2061,11 +2221,10 @@ std::pair<std::string, std::string> Generator::startPluginWrite(
             return std::make_pair(common::emptyString(), common::emptyString());
         }
 
-        auto extendFile = *iter / relDirPath / (fileName + ExtendSuffix);
-        if (bf::exists(extendFile, ec)) {
-            bf::copy_file(extendFile, bf::path(fullPathStr), bf::copy_option::overwrite_if_exists, ec);
-            if (ec) {
-                m_logger.warning("Failed to write \"" + fullPathStr + "\": " + ec.message());
+        auto extendFile = relDirPath / (fileName + ExtendSuffix);
+        if (m_codeInputIndex.exists(*iter, extendFile)) {
+            if (!copyOutputFile(*iter, extendFile, fullPathStr)) {
+                m_logger.warning("Failed to write \"" + fullPathStr + "\".");
                 static constexpr bool Should_not_happen = false;
                 static_cast<void>(Should_not_happen);
                 assert(Should_not_happen);
@@ -2120,19 +2279,17 @@ std::string Generator::startGenericWrite(
     auto fullPathStr = fullPath.string();
 
     for (auto iter = m_codeInputDirs.rbegin(); iter != m_codeInputDirs.rend(); ++iter) {
-        auto overwriteFile = *iter / relDirPath / name;
-        boost::system::error_code ec;
-        if (bf::exists(overwriteFile, ec)) {
+        auto overwriteFile = relDirPath / name;
+        if (m_codeInputIndex.exists(*iter, overwriteFile)) {
             m_logger.info("Skipping generation of " + fullPathStr);
             return common::emptyString();
         }
 
-        auto replaceFile = *iter / relDirPath / (name + ReplaceSuffix);
-        if (bf::exists(replaceFile, ec)) {
-            m_logger.info("Replacing " + fullPathStr + " with " + replaceFile.string());
-            bf::copy_file(replaceFile, bf::path(fullPathStr), bf::copy_option::overwrite_if_exists, ec);
-            if (ec) {
-                m_logger.warning("Failed to write \"" + fullPathStr + "\": " + ec.message());
+        auto replaceFile = relDirPath / (name + ReplaceSuffix);
+        if (m_codeInputIndex.exists(*iter, replaceFile)) {
+            m_logger.info("Replacing " + fullPathStr + " with " + (*iter / replaceFile).string());
+            if (!copyOutputFile(*iter, replaceFile, fullPathStr)) {
+                m_logger.warning("Failed to write \"" + fullPathStr + "\".");
             }
             return common::emptyString();
         }
@@ -2175,15 +2332,12 @@ std::string Generator::getCustomOpForElement(
     auto className = refToName(externalRef);
     assert(!className.empty());
 
+    auto relPath = relDirPath / (className + ext + suffix);
+    std::string content;
     for (auto iter = m_codeInputDirs.rbegin(); iter != m_codeInputDirs.rend(); ++iter) {
-        auto filePath = *iter / relDirPath / (className + ext + suffix);
-        std::ifstream stream(filePath.string());
-        if (!stream) {
-            continue;
+        if (m_codeInputIndex.read(*iter, relPath, content)) {
+            return content;
         }
-
-        std::string content((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
-        return content;
     }
     return common::emptyString();
 }
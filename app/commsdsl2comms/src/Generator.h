@@ -20,11 +20,14 @@
 #include <set>
 #include <map>
 #include <cstdint>
+#include <mutex>
 
 #include <boost/filesystem.hpp>
 
 #include "commsdsl/Protocol.h"
 #include "Logger.h"
+#include "OutputManifest.h"
+#include "CodeInputIndex.h"
 #include "ProgramOptions.h"
 #include "Namespace.h"
 #include "Plugin.h"
@@ -45,7 +48,7 @@ public:
     using FramesAccessList = Namespace::FramesAccessList;
 
     Generator(ProgramOptions& options, Logger& logger)
-      : m_options(options), m_logger(logger)
+      : m_options(options), m_logger(logger), m_outputManifest(logger), m_codeInputIndex(logger)
     {
     }
 
@@ -158,6 +161,13 @@ public:
     std::pair<std::string, std::string>
     startGenericPluginSrcWrite(const std::string& name);
 
+    bool writeOutputFile(const std::string& filePath, const std::string& contents);
+    bool writeOutputFile(const std::string& filePath, const common::Fragment& contents);
+    bool copyOutputFile(
+        const boost::filesystem::path& codeInputDir,
+        const boost::filesystem::path& relPath,
+        const std::string& filePath);
+
     std::pair<std::string, std::string>
     namespacesForMessage(const std::string& externalRef) const;
 
@@ -355,7 +365,7 @@ public:
         bool plugin = false);
 
 
-    commsdsl::Protocol::MessagesList getAllDslMessages() const
+    const commsdsl::Protocol::MessagesList& getAllDslMessages() const
     {
         return m_protocol.allMessages();
     }
@@ -463,8 +473,11 @@ private:
     bool parseOptions();
     bool parseCustomization();
     bool parseSchemaFiles(const FilesList& files);
+    bool processSchema();
+    void printStats() const;
     bool prepare();
     bool writeFiles();
+    bool runWriteJobs(const Namespace::WriteJobsList& jobs);
     bool createDir(const boost::filesystem::path& path);
     boost::filesystem::path getProtocolDefRootDir() const;
     bool mustDefineDefaultInterface() const;
@@ -525,17 +538,22 @@ private:
 
     ProgramOptions& m_options;
     Logger& m_logger;
+    OutputManifest m_outputManifest;
     commsdsl::Protocol m_protocol;
     NamespacesList m_namespaces;
     PluginsList m_plugins;
     boost::filesystem::path m_pathPrefix;
     std::vector<boost::filesystem::path> m_codeInputDirs;
+    CodeInputIndex m_codeInputIndex;
     std::set<boost::filesystem::path> m_createdDirs;
+    std::mutex m_createdDirsMutex;
+    std::mutex m_accessedFieldsMutex;
     std::string m_mainNamespace;
     std::string m_schemaNamespace;
     commsdsl::Endian m_schemaEndian = commsdsl::Endian_NumOfValues;
     unsigned m_schemaVersion = 0U;
     unsigned m_minRemoteVersion = 0U;
+    unsigned m_jobs = 1U;
     CustomizationLevel m_customizationLevel = CustomizationLevel::Limited;
     const Field* m_messageIdField = nullptr;
     ExtraMessagesInfosList m_extraMessages;
@@ -33,7 +33,7 @@ void IdLayer::updateIncludesImpl(Layer::IncludesList& includes) const
     common::mergeInclude(generator().headerfileForInput(common::allMessagesStr(), false), includes);
 }
 
-std::string IdLayer::getClassDefinitionImpl(
+common::Fragment IdLayer::getClassDefinitionImpl(
     const std::string& scope,
     std::string& prevLayer,
     bool& hasInputMessages) const
@@ -42,7 +42,7 @@ std::string IdLayer::getClassDefinitionImpl(
     assert(!hasInputMessages);
     assert(!prevLayer.empty());
 
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "#^#FIELD_DEF#$#\n"
         "#^#PREFIX#$#\n"
         "template <typename TMessage, typename TAllMessages>\n"
@@ -53,9 +53,9 @@ std::string IdLayer::getClassDefinitionImpl(
         "        TAllMessages,\n"
         "        #^#PREV_LAYER#$##^#COMMA#$#\n"
         "        #^#EXTRA_OPT#$#\n"
-        "    >;\n";
+        "    >;\n");
     
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("FIELD_DEF", getFieldDefinition(scope)));
     replacements.insert(std::make_pair("PREFIX", getPrefix()));
     replacements.insert(std::make_pair("FIELD_TYPE", getFieldType()));
@@ -69,7 +69,7 @@ std::string IdLayer::getClassDefinitionImpl(
 
     prevLayer = common::nameToClassCopy(name());
     hasInputMessages = true;
-    return common::processTemplate(Templ, replacements);
+    return Templ.render(replacements);
 }
 
 std::string IdLayer::getBareMetalOptionStrImpl(const std::string& base) const
@@ -278,7 +278,7 @@ void IntField::updateIncludesCommonImpl(IncludesList& includes) const
     common::mergeIncludes(List, includes);
 }
 
-std::string IntField::getClassDefinitionImpl(
+common::Fragment IntField::getClassDefinitionImpl(
     const std::string& scope,
     const std::string& className) const
 {
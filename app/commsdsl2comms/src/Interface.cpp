@@ -16,7 +16,6 @@
 #include "Interface.h"
 
 #include <cassert>
-#include <fstream>
 #include <map>
 #include <algorithm>
 #include <iterator>
@@ -36,7 +35,7 @@ namespace commsdsl2comms
 namespace
 {
 
-const std::string AliasTemplate(
+const common::CompiledTemplate AliasTemplate(
     "#^#GEN_COMMENT#$#\n"
     "/// @file\n"
     "/// @brief Contains definition of <b>\"#^#CLASS_NAME#$#\"</b> interface class.\n"
@@ -60,7 +59,7 @@ const std::string AliasTemplate(
     "#^#APPEND#$#\n"
 );
 
-const std::string ClassTemplate(
+const common::CompiledTemplate ClassTemplate(
     "#^#GEN_COMMENT#$#\n"
     "/// @file\n"
     "/// @brief Contains definition of <b>\"#^#CLASS_NAME#$#\"</b> interface class.\n"
@@ -151,7 +150,7 @@ std::string PluginHeaderAliasTemplate =
     "#^#END_NAMESPACE#$#\n\n"
     "#^#APPEND#$#\n";
 
-std::string PluginSrcTemplate = 
+const common::CompiledTemplate PluginSrcTemplate(
     "#^#GEN_COMMENT#$#\n"
     "#include \"#^#CLASS_NAME#$#.h\"\n\n"
     "#include \"comms_champion/property/field.h\"\n"
@@ -175,7 +174,7 @@ std::string PluginSrcTemplate =
     "    return Props;\n"
     "}\n\n"
     "#^#END_NAMESPACE#$#\n"
-    "#^#APPEND#$#\n";
+    "#^#APPEND#$#\n");
 } // namespace
 
 bool Interface::prepare()
@@ -323,19 +322,7 @@ bool Interface::writeProtocolDefinitionCommonFile()
 
     auto str = common::processTemplate(Templ, repl);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Interface::writeProtocol()
@@ -350,7 +337,7 @@ bool Interface::writeProtocol()
         return true;
     }
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("GEN_COMMENT", m_generator.fileGeneratedComment()));
     replacements.insert(std::make_pair("CLASS_NAME", className));
     replacements.insert(std::make_pair("PROT_NAMESPACE", m_generator.mainNamespace()));
@@ -400,21 +387,9 @@ bool Interface::writeProtocol()
         templ = &ClassTemplate;
     }
     
-    auto str = common::processTemplate(*templ, replacements);
+    auto str = templ->render(replacements);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Interface::writePluginHeader()
@@ -452,19 +427,7 @@ bool Interface::writePluginHeader()
 
     auto str = common::processTemplate(*templ, replacements);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Interface::writePluginSrc()
@@ -478,7 +441,7 @@ bool Interface::writePluginSrc()
         return true;
     }
 
-    std::string str;
+    common::Fragment contents;
     do {
         auto hexWidth = getHexMsgIdWidth();
         if ((m_fields.empty()) && (hexWidth == 0U)) {
@@ -487,11 +450,11 @@ bool Interface::writePluginSrc()
 
         auto scope = m_generator.scopeForInterface(m_externalRef, true, false);
         scope += common::nameToClassCopy(name()) + common::fieldsSuffixStr() + "::";
-        common::StringsList fieldsProps;
+        common::FragmentsList fieldsProps;
         common::StringsList appends;
         common::StringsList includes;
         fieldsProps.reserve(m_fields.size());
-        fieldsProps.reserve(appends.size());
+        appends.reserve(m_fields.size());
         for (auto& f : m_fields) {
             fieldsProps.push_back(f->getPluginCreatePropsFunc(scope, true, false));
             appends.push_back("props.append(createProps_" + common::nameToAccessCopy(f->name()) + "());");
@@ -500,13 +463,18 @@ bool Interface::writePluginSrc()
 
         auto namespaces = m_generator.namespacesForInterfaceInPlugin(m_externalRef);
 
-        common::ReplacementMap replacements;
+        auto fieldsPropsFrag = common::Fragment::join(fieldsProps, "\n");
+        if (!fieldsPropsFrag.empty()) {
+            fieldsPropsFrag.append("\n");
+        }
+
+        common::FragmentsMap replacements;
         replacements.insert(std::make_pair("GEN_COMMENT", m_generator.fileGeneratedComment()));
         replacements.insert(std::make_pair("CLASS_NAME", className));
         replacements.insert(std::make_pair("INTERFACE", m_generator.scopeForInterface(externalRef(), true, true)));
         replacements.insert(std::make_pair("BEGIN_NAMESPACE", std::move(namespaces.first)));
         replacements.insert(std::make_pair("END_NAMESPACE", std::move(namespaces.second)));
-        replacements.insert(std::make_pair("FIELDS_PROPS", common::listToString(fieldsProps, "\n", "\n")));
+        replacements.insert(std::make_pair("FIELDS_PROPS", std::move(fieldsPropsFrag)));
         replacements.insert(std::make_pair("PROPS_APPENDS", common::listToString(appends, "\n", common::emptyString())));
         replacements.insert(std::make_pair("APPEND", m_generator.getExtraAppendForInterfaceSrcInPlugin(m_externalRef)));
         replacements.insert(std::make_pair("INCLUDES", common::includesToStatements(includes)));
@@ -521,22 +489,10 @@ bool Interface::writePluginSrc()
             replacements.insert(std::make_pair("ID_FUNC", std::move(func)));
         }
 
-        str = common::processTemplate(PluginSrcTemplate, replacements);
+        contents = PluginSrcTemplate.render(replacements);
     } while (false);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, contents);
 }
 
 std::string Interface::getDescription() const
@@ -717,22 +673,19 @@ std::string Interface::getFieldsAccessDoc() const
     return result;
 }
 
-std::string Interface::getFieldsDef() const
+common::Fragment Interface::getFieldsDef() const
 {
-    std::string result;
-
     auto scope =
         m_generator.scopeForInterface(m_externalRef, true, true) +
             common::fieldsSuffixStr() +
             "::";
 
+    common::FragmentsList defs;
+    defs.reserve(m_fields.size());
     for (auto& f : m_fields) {
-        result += f->getClassDefinition(scope);
-        if (&f != &m_fields.back()) {
-            result += '\n';
-        }
+        defs.push_back(f->getClassDefinition(scope));
     }
-    return result;
+    return common::Fragment::join(defs, "\n");
 }
 
 std::string Interface::getFieldsOpts() const
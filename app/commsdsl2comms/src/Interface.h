@@ -65,7 +65,7 @@ private:
     std::string getAliases() const;
     std::string getIncludes() const;
     std::string getFieldsAccessDoc() const;
-    std::string getFieldsDef() const;
+    common::Fragment getFieldsDef() const;
     std::string getFieldsOpts() const;
     unsigned getHexMsgIdWidth() const;
 
@@ -15,7 +15,7 @@
 
 #include "Latex.h"
 
-#include <fstream>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -62,12 +62,7 @@ namespace commsdsl2comms
             return true;
         }
 
-        std::ofstream stream(filePath);
-        if (!stream)
-        {
-            m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-            return false;
-        }
+        std::ostringstream stream;
 
         stream << "\\section{Platforms}" << std::endl
                << "\\begin{description}" << std::endl;
@@ -77,13 +72,7 @@ namespace commsdsl2comms
             stream << "\\item[" << platform << "] " << std::endl;
         }
         stream << "\\end{description}" << std::endl;
-        stream.flush();
-        if (!stream.good())
-        {
-            m_generator.logger().error("Failed to write \"" + filePath + "\".");
-            return false;
-        }
-        return true;
+        return m_generator.writeOutputFile(filePath, stream.str());
     }
 
     bool Latex::writeFrame() const
@@ -96,12 +85,7 @@ namespace commsdsl2comms
             return true;
         }
 
-        std::ofstream stream(filePath);
-        if (!stream)
-        {
-            m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-            return false;
-        }
+        std::ostringstream stream;
 
         stream << "\\section{Frames}" << std::endl;
 
@@ -126,7 +110,7 @@ namespace commsdsl2comms
             stream << "\\end{description}" << std::endl;
         }
 
-        return true;
+        return m_generator.writeOutputFile(filePath, stream.str());
     }
 
     bool Latex::writeMessages() const { return true; }
@@ -116,7 +116,7 @@ bool Layer::prepare()
     return prepareImpl();
 }
 
-std::string Layer::getClassDefinition(
+common::Fragment Layer::getClassDefinition(
     const std::string& scope,
     std::string& prevLayer,
     bool& hasInputMessages) const
@@ -201,9 +201,9 @@ std::string Layer::getFieldAccNameForPlugin() const
     return common::nameToAccessCopy(name());
 }
 
-std::string Layer::getPluginCreatePropsFunc(const std::string& scope) const
+common::Fragment Layer::getPluginCreatePropsFunc(const std::string& scope) const
 {
-    std::string func;
+    common::Fragment func;
     do {
         if (m_field) {
             auto fullScope = scope + common::nameToClassCopy(name()) + common::membersSuffixStr() + "::";
@@ -252,16 +252,16 @@ std::string Layer::getPluginCreatePropsFunc(const std::string& scope) const
         func = common::processTemplate(Templ, replacements);
     } while (false);
 
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "struct #^#CLASS_NAME#$#Layer\n"
         "{\n"
         "    #^#FUNC#$#\n"
-        "};\n";
+        "};\n");
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("CLASS_NAME", common::nameToClassCopy(name())));
     replacements.insert(std::make_pair("FUNC", std::move(func)));
-    return common::processTemplate(Templ, replacements);
+    return Templ.render(replacements);
 }
 
 std::string Layer::getCommonDefinition(const std::string& scope) const
@@ -327,25 +327,25 @@ std::string Layer::getPrefix() const
     return str;
 }
 
-std::string Layer::getFieldDefinition(const std::string& scope) const
+common::Fragment Layer::getFieldDefinition(const std::string& scope) const
 {
     if (!m_field) {
         return common::emptyString();
     }
 
-    static const std::string Templ = 
+    static const common::CompiledTemplate Templ(
         "/// @brief Scope for field(s) of @ref #^#CLASS_NAME#$# layer.\n"
         "struct #^#CLASS_NAME#$#Members\n"
         "{\n"
         "    #^#FIELD_DEF#$#\n"
-        "};\n";
+        "};\n");
 
     auto fullScope = scope + common::nameToClassCopy(name()) + common::membersSuffixStr() + "::";
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("CLASS_NAME", common::nameToClassCopy(name())));
     replacements.insert(std::make_pair("FIELD_DEF", m_field->getClassDefinition(fullScope)));
 
-    return common::processTemplate(Templ, replacements);
+    return Templ.render(replacements);
 }
 
 std::string Layer::getFieldType() const
@@ -52,7 +52,7 @@ public:
 
     bool prepare();
 
-    std::string getClassDefinition(
+    common::Fragment getClassDefinition(
         const std::string& scope,
         std::string& prevLayer,
         bool& hasInputMessages) const;
@@ -70,7 +70,7 @@ public:
 
     std::string getFieldScopeForPlugin(const std::string& scope) const;
     std::string getFieldAccNameForPlugin() const;
-    std::string getPluginCreatePropsFunc(const std::string& scope) const;
+    common::Fragment getPluginCreatePropsFunc(const std::string& scope) const;
     std::string getCommonDefinition(const std::string& scope) const;
     bool hasCommonDefinition() const;
 
@@ -96,7 +96,7 @@ protected:
     const Field* getField() const;
 
     std::string getPrefix() const;
-    std::string getFieldDefinition(const std::string& scope) const;
+    common::Fragment getFieldDefinition(const std::string& scope) const;
     std::string getFieldType() const;
     std::string getExtraOpt(const std::string& scope) const;
 
@@ -117,7 +117,7 @@ protected:
 
     virtual bool prepareImpl();
     virtual void updateIncludesImpl(IncludesList& includes) const;
-    virtual std::string getClassDefinitionImpl(
+    virtual common::Fragment getClassDefinitionImpl(
         const std::string& scope,
         std::string& prevLayer,
         bool& hasInputMessages) const = 0;
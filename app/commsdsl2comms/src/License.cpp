@@ -15,7 +15,6 @@
 
 #include "License.h"
 
-#include <fstream>
 #include <vector>
 #include <string>
 
@@ -45,12 +44,6 @@ bool License::writeTxt() const
         return true;
     }
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-
     static const std::string Template = 
         "This code has been generated by the commsdsl2comms[1] application has no license,\n"
         "the vendor is free to pick any as long as it's compatibile with the license(s) of the\n"
@@ -75,14 +68,7 @@ bool License::writeTxt() const
     common::ReplacementMap replacements;
     replacements.insert(std::make_pair("APPEND", m_generator.getExtraAppendForFile(LicenseFile)));
 
-    stream << common::processTemplate(Template, replacements);
-
-    stream.flush();
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-    return true;
+    return m_generator.writeOutputFile(filePath, common::processTemplate(Template, replacements));
 }
 
 } // namespace commsdsl2comms
@@ -32,7 +32,7 @@ namespace commsdsl2comms
 namespace
 {
 
-const std::string ClassTemplate(
+const common::CompiledTemplate ClassTemplate(
     "#^#MEMBERS_DEF#$#\n"
     "#^#PREFIX#$#"
     "class #^#CLASS_NAME#$# : public\n"
@@ -61,7 +61,7 @@ const std::string ClassTemplate(
     "};\n"
 );
 
-const std::string StructTemplate(
+const common::CompiledTemplate StructTemplate(
     "#^#MEMBERS_DEF#$#\n"
     "#^#PREFIX#$#"
     "struct #^#CLASS_NAME#$# : public\n"
@@ -75,7 +75,7 @@ const std::string StructTemplate(
     "};\n"
 );
 
-bool shouldUseStruct(const common::ReplacementMap& replacements)
+bool shouldUseStruct(const common::FragmentsMap& replacements)
 {
     auto hasNoValue =
         [&replacements](const std::string& val)
@@ -376,11 +376,11 @@ std::size_t ListField::maxLengthImpl() const
     return common::maxPossibleLength();
 }
 
-std::string ListField::getClassDefinitionImpl(
+common::Fragment ListField::getClassDefinitionImpl(
     const std::string& scope,
     const std::string& className) const
 {
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("PREFIX", getClassPrefix(className)));
     replacements.insert(std::make_pair("CLASS_NAME", className));
     replacements.insert(std::make_pair("PROT_NAMESPACE", generator().mainNamespace()));
@@ -401,11 +401,11 @@ std::string ListField::getClassDefinitionImpl(
         replacements.insert(std::make_pair("COMMA", ","));
     }
 
-    const std::string* templPtr = &ClassTemplate;
+    const common::CompiledTemplate* templPtr = &ClassTemplate;
     if (shouldUseStruct(replacements)) {
         templPtr = &StructTemplate;
     }
-    return common::processTemplate(*templPtr, replacements);
+    return templPtr->render(replacements);
 }
 
 std::string ListField::getExtraDefaultOptionsImpl(const std::string& scope) const
@@ -469,7 +469,7 @@ std::string ListField::getCompareToFieldImpl(
     return common::emptyString();
 }
 
-std::string ListField::getPluginAnonNamespaceImpl(
+common::Fragment ListField::getPluginAnonNamespaceImpl(
     const std::string& scope,
     bool forcedSerialisedHidden,
     bool serHiddenParam) const
@@ -489,16 +489,16 @@ std::string ListField::getPluginAnonNamespaceImpl(
         serHiddenParam = false;
     }
 
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "struct #^#CLASS_NAME#$#Members\n"
         "{\n"
         "    #^#PROPS#$#\n"
-        "};\n";
+        "};\n");
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("CLASS_NAME", common::nameToClassCopy(name())));
     replacements.insert(std::make_pair("PROPS", m_element->getPluginCreatePropsFunc(fullScope, forcedSerialisedHidden, serHiddenParam)));
-    return common::processTemplate(Templ, replacements);
+    return Templ.render(replacements);
 }
 
 std::string ListField::getPluginPropertiesImpl(bool serHiddenParam) const
@@ -920,13 +920,13 @@ std::string ListField::getElement() const
     return generator().scopeForField(extRef, true, true) + "<TOpt>";
 }
 
-std::string ListField::getMembersDef(const std::string& scope) const
+common::Fragment ListField::getMembersDef(const std::string& scope) const
 {
     auto membersScope =
         scope + common::nameToClassCopy(name()) +
         common::membersSuffixStr() + "::";
 
-    StringsList defs;
+    common::FragmentsList defs;
     auto recordFieldFunc =
         [this](commsdsl::Field f)
         {
@@ -999,20 +999,20 @@ std::string ListField::getMembersDef(const std::string& scope) const
         prefix += "template <typename TOpt = " + generator().scopeForOptions(common::defaultOptionsStr(), true, true) + ">";
     }
 
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "/// @brief Scope for all the member fields of\n"
         "///     @ref #^#CLASS_NAME#$# list.\n"
         "#^#EXTRA_PREFIX#$#\n"
         "struct #^#CLASS_NAME#$#Members\n"
         "{\n"
         "    #^#MEMBERS_DEF#$#\n"
-        "};\n";
+        "};\n");
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("CLASS_NAME", common::nameToClassCopy(name())));
     replacements.insert(std::make_pair("EXTRA_PREFIX", std::move(prefix)));
-    replacements.insert(std::make_pair("MEMBERS_DEF", common::listToString(defs, "\n", common::emptyString())));
-    return common::processTemplate(Templ, replacements);
+    replacements.insert(std::make_pair("MEMBERS_DEF", common::Fragment::join(defs, "\n")));
+    return Templ.render(replacements);
 }
 
 void ListField::checkFixedSizeOpt(ListField::StringsList& list) const
@@ -35,7 +35,7 @@ protected:
     virtual void updateIncludesCommonImpl(IncludesList& includes) const override;
     virtual void updatePluginIncludesImpl(IncludesList& includes) const override;
     virtual std::size_t maxLengthImpl() const override;
-    virtual std::string getClassDefinitionImpl(
+    virtual common::Fragment getClassDefinitionImpl(
         const std::string& scope,
         const std::string& className) const override;
     virtual std::string getExtraDefaultOptionsImpl(const std::string& scope) const override;
@@ -52,7 +52,7 @@ protected:
         const Field& field,
         const std::string& nameOverride,
         bool forcedVersionOptional) const override;
-    virtual std::string getPluginAnonNamespaceImpl(
+    virtual common::Fragment getPluginAnonNamespaceImpl(
         const std::string& scope,
         bool forcedSerialisedHidden,
         bool serHiddenParam) const override;
@@ -71,7 +71,7 @@ private:
 
     std::string getFieldOpts(const std::string& scope) const;
     std::string getElement() const;
-    std::string getMembersDef(const std::string& scope) const;
+    common::Fragment getMembersDef(const std::string& scope) const;
     void checkFixedSizeOpt(StringsList& list) const;
     void checkCountPrefixOpt(StringsList& list) const;
     void checkLengthPrefixOpt(StringsList& list) const;
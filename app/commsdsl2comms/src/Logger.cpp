@@ -21,6 +21,13 @@
 namespace commsdsl2comms
 {
 
+namespace
+{
+
+thread_local Logger::RecordsList* CapturedRecords = nullptr;
+
+} // namespace
+
 void Logger::log(commsdsl::ErrorLevel level, const std::string& msg)
 {
     if (level < m_minLevel) {
@@ -31,6 +38,28 @@ void Logger::log(commsdsl::ErrorLevel level, const std::string& msg)
         m_hadWarning = true;
     }
 
+    if (CapturedRecords != nullptr) {
+        CapturedRecords->emplace_back(level, msg);
+        return;
+    }
+
+    print(level, msg);
+}
+
+void Logger::captureThreadRecords(RecordsList* records)
+{
+    CapturedRecords = records;
+}
+
+void Logger::flush(const RecordsList& records)
+{
+    for (auto& r : records) {
+        print(r.first, r.second);
+    }
+}
+
+void Logger::print(commsdsl::ErrorLevel level, const std::string& msg)
+{
     static const std::string PrefixMap[] = {
         "[DEBUG]: ",
         "[INFO]: ",
@@ -50,6 +79,7 @@ void Logger::log(commsdsl::ErrorLevel level, const std::string& msg)
         stream = &std::cout;
     }
 
+    std::lock_guard<std::mutex> guard(m_printMutex);
     *stream << PrefixMap[level] << msg << std::endl;
 }
 
@@ -16,6 +16,10 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <utility>
+#include <mutex>
+#include <atomic>
 
 #include "commsdsl/ErrorLevel.h"
 
@@ -25,6 +29,9 @@ namespace commsdsl2comms
 class Logger
 {
 public:
+    using Record = std::pair<commsdsl::ErrorLevel, std::string>;
+    using RecordsList = std::vector<Record>;
+
     Logger() = default;
     Logger(const Logger&) = delete;
 
@@ -59,10 +66,18 @@ public:
         return m_hadWarning;
     }
 
+    // Records logged by the calling thread are accumulated in the provided
+    // list instead of being printed, nullptr resumes printing.
+    static void captureThreadRecords(RecordsList* records);
+    void flush(const RecordsList& records);
+
 private:
+    void print(commsdsl::ErrorLevel level, const std::string& msg);
+
     commsdsl::ErrorLevel m_minLevel = commsdsl::ErrorLevel_Info;
     bool m_warnAsErr = false;
-    bool m_hadWarning = false;
+    std::atomic<bool> m_hadWarning{false};
+    std::mutex m_printMutex;
 };
 
 } // namespace commsdsl2comms
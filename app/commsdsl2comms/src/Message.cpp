@@ -16,7 +16,6 @@
 #include "Message.h"
 
 #include <cassert>
-#include <fstream>
 #include <map>
 #include <algorithm>
 #include <iterator>
@@ -35,7 +34,7 @@ namespace commsdsl2comms
 namespace
 {
 
-const std::string Template(
+const common::CompiledTemplate Template(
     "#^#GEN_COMMENT#$#\n"
     "/// @file\n"
     "/// @brief Contains definition of <b>\"#^#MESSAGE_NAME#$#\"</b> message and its fields.\n"
@@ -97,7 +96,7 @@ const std::string Template(
     "#^#APPEND#$#\n"
 );
 
-static const std::string PluginSingleInterfacePimplHeaderTemplate(
+static const common::CompiledTemplate PluginSingleInterfacePimplHeaderTemplate(
     "#^#GEN_COMMENT#$#\n"
     "#pragma once\n\n"
     "#include <memory>\n"
@@ -133,7 +132,7 @@ static const std::string PluginSingleInterfacePimplHeaderTemplate(
     "#^#APPEND#$#\n"
 );
 
-static const std::string PluginSingleInterfaceHeaderTemplate(
+static const common::CompiledTemplate PluginSingleInterfaceHeaderTemplate(
     "#^#GEN_COMMENT#$#\n"
     "#pragma once\n\n"
     "#include <memory>\n"
@@ -162,7 +161,7 @@ static const std::string PluginSingleInterfaceHeaderTemplate(
     "#^#APPEND#$#\n"
 );
 
-static const std::string PluginMultiInterfaceHeaderTemplate(
+static const common::CompiledTemplate PluginMultiInterfaceHeaderTemplate(
     "#^#GEN_COMMENT#$#\n"
     "#pragma once\n\n"
     "#include <QtCore/QVariantList>\n"
@@ -190,7 +189,7 @@ static const std::string PluginMultiInterfaceHeaderTemplate(
     "#^#APPEND#$#\n"
 );
 
-static const std::string PluginSingleInterfacePimplSrcTemplate(
+static const common::CompiledTemplate PluginSingleInterfacePimplSrcTemplate(
     "#^#GEN_COMMENT#$#\n"
     "#include \"#^#CLASS_NAME#$#.h\"\n\n"
     "#include \"comms_champion/property/field.h\"\n"
@@ -293,7 +292,7 @@ static const std::string PluginSingleInterfacePimplSrcTemplate(
     "#^#APPEND#$#\n"
 );
 
-static const std::string PluginSingleInterfaceSrcTemplate(
+static const common::CompiledTemplate PluginSingleInterfaceSrcTemplate(
     "#^#GEN_COMMENT#$#\n"
     "#include \"#^#CLASS_NAME#$#.h\"\n\n"
     "#include \"comms_champion/property/field.h\"\n"
@@ -323,7 +322,7 @@ static const std::string PluginSingleInterfaceSrcTemplate(
     "#^#APPEND#$#\n"
 );
 
-static const std::string PluginMultiInterfaceSrcTemplate(
+static const common::CompiledTemplate PluginMultiInterfaceSrcTemplate(
     "#include \"#^#CLASS_NAME#$#.h\"\n\n"
     "#include \"comms_champion/property/field.h\"\n\n"
     "#^#INCLUDES#$#\n"
@@ -421,7 +420,7 @@ std::string Message::getClientOptions(const std::string& base) const
     replacements.insert(std::make_pair("MESSAGE_SCOPE", m_generator.scopeForMessage(m_externalRef, true, true)));
 
     if (m_dslObj.sender() == Sender::Client) {
-        static const std::string Templ = 
+        static const common::CompiledTemplate Templ(
             "/// @brief Extra options for\n"
             "///     @ref #^#MESSAGE_SCOPE#$# message.\n"
             "using #^#MESSAGE_NAME#$# =\n"
@@ -429,13 +428,13 @@ std::string Message::getClientOptions(const std::string& base) const
             "        comms::option::app::NoReadImpl,\n"
             "        comms::option::app::NoDispatchImpl,\n"
             "        typename #^#BASE#$#::#^#MESSAGE_NAME#$#\n"
-            "    >;\n";
+            "    >;\n");
 
-        return common::processTemplate(Templ, replacements);
+        return Templ.render(replacements);
     }
 
     assert(m_dslObj.sender() == Sender::Server);
-    static const std::string Templ = 
+    static const common::CompiledTemplate Templ(
         "/// @brief Extra options for\n"
         "///     @ref #^#MESSAGE_SCOPE#$# message.\n"
         "using #^#MESSAGE_NAME#$# =\n"
@@ -443,9 +442,9 @@ std::string Message::getClientOptions(const std::string& base) const
         "        comms::option::app::NoWriteImpl,\n"
         "        comms::option::app::NoRefreshImpl,\n"
         "        typename #^#BASE#$#::#^#MESSAGE_NAME#$#\n"
-        "    >;\n";
+        "    >;\n");
 
-    return common::processTemplate(Templ, replacements);
+    return Templ.render(replacements);
 }
 
 std::string Message::getServerOptions(const std::string& base) const
@@ -461,7 +460,7 @@ std::string Message::getServerOptions(const std::string& base) const
     replacements.insert(std::make_pair("MESSAGE_SCOPE", m_generator.scopeForMessage(m_externalRef, true, true)));
 
     if (m_dslObj.sender() == Sender::Client) {
-        static const std::string Templ = 
+        static const common::CompiledTemplate Templ(
             "/// @brief Extra options for\n"
             "///     @ref #^#MESSAGE_SCOPE#$# message.\n"
             "using #^#MESSAGE_NAME#$# =\n"
@@ -469,13 +468,13 @@ std::string Message::getServerOptions(const std::string& base) const
             "        comms::option::app::NoWriteImpl,\n"
             "        comms::option::app::NoRefreshImpl,\n"
             "        typename #^#BASE#$#::#^#MESSAGE_NAME#$#\n"
-            "    >;\n";        
+            "    >;\n");
 
-        return common::processTemplate(Templ, replacements);
+        return Templ.render(replacements);
     }
 
     assert(m_dslObj.sender() == Sender::Server);
-    static const std::string Templ = 
+    static const common::CompiledTemplate Templ(
         "/// @brief Extra options for\n"
         "///     @ref #^#MESSAGE_SCOPE#$# message.\n"
         "using #^#MESSAGE_NAME#$# =\n"
@@ -483,9 +482,9 @@ std::string Message::getServerOptions(const std::string& base) const
         "        comms::option::app::NoReadImpl,\n"
         "        comms::option::app::NoDispatchImpl,\n"
         "        typename #^#BASE#$#::#^#MESSAGE_NAME#$#\n"
-        "    >;\n";
+        "    >;\n");
 
-    return common::processTemplate(Templ, replacements);
+    return Templ.render(replacements);
 }
 
 std::string Message::getBareMetalDefaultOptions(const std::string& base) const
@@ -520,16 +519,16 @@ bool Message::writeProtocolDefinitionCommonFile()
 
     std::string fieldsCommon;
     if (!commonElems.empty()) {
-        static const std::string Templ =
+        static const common::CompiledTemplate Templ(
         "/// @brief Common types and functions for fields of \n"
         "///     @ref #^#SCOPE#$# message.\n"
         "/// @see #^#SCOPE#$#Fields\n"
         "struct #^#NAME#$#FieldsCommon\n"
         "{\n"
         "    #^#FIELDS_BODY#$#\n"
-        "};\n";
+        "};\n");
         repl.insert(std::make_pair("FIELDS_BODY", common::listToString(commonElems, "\n", common::emptyString())));
-        fieldsCommon = common::processTemplate(Templ, repl);
+        fieldsCommon = Templ.render(repl);
     }
 
     auto adjName = m_externalRef + common::commonSuffixStr();
@@ -542,7 +541,7 @@ bool Message::writeProtocolDefinitionCommonFile()
         return true;
     }
 
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "#^#GEN_COMMENT#$#\n"
         "/// @file\n"
         "/// @brief Contains common template parameters independent functionality of\n"
@@ -560,7 +559,7 @@ bool Message::writeProtocolDefinitionCommonFile()
         "{\n"
         "    #^#NAME_FUNC#$#\n"
         "};\n\n"
-        "#^#END_NAMESPACE#$#\n";
+        "#^#END_NAMESPACE#$#\n");
 
     auto namespaces = m_generator.namespacesForMessage(m_externalRef);
     repl.insert(std::make_pair("GEN_COMMENT", m_generator.fileGeneratedComment()));
@@ -570,21 +569,9 @@ bool Message::writeProtocolDefinitionCommonFile()
     repl.insert(std::make_pair("BEGIN_NAMESPACE", std::move(namespaces.first)));
     repl.insert(std::make_pair("END_NAMESPACE", std::move(namespaces.second)));
 
-    auto str = common::processTemplate(Templ, repl);
+    auto str = Templ.render(repl);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Message::writeProtocol()
@@ -600,7 +587,7 @@ bool Message::writeProtocol()
         return true;
     }
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("GEN_COMMENT", m_generator.fileGeneratedComment()));
     replacements.insert(std::make_pair("CLASS_NAME", className));
     replacements.insert(std::make_pair("ORIG_CLASS_NAME", common::nameToClassCopy(name())));
@@ -631,21 +618,9 @@ bool Message::writeProtocol()
         replacements.insert(std::make_pair("CUSTOMIZATION_OPT", std::move(opt)));
     }
 
-    auto str = common::processTemplate(Template, replacements);
+    auto str = Template.render(replacements);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Message::writePluginHeader()
@@ -685,21 +660,9 @@ bool Message::writePluginHeader()
         }
     }
 
-    auto str = common::processTemplate(*templ, replacements);
-
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
+    auto str = templ->render(replacements);
 
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Message::writePluginSrc()
@@ -715,7 +678,7 @@ bool Message::writePluginSrc()
         return true;
     }
 
-    common::StringsList fieldsProps;
+    common::FragmentsList fieldsProps;
     common::StringsList appends;
     common::StringsList includes;
     fieldsProps.reserve(m_fields.size());
@@ -727,11 +690,11 @@ bool Message::writePluginSrc()
         f->updatePluginIncludes(includes);
     }
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("GEN_COMMENT", m_generator.fileGeneratedComment()));
     replacements.insert(std::make_pair("CLASS_NAME", std::move(className)));
     replacements.insert(std::make_pair("PROT_MESSAGE", m_generator.scopeForMessage(m_externalRef, true, true)));
-    replacements.insert(std::make_pair("FIELDS_PROPS", common::listToString(fieldsProps, "\n", common::emptyString())));
+    replacements.insert(std::make_pair("FIELDS_PROPS", common::Fragment::join(fieldsProps, "\n")));
     replacements.insert(std::make_pair("PROPS_APPENDS", common::listToString(appends, "\n", common::emptyString())));
     replacements.insert(std::make_pair("MESSAGE_INC", m_generator.headerfileForMessage(m_externalRef, true)));
     replacements.insert(std::make_pair("INCLUDES", common::includesToStatements(includes)));
@@ -754,21 +717,9 @@ bool Message::writePluginSrc()
         }
     }
 
-    auto str = common::processTemplate(*templ, replacements);
-
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
+    auto contents = templ->render(replacements);
 
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, contents);
 }
 
 const std::string& Message::getDisplayName() const
@@ -855,7 +806,7 @@ std::string Message::getBody() const
 
 std::string Message::getPublic() const
 {
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "#^#ACCESS#$#\n"
         "#^#ALIASES#$#\n"
         "#^#LENGTH_CHECK#$#\n"
@@ -865,7 +816,7 @@ std::string Message::getPublic() const
         "#^#WRITE#$#\n"
         "#^#LENGTH#$#\n"
         "#^#VALID#$#\n"
-        "#^#REFRESH#$#\n";
+        "#^#REFRESH#$#\n");
     
     common::ReplacementMap replacements;
     replacements.insert(std::make_pair("ACCESS", getFieldsAccess()));
@@ -879,7 +830,7 @@ std::string Message::getPublic() const
     replacements.insert(std::make_pair("VALID", m_generator.getCustomValidForMessage(m_externalRef)));
     replacements.insert(std::make_pair("REFRESH", getRefreshFunc()));
 
-    return common::processTemplate(Templ, replacements);
+    return Templ.render(replacements);
 }
 
 std::string Message::getProtected() const
@@ -982,13 +933,13 @@ std::string Message::getAliases() const
             continue;
         }
 
-        static const std::string Templ =
+        static const common::CompiledTemplate Templ(
             "/// @brief Alias to a member field.\n"
             "/// @details\n"
             "#^#ALIAS_DESC#$#\n"
             "///     Generates field access alias function(s):\n"
             "///     @b field_#^#ALIAS_NAME#$#() -> <b>#^#ALIASED_FIELD_DOC#$#</b>\n"
-            "COMMS_MSG_FIELD_ALIAS(#^#ALIAS_NAME#$#, #^#ALIASED_FIELD#$#);\n";
+            "COMMS_MSG_FIELD_ALIAS(#^#ALIAS_NAME#$#, #^#ALIASED_FIELD#$#);\n");
 
         std::vector<std::string> aliasedFields;
         ba::split(aliasedFields, fieldName, ba::is_any_of("."));
@@ -1019,7 +970,7 @@ std::string Message::getAliases() const
         repl.insert(std::make_pair("ALIASED_FIELD_DOC", std::move(aliasedFieldDocStr)));
         repl.insert(std::make_pair("ALIASED_FIELD", std::move(aliasedFieldStr)));
         repl.insert(std::make_pair("ALIAS_DESC", std::move(desc)));
-        result.push_back(common::processTemplate(Templ, repl));
+        result.push_back(Templ.render(repl));
     }
 
     if (result.empty()) {
@@ -1064,22 +1015,20 @@ std::string Message::getLengthCheck() const
     return result;
 }
 
-std::string Message::getFieldsDef() const
+common::Fragment Message::getFieldsDef() const
 {
-    std::string result;
     auto scope =
         "TOpt::" +
         getNamespaceScope() +
         common::fieldsSuffixStr() +
         "::";
 
+    common::FragmentsList defs;
+    defs.reserve(m_fields.size());
     for (auto& f : m_fields) {
-        result += f->getClassDefinition(scope);
-        if (&f != &m_fields.back()) {
-            result += '\n';
-        }
+        defs.push_back(f->getClassDefinition(scope));
     }
-    return result;
+    return common::Fragment::join(defs, "\n");
 }
 
 std::string Message::getNamespaceScope() const
@@ -1214,17 +1163,17 @@ std::string Message::getOptions(GetFieldOptionsFunc func, const std::string& bas
         addFieldOptsFunc((f.get()->*func)(nextBase, scope));
     }
 
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "/// @brief Extra options for fields of\n"
         "///     @ref #^#MESSAGE_SCOPE#$# message.\n"
         "struct #^#MESSAGE_NAME#$#Fields#^#EXT#$#\n"
         "{\n"
         "    #^#FIELDS_OPTS#$#\n"
         "}; // struct #^#MESSAGE_NAME#$#Fields\n\n"
-        "#^#MESSAGE_OPT#$#\n";
+        "#^#MESSAGE_OPT#$#\n");
 
-    static const std::string NoFieldsTempl =
-        "#^#MESSAGE_OPT#$#\n";
+    static const common::CompiledTemplate NoFieldsTempl(
+        "#^#MESSAGE_OPT#$#\n");
 
     auto* templ = &Templ;
     if (m_fields.empty() || fieldsOpts.empty()) {
@@ -1243,14 +1192,14 @@ std::string Message::getOptions(GetFieldOptionsFunc func, const std::string& bas
     replacements.insert(std::make_pair("EXT", std::move(ext)));
 
     if (customizable) {
-        static const std::string OptTempl =
+        static const common::CompiledTemplate OptTempl(
             "/// @brief Extra options for\n"
             "///     @ref #^#MESSAGE_SCOPE#$# message.\n"
-            "using #^#MESSAGE_NAME#$# = comms::option::app::EmptyOption;";
-        replacements.insert(std::make_pair("MESSAGE_OPT", common::processTemplate(OptTempl, replacements)));
+            "using #^#MESSAGE_NAME#$# = comms::option::app::EmptyOption;");
+        replacements.insert(std::make_pair("MESSAGE_OPT", OptTempl.render(replacements)));
     }
 
-    return common::processTemplate(*templ, replacements);
+    return templ->render(replacements);
 }
 
 }
@@ -86,7 +86,7 @@ private:
     std::string getFieldsAccess() const;
     std::string getAliases() const;
     std::string getLengthCheck() const;
-    std::string getFieldsDef() const;
+    common::Fragment getFieldsDef() const;
     std::string getNamespaceScope() const;
     std::string getNameFunc() const;
     std::string getCommonNameFunc(const std::string& fullScope) const;
@@ -15,7 +15,6 @@
 
 #include "MsgId.h"
 
-#include <fstream>
 
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string.hpp>
@@ -67,12 +66,6 @@ bool MsgId::writeDefinition() const
         return true;
     }
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-
 
     common::ReplacementMap replacements;
     auto namespaces = m_generator.namespacesForRoot();
@@ -124,14 +117,7 @@ bool MsgId::writeDefinition() const
     replacements.insert(std::make_pair("TYPE", std::move(typeStr)));
 
     auto str = common::processTemplate(Template, replacements);
-    stream << str;
-
-    stream.flush();
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 } // namespace commsdsl2comms
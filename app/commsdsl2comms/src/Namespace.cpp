@@ -42,87 +42,89 @@ bool Namespace::prepare()
         prepareFrames();
 }
 
-bool Namespace::writeInterfaces()
+void Namespace::addInterfacesWriteJobs(WriteJobsList& jobs)
 {
-    return
-        std::all_of(
-            m_namespaces.begin(), m_namespaces.end(),
-            [](auto& ptr)
-            {
-                return ptr->writeInterfaces();
-            }) &&
-        std::all_of(
-            m_interfaces.begin(), m_interfaces.end(),
-            [](auto& ptr)
+    for (auto& n : m_namespaces) {
+        n->addInterfacesWriteJobs(jobs);
+    }
+
+    for (auto& i : m_interfaces) {
+        auto* iPtr = i.get();
+        jobs.push_back(
+            [iPtr]()
             {
-                return ptr->write();
+                return iPtr->write();
             });
+    }
 }
 
-bool Namespace::writeMessages()
+void Namespace::addMessagesWriteJobs(WriteJobsList& jobs)
 {
-    return
-        std::all_of(
-            m_namespaces.begin(), m_namespaces.end(),
-            [](auto& ptr)
-            {
-                return ptr->writeMessages();
-            }) &&
-        std::all_of(
-            m_messages.begin(), m_messages.end(),
-            [](auto& ptr)
+    for (auto& n : m_namespaces) {
+        n->addMessagesWriteJobs(jobs);
+    }
+
+    for (auto& m : m_messages) {
+        auto* mPtr = m.get();
+        jobs.push_back(
+            [mPtr]()
             {
-                return ptr->write();
+                return mPtr->write();
             });
+    }
 }
 
-bool Namespace::writeFrames()
+void Namespace::addFramesWriteJobs(WriteJobsList& jobs)
 {
-    return
-        std::all_of(
-            m_namespaces.begin(), m_namespaces.end(),
-            [](auto& ptr)
-            {
-                return ptr->writeFrames();
-            }) &&
-        std::all_of(
-            m_frames.begin(), m_frames.end(),
-            [](auto& ptr)
+    for (auto& n : m_namespaces) {
+        n->addFramesWriteJobs(jobs);
+    }
+
+    for (auto& f : m_frames) {
+        auto* fPtr = f.get();
+        jobs.push_back(
+            [fPtr]()
             {
-                return ptr->write();
-    });
+                return fPtr->write();
+            });
+    }
 }
 
-bool Namespace::writeFields()
+bool Namespace::writeFields(const WriteJobsRunner& runner)
 {
     for (auto& n : m_namespaces) {
-        if (!n->writeFields()) {
+        if (!n->writeFields(runner)) {
             return false;
         }
     }
 
     while (true) {
-        std::size_t writtenCount = 0U;
+        WriteJobsList jobs;
         for (auto& f : m_accessedFields) {
-            ++writtenCount;
             if (f.second) {
                 continue; // already written
             }
 
-            if (!f.first->writeFiles()) {
-                return false;
-            }
+            auto* fPtr = f.first;
+            jobs.push_back(
+                [fPtr]()
+                {
+                    return fPtr->writeFiles();
+                });
 
             f.second = true;
         }
 
-        if (m_accessedFields.size() <= writtenCount) {
+        if (jobs.empty()) {
             break; // everything has been written
         }
 
-        // new elements where introduced during writing
-    }
+        if (!runner(jobs)) {
+            return false;
+        }
 
+        // new elements could be introduced during writing
+    }
 
     return true;
 }
@@ -18,6 +18,8 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <functional>
+#include <vector>
 
 #include "commsdsl/Namespace.h"
 #include "Message.h"
@@ -42,6 +44,9 @@ public:
     using InterfacesAccessList = std::vector<const Interface*>;
     using FramesAccessList = std::vector<const Frame*>;
     using NamespacesScopesList = std::vector<std::string>;
+    using WriteJob = std::function<bool ()>;
+    using WriteJobsList = std::vector<WriteJob>;
+    using WriteJobsRunner = std::function<bool (const WriteJobsList&)>;
 
     //using FieldsMap = std::map<std::string, FieldPtr>;
     explicit Namespace(Generator& gen, const commsdsl::Namespace& dslObj)
@@ -54,10 +59,10 @@ public:
 
     bool prepare();
 
-    bool writeInterfaces();
-    bool writeMessages();
-    bool writeFrames();
-    bool writeFields();
+    void addInterfacesWriteJobs(WriteJobsList& jobs);
+    void addMessagesWriteJobs(WriteJobsList& jobs);
+    void addFramesWriteJobs(WriteJobsList& jobs);
+    bool writeFields(const WriteJobsRunner& runner);
 
     std::string getDefaultOptions(const std::string& base) const;
     std::string getClientOptions(const std::string& base) const;
@@ -90,7 +95,15 @@ private:
 
     using MessagesList = std::vector<MessagePtr>;
     using FramesList = std::vector<FramePtr>;
-    using AccessedFields = std::map<const Field*, bool>;
+    struct AccessedFieldComp
+    {
+        bool operator()(const Field* f1, const Field* f2) const
+        {
+            return f1->name() < f2->name();
+        }
+    };
+
+    using AccessedFields = std::map<const Field*, bool, AccessedFieldComp>;
 
     bool prepareNamespaces();
     bool prepareFields();
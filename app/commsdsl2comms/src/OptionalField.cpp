@@ -30,14 +30,14 @@ namespace commsdsl2comms
 namespace
 {
 
-const std::string MembersDefTemplate =
+const common::CompiledTemplate MembersDefTemplate(
     "/// @brief Scope for all the member fields of\n"
     "///     @ref #^#CLASS_NAME#$# optional.\n"
     "#^#EXTRA_PREFIX#$#\n"
     "struct #^#CLASS_NAME#$#Members\n"
     "{\n"
     "    #^#FIELD_DEF#$#\n"
-    "};\n";
+    "};\n");
 
 const std::string MembersOptionsTemplate =
     "/// @brief Extra options for all the member fields of\n"
@@ -47,7 +47,7 @@ const std::string MembersOptionsTemplate =
     "    #^#OPTIONS#$#\n"
     "};\n";
 
-const std::string ClassTemplate(
+const common::CompiledTemplate ClassTemplate(
     "#^#MEMBERS_STRUCT_DEF#$#\n"
     "#^#PREFIX#$#"
     "class #^#CLASS_NAME#$# : public\n"
@@ -74,7 +74,7 @@ const std::string ClassTemplate(
     "};\n"
 );
 
-const std::string StructTemplate(
+const common::CompiledTemplate StructTemplate(
     "#^#MEMBERS_STRUCT_DEF#$#\n"
     "#^#PREFIX#$#"
     "struct #^#CLASS_NAME#$# : public\n"
@@ -87,7 +87,7 @@ const std::string StructTemplate(
     "};\n"
 );
 
-bool shouldUseStruct(const common::ReplacementMap& replacements)
+bool shouldUseStruct(const common::FragmentsMap& replacements)
 {
     auto hasNoValue =
         [&replacements](const std::string& val)
@@ -179,7 +179,7 @@ std::size_t OptionalField::maxLengthImpl() const
     return fieldPtr->maxLength();
 }
 
-std::string OptionalField::getClassDefinitionImpl(
+common::Fragment OptionalField::getClassDefinitionImpl(
     const std::string& scope,
     const std::string& className) const
 {
@@ -193,7 +193,7 @@ std::string OptionalField::getClassDefinitionImpl(
         }
     }
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("PREFIX", getClassPrefix(className)));
     replacements.insert(std::make_pair("CLASS_NAME", className));
     replacements.insert(std::make_pair("PROT_NAMESPACE", generator().mainNamespace()));
@@ -207,7 +207,7 @@ std::string OptionalField::getClassDefinitionImpl(
     replacements.insert(std::make_pair("FIELD_REF", getFieldRef()));
     replacements.insert(std::make_pair("MEMBERS_STRUCT_DEF", getMembersDef(scope)));
     if (!replacements["FIELD_OPTS"].empty()) {
-        replacements["COMMA"] = ',';
+        replacements["COMMA"] = ",";
     }
 
     if (!externalRef().empty()) {
@@ -218,7 +218,7 @@ std::string OptionalField::getClassDefinitionImpl(
     if (shouldUseStruct(replacements)) {
         templ = &StructTemplate;
     }
-    return common::processTemplate(*templ, replacements);
+    return templ->render(replacements);
 }
 
 std::string OptionalField::getExtraDefaultOptionsImpl(const std::string& scope) const
@@ -236,7 +236,7 @@ std::string OptionalField::getExtraDataViewDefaultOptionsImpl(const std::string&
     return getExtraOptions(scope, &Field::getDataViewDefaultOptions, base);
 }
 
-std::string OptionalField::getPluginAnonNamespaceImpl(
+common::Fragment OptionalField::getPluginAnonNamespaceImpl(
     const std::string& scope,
     bool forcedSerialisedHidden,
     bool serHiddenParam) const
@@ -253,16 +253,16 @@ std::string OptionalField::getPluginAnonNamespaceImpl(
 
     auto prop = m_field->getPluginCreatePropsFunc(fullScope, forcedSerialisedHidden, serHiddenParam);
 
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "struct #^#CLASS_NAME#$#Members\n"
         "{\n"
         "    #^#PROP#$#\n"
-        "};\n";
+        "};\n");
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("CLASS_NAME", common::nameToClassCopy(name())));
     replacements.insert(std::make_pair("PROP", std::move(prop)));
-    return common::processTemplate(Templ, replacements);
+    return Templ.render(replacements);
 }
 
 std::string OptionalField::getPluginPropertiesImpl(bool serHiddenParam) const
@@ -427,14 +427,14 @@ std::string OptionalField::getFieldOpts(const std::string& scope) const
     return common::listToString(options, ",\n", common::emptyString());
 }
 
-std::string OptionalField::getMembersDef(const std::string& scope) const
+common::Fragment OptionalField::getMembersDef(const std::string& scope) const
 {
     if (!m_field) {
         return common::emptyString();
     }
 
     std::string memberScope = scope + common::nameToClassCopy(name()) + common::membersSuffixStr() + "::";
-    std::string fieldDef = m_field->getClassDefinition(memberScope);
+    auto fieldDef = m_field->getClassDefinition(memberScope);
 
     std::string prefix;
     if (!externalRef().empty()) {
@@ -442,11 +442,11 @@ std::string OptionalField::getMembersDef(const std::string& scope) const
         prefix += "template <typename TOpt = " + generator().scopeForOptions(common::defaultOptionsStr(), true, true) + ">";
     }
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("CLASS_NAME", common::nameToClassCopy(name())));
     replacements.insert(std::make_pair("EXTRA_PREFIX", std::move(prefix)));
     replacements.insert(std::make_pair("FIELD_DEF", std::move(fieldDef)));
-    return common::processTemplate(MembersDefTemplate, replacements);
+    return MembersDefTemplate.render(replacements);
 
 }
 
@@ -39,13 +39,13 @@ protected:
     virtual void updateIncludesCommonImpl(IncludesList& includes) const override;
     virtual void updatePluginIncludesImpl(IncludesList& includes) const override;
     virtual std::size_t maxLengthImpl() const override;
-    virtual std::string getClassDefinitionImpl(
+    virtual common::Fragment getClassDefinitionImpl(
         const std::string& scope,
         const std::string& className) const override;
     virtual std::string getExtraDefaultOptionsImpl(const std::string& scope) const override;
     virtual std::string getExtraBareMetalDefaultOptionsImpl(const std::string& base, const std::string& scope) const override;
     virtual std::string getExtraDataViewDefaultOptionsImpl(const std::string& base, const std::string& scope) const override;
-    virtual std::string getPluginAnonNamespaceImpl(
+    virtual common::Fragment getPluginAnonNamespaceImpl(
         const std::string& scope,
         bool forcedSerialisedHidden,
         bool serHiddenParam) const override;
@@ -62,7 +62,7 @@ private:
     using GetExtraOptionsFunc = std::string (Field::*)(const std::string& base, const std::string& scope) const;
 
     std::string getFieldOpts(const std::string& scope) const;
-    std::string getMembersDef(const std::string& scope) const;
+    common::Fragment getMembersDef(const std::string& scope) const;
     std::string getFieldRef() const;
     void checkModeOpt(StringsList& options) const;
     std::string getExtraOptions(const std::string& scope, GetExtraOptionsFunc func, const std::string& base) const;
@@ -0,0 +1,230 @@
+//
+// Copyright 2019 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "OutputManifest.h"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+namespace bf = boost::filesystem;
+
+namespace commsdsl2comms
+{
+
+namespace
+{
+
+const std::string ManifestFileName(".commsdsl2comms.manifest");
+
+std::uint64_t contentsHash(const std::string& contents)
+{
+    // FNV-1a, must remain stable between runs and platforms
+    std::uint64_t result = 0xcbf29ce484222325ULL;
+    for (auto ch : contents) {
+        result ^= static_cast<std::uint8_t>(ch);
+        result *= 0x100000001b3ULL;
+    }
+    return result;
+}
+
+bool fileStatus(const std::string& filePath, std::uintmax_t& size, std::time_t& modifTime)
+{
+    boost::system::error_code ec;
+    size = bf::file_size(filePath, ec);
+    if (ec) {
+        return false;
+    }
+
+    modifTime = bf::last_write_time(filePath, ec);
+    return !ec;
+}
+
+} // namespace
+
+void OutputManifest::load(const boost::filesystem::path& outputDir)
+{
+    m_outputDir = outputDir;
+    m_prevRecords.clear();
+    m_records.clear();
+
+    // Only the files listed in the manifest are ever removed, the output
+    // of the versions that didn't write it is not recognised.
+    std::ifstream stream((m_outputDir / ManifestFileName).string());
+    std::string line;
+    while (std::getline(stream, line)) {
+        std::istringstream lineStream(line);
+        FileRecord record;
+        long long modifTime = 0;
+        lineStream >> std::hex >> record.m_hash >> std::dec >> record.m_size >> modifTime;
+        if (!lineStream) {
+            continue;
+        }
+
+        std::string path;
+        std::getline(lineStream >> std::ws, path);
+        if (path.empty()) {
+            continue;
+        }
+
+        record.m_modifTime = static_cast<std::time_t>(modifTime);
+        m_prevRecords[path] = record;
+    }
+}
+
+bool OutputManifest::write(const std::string& filePath, const std::string& contents)
+{
+    auto relPath = relativePath(filePath);
+    FileRecord record;
+    record.m_hash = contentsHash(contents);
+    FileRecord prevRecord;
+    bool recorded = false;
+    bool added = false;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        auto prevIter = m_prevRecords.find(relPath);
+        added = (prevIter == m_prevRecords.end());
+        recorded = (!added) && (m_records.find(relPath) == m_records.end());
+        if (recorded) {
+            prevRecord = prevIter->second;
+        }
+        m_records[relPath] = record;
+    }
+
+    if (recorded && isUnchanged(filePath, record.m_hash, prevRecord)) {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_records[relPath] = prevRecord;
+        ++m_unchangedCount;
+        return true;
+    }
+
+    std::ofstream stream(filePath, std::ios_base::binary | std::ios_base::trunc);
+    if (!stream) {
+        m_logger.error("Failed to open \"" + filePath + "\" for writing.");
+        return false;
+    }
+    stream << contents;
+    stream.close();
+
+    if (!stream) {
+        m_logger.error("Failed to write \"" + filePath + "\".");
+        return false;
+    }
+
+    fileStatus(filePath, record.m_size, record.m_modifTime);
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_records[relPath] = record;
+    if (added) {
+        ++m_addedCount;
+    }
+    else {
+        ++m_changedCount;
+    }
+    return true;
+}
+
+bool OutputManifest::finalise()
+{
+    auto removedCount = removeStale();
+
+    auto manifestPath = (m_outputDir / ManifestFileName).string();
+    std::ofstream stream(manifestPath, std::ios_base::trunc);
+    if (!stream) {
+        m_logger.error("Failed to open \"" + manifestPath + "\" for writing.");
+        return false;
+    }
+
+    stream << std::setfill('0');
+    for (auto& r : m_records) {
+        stream <<
+            std::hex << std::setw(16) << r.second.m_hash << ' ' <<
+            std::dec << std::setw(0) << r.second.m_size << ' ' <<
+            static_cast<long long>(r.second.m_modifTime) << ' ' <<
+            r.first << '\n';
+    }
+    stream.flush();
+
+    if (!stream.good()) {
+        m_logger.error("Failed to write \"" + manifestPath + "\".");
+        return false;
+    }
+
+    m_logger.info(
+        "Output files: " + std::to_string(m_addedCount) + " added, " +
+        std::to_string(m_changedCount) + " changed, " +
+        std::to_string(removedCount) + " removed, " +
+        std::to_string(m_unchangedCount) + " unchanged.");
+    return true;
+}
+
+std::string OutputManifest::relativePath(const std::string& filePath) const
+{
+    auto dirStr = m_outputDir.string();
+    if ((dirStr.empty()) || (filePath.compare(0, dirStr.size(), dirStr) != 0)) {
+        return filePath;
+    }
+
+    auto pos = dirStr.size();
+    while ((pos < filePath.size()) && (filePath[pos] == bf::path::preferred_separator)) {
+        ++pos;
+    }
+
+    return std::string(filePath, pos);
+}
+
+bool OutputManifest::isUnchanged(const std::string& filePath, std::uint64_t hash, const FileRecord& prevRecord)
+{
+    if (prevRecord.m_hash != hash) {
+        return false;
+    }
+
+    // The recorded hash is trusted only while the file on disk hasn't been
+    // touched since it was written, a modified file is written again.
+    std::uintmax_t size = 0U;
+    std::time_t modifTime = 0;
+    return
+        fileStatus(filePath, size, modifTime) &&
+        (size == prevRecord.m_size) &&
+        (modifTime == prevRecord.m_modifTime);
+}
+
+std::size_t OutputManifest::removeStale()
+{
+    std::size_t result = 0U;
+    for (auto& p : m_prevRecords) {
+        if (m_records.find(p.first) != m_records.end()) {
+            continue;
+        }
+
+        auto path = m_outputDir / p.first;
+        boost::system::error_code ec;
+        if (!bf::exists(path, ec)) {
+            continue;
+        }
+
+        m_logger.info("Removing stale " + path.string());
+        bf::remove(path, ec);
+        if (ec) {
+            m_logger.warning("Failed to remove \"" + path.string() + "\": " + ec.message());
+            continue;
+        }
+
+        ++result;
+    }
+    return result;
+}
+
+} // namespace commsdsl2comms
@@ -0,0 +1,65 @@
+//
+// Copyright 2019 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <map>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+#include <ctime>
+
+#include <boost/filesystem.hpp>
+
+#include "Logger.h"
+
+namespace commsdsl2comms
+{
+
+class OutputManifest
+{
+public:
+    explicit OutputManifest(Logger& logger) : m_logger(logger) {}
+
+    void load(const boost::filesystem::path& outputDir);
+    bool write(const std::string& filePath, const std::string& contents);
+    bool finalise();
+
+private:
+    struct FileRecord
+    {
+        std::uint64_t m_hash = 0U;
+        std::uintmax_t m_size = 0U;
+        std::time_t m_modifTime = 0;
+    };
+
+    using RecordsMap = std::map<std::string, FileRecord>;
+
+    std::string relativePath(const std::string& filePath) const;
+    static bool isUnchanged(const std::string& filePath, std::uint64_t hash, const FileRecord& prevRecord);
+    std::size_t removeStale();
+
+    Logger& m_logger;
+    boost::filesystem::path m_outputDir;
+    RecordsMap m_prevRecords;
+    RecordsMap m_records;
+    std::size_t m_addedCount = 0U;
+    std::size_t m_changedCount = 0U;
+    std::size_t m_unchangedCount = 0U;
+    std::mutex m_mutex;
+};
+
+} // namespace commsdsl2comms
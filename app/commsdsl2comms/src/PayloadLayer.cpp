@@ -31,7 +31,7 @@ void PayloadLayer::updateIncludesImpl(Layer::IncludesList& includes) const
     common::mergeIncludes(List, includes);
 }
 
-std::string PayloadLayer::getClassDefinitionImpl(
+common::Fragment PayloadLayer::getClassDefinitionImpl(
     const std::string& scope,
     std::string& prevLayer,
     bool& hasInputMessages) const
@@ -41,18 +41,18 @@ std::string PayloadLayer::getClassDefinitionImpl(
     assert(prevLayer.empty());
     prevLayer = common::nameToClassCopy(name());
 
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "#^#PREFIX#$#\n"
         "using #^#CLASS_NAME#$# =\n"
         "    comms::protocol::MsgDataLayer<\n"
         "        #^#EXTRA_OPT#$#\n"
-        "    >;\n";
+        "    >;\n");
     
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("PREFIX", getPrefix()));
     replacements.insert(std::make_pair("CLASS_NAME", common::nameToClassCopy(name())));
     replacements.insert(std::make_pair("EXTRA_OPT", getExtraOpt(scope)));
-    return common::processTemplate(Templ, replacements);
+    return Templ.render(replacements);
 }
 
 std::string PayloadLayer::getBareMetalOptionStrImpl(const std::string& base) const
@@ -16,7 +16,6 @@
 #include "Plugin.h"
 
 #include <cassert>
-#include <fstream>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
@@ -142,19 +141,7 @@ bool Plugin::writeProtocolHeader()
 
     std::string str = common::processTemplate(Templ, replacements);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Plugin::writeProtocolSrc()
@@ -388,19 +375,7 @@ bool Plugin::writeProtocolSrc()
 
     std::string str = common::processTemplate(Templ, replacements);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Plugin::writePluginHeader()
@@ -455,19 +430,7 @@ bool Plugin::writePluginHeader()
 
     std::string str = common::processTemplate(Templ, replacements);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Plugin::writePluginSrc()
@@ -539,19 +502,7 @@ bool Plugin::writePluginSrc()
 
     std::string str = common::processTemplate(Templ, replacements);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Plugin::writePluginJson()
@@ -583,19 +534,7 @@ bool Plugin::writePluginJson()
 
     std::string str = common::processTemplate(Templ, replacements);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Plugin::writePluginConfig()
@@ -618,19 +557,7 @@ bool Plugin::writePluginConfig()
     replacements.insert(std::make_pair("ID", pluginId()));
     std::string str = common::processTemplate(Templ, replacements);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Plugin::writeVersionConfigWidgetHeader()
@@ -685,19 +612,7 @@ bool Plugin::writeVersionConfigWidgetHeader()
 
     std::string str = common::processTemplate(Templ, replacements);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 bool Plugin::writeVersionConfigWidgetSrc()
@@ -765,19 +680,7 @@ bool Plugin::writeVersionConfigWidgetSrc()
 
     std::string str = common::processTemplate(Templ, replacements);
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-    stream << str;
-
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 std::string Plugin::protClassName() const
@@ -61,6 +61,11 @@ const std::string CustomizationStr("customization");
 const std::string GeneratedPluginBuildEnableStr("enable-plugin-build-by-default");
 const std::string GeneratedTestsBuildEnableStr("enable-tests-build-by-default");
 const std::string ExtraMessagesBundleStr("extra-messages-bundle");
+const std::string CacheFileStr("cache-file");
+const std::string StreamParseStr("stream-parse");
+const std::string StatsStr("stats");
+const std::string JobsStr("jobs");
+const std::string FullJobsStr(JobsStr + ",j");
 
 po::options_description createDescription()
 {
@@ -117,6 +122,23 @@ po::options_description createDescription()
             "as defined in the CommsDSL. In case the message resides in a namespace its name must be "
             "specified in the same way as being referenced in CommsDSL (\'Namespace.MessageName\'). This "
             "option can be used multiple times for multiple definitions of such bundles.")
+        (CacheFileStr.c_str(), po::value<std::string>()->default_value(std::string()),
+            "Path to the binary cache of the processed schema. The cache is used instead of "
+            "parsing the schema files when none of them have changed, otherwise it is re-created. "
+            "Empty means no cache.")
+        (StreamParseStr.c_str(),
+            "Read the schema files in streaming mode to reduce memory consumption when "
+            "processing very large schemas. The properties of the \"schema\" element "
+            "must precede all the definitions.")
+        (StatsStr.c_str(),
+            "Print the statistics of the schema parsing and validation: parse time of every file, "
+            "time of every validation phase, elements counts, reused and cloned fields, "
+            "references resolution counts and peak memory of the schema object model.")
+        (FullJobsStr.c_str(), po::value<unsigned>()->default_value(1U),
+            "Number of threads used to parse the schema files, validate the messages and to generate "
+            "the files of interfaces, messages, frames and fields. "
+            "0 means number of available hardware threads. The log output order does not depend on "
+            "this value.")
     ;
     return desc;
 }
@@ -200,6 +222,16 @@ bool ProgramOptions::versionIndependentCodeRequested() const
     return 0 < m_vm.count(VersionIndependentCodeStr);
 }
 
+bool ProgramOptions::streamParseRequested() const
+{
+    return 0 < m_vm.count(StreamParseStr);
+}
+
+bool ProgramOptions::statsRequested() const
+{
+    return 0 < m_vm.count(StatsStr);
+}
+
 bool ProgramOptions::pluginBuildEnabledByDefault() const
 {
     return m_vm[GeneratedPluginBuildEnableStr].as<bool>();
@@ -231,6 +263,11 @@ std::vector<std::string> ProgramOptions::getFiles() const
     return inputs;
 }
 
+std::string ProgramOptions::getCacheFile() const
+{
+    return m_vm[CacheFileStr].as<std::string>();
+}
+
 std::string ProgramOptions::getOutputDirectory() const
 {
     return m_vm[OutputDirStr].as<std::string>();
@@ -270,6 +307,11 @@ unsigned ProgramOptions::getMinRemoteVersion() const
     return m_vm[MinRemoteVerStr].as<unsigned>();
 }
 
+unsigned ProgramOptions::getJobs() const
+{
+    return m_vm[JobsStr].as<unsigned>();
+}
+
 std::string ProgramOptions::getCommsChampionTag() const
 {
     return m_vm[CommsChampionTagStr].as<std::string>();
@@ -34,12 +34,15 @@ public:
     bool versionRequested() const;
     bool warnAsErrRequested() const;
     bool versionIndependentCodeRequested() const;
+    bool streamParseRequested() const;
+    bool statsRequested() const;
     bool pluginBuildEnabledByDefault() const;
     bool testsBuildEnabledByDefault() const;
 
     std::string getFilesListFile() const;
     std::string getFilesListPrefix() const;
     std::vector<std::string> getFiles() const;
+    std::string getCacheFile() const;
     std::string getOutputDirectory() const;
     std::vector<std::string> getCodeInputDirectories() const;
     bool hasNamespaceOverride() const;
@@ -47,6 +50,7 @@ public:
     bool hasForcedSchemaVersion() const;
     unsigned getForcedSchemaVersion() const;
     unsigned getMinRemoteVersion() const;
+    unsigned getJobs() const;
     std::string getCommsChampionTag() const;
     std::vector<std::string> getPlugins() const;
     std::string getCustomizationLevel() const;
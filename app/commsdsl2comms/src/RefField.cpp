@@ -175,7 +175,7 @@ std::size_t RefField::maxLengthImpl() const
     return fieldPtr->maxLength();
 }
 
-std::string RefField::getClassDefinitionImpl(
+common::Fragment RefField::getClassDefinitionImpl(
     const std::string& scope,
     const std::string& className) const
 {
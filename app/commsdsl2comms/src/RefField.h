@@ -36,7 +36,7 @@ protected:
     virtual void updatePluginIncludesImpl(IncludesList& includes) const override;
     virtual std::size_t minLengthImpl() const override;
     virtual std::size_t maxLengthImpl() const override;
-    virtual std::string getClassDefinitionImpl(
+    virtual common::Fragment getClassDefinitionImpl(
         const std::string& scope,
         const std::string& className) const override;
     virtual std::string getCompareToValueImpl(
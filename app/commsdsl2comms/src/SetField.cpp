@@ -83,7 +83,7 @@ void SetField::updateIncludesCommonImpl(IncludesList& includes) const
     common::mergeIncludes(List, includes);
 }
 
-std::string SetField::getClassDefinitionImpl(
+common::Fragment SetField::getClassDefinitionImpl(
     const std::string& scope,
     const std::string& className) const
 {
@@ -32,12 +32,12 @@ void SizeLayer::updateIncludesImpl(Layer::IncludesList& includes) const
     common::mergeIncludes(List, includes);
 }
 
-std::string SizeLayer::getClassDefinitionImpl(
+common::Fragment SizeLayer::getClassDefinitionImpl(
     const std::string& scope,
     std::string& prevLayer,
     bool& hasInputMessages) const
 {
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "#^#FIELD_DEF#$#\n"
         "#^#PREFIX#$#\n"
         "#^#TEMPL_PARAM#$#\n"
@@ -45,9 +45,9 @@ std::string SizeLayer::getClassDefinitionImpl(
         "    comms::protocol::MsgSizeLayer<\n"
         "        #^#FIELD_TYPE#$#,\n"
         "        #^#PREV_LAYER#$#\n"
-        "    >;\n";
+        "    >;\n");
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("FIELD_DEF", getFieldDefinition(scope)));
     replacements.insert(std::make_pair("PREFIX", getPrefix()));
     replacements.insert(std::make_pair("FIELD_TYPE", getFieldType()));
@@ -57,11 +57,11 @@ std::string SizeLayer::getClassDefinitionImpl(
         static const std::string TemplParam =
             "template <typename TMessage, typename TAllMessages>";
         replacements.insert(std::make_pair("TEMPL_PARAM", TemplParam));
-        replacements["PREV_LAYER"] += "<TMessage, TAllMessages>";
+        replacements["PREV_LAYER"] = prevLayer + "<TMessage, TAllMessages>";
     }
 
     prevLayer = common::nameToClassCopy(name());
-    return common::processTemplate(Templ, replacements);
+    return Templ.render(replacements);
 }
 
 } // namespace commsdsl2comms
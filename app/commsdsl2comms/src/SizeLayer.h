@@ -31,7 +31,7 @@ public:
 
 protected:
     virtual void updateIncludesImpl(IncludesList& includes) const override;
-    virtual std::string getClassDefinitionImpl(
+    virtual common::Fragment getClassDefinitionImpl(
         const std::string& scope,
         std::string& prevLayer,
         bool& hasInputMessages) const override;
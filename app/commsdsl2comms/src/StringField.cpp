@@ -30,7 +30,7 @@ namespace commsdsl2comms
 namespace
 {
 
-const std::string ClassTemplate(
+const common::CompiledTemplate ClassTemplate(
     "#^#PREFIX_FIELD#$#\n"
     "#^#PREFIX#$#"
     "class #^#CLASS_NAME#$# : public\n"
@@ -58,7 +58,7 @@ const std::string ClassTemplate(
     "};\n"
 );
 
-const std::string StructTemplate(
+const common::CompiledTemplate StructTemplate(
     "#^#PREFIX_FIELD#$#\n"
     "#^#PREFIX#$#"
     "struct #^#CLASS_NAME#$# : public\n"
@@ -71,7 +71,7 @@ const std::string StructTemplate(
     "};\n"
 );
 
-bool shouldUseStruct(const common::ReplacementMap& replacements)
+bool shouldUseStruct(const common::FragmentsMap& replacements)
 {
     auto hasNoValue =
         [&replacements](const std::string& val)
@@ -164,11 +164,11 @@ std::size_t StringField::maxLengthImpl() const
     return common::maxPossibleLength();
 }
 
-std::string StringField::getClassDefinitionImpl(
+common::Fragment StringField::getClassDefinitionImpl(
     const std::string& scope,
     const std::string& className) const
 {
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("PREFIX", getClassPrefix(className)));
     replacements.insert(std::make_pair("CLASS_NAME", className));
     replacements.insert(std::make_pair("PROT_NAMESPACE", generator().mainNamespace()));
@@ -188,11 +188,11 @@ std::string StringField::getClassDefinitionImpl(
         replacements.insert(std::make_pair("COMMA", ","));
     }
 
-    const std::string* templPtr = &ClassTemplate;
+    const common::CompiledTemplate* templPtr = &ClassTemplate;
     if (shouldUseStruct(replacements)) {
         templPtr = &StructTemplate;
     }
-    return common::processTemplate(*templPtr, replacements);
+    return templPtr->render(replacements);
 }
 
 std::string StringField::getExtraDefaultOptionsImpl(const std::string& scope) const
@@ -519,7 +519,7 @@ std::string StringField::getConstructor(const std::string& className) const
     return common::processTemplate(Templ, replacements);
 }
 
-std::string StringField::getPrefixField(const std::string& scope) const
+common::Fragment StringField::getPrefixField(const std::string& scope) const
 {
     if (!m_prefix) {
         return common::emptyString();
@@ -536,20 +536,20 @@ std::string StringField::getPrefixField(const std::string& scope) const
         prefix += "template <typename TOpt = " + generator().scopeForOptions(common::defaultOptionsStr(), true, true) + ">";
     }
 
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "/// @brief Scope for all the member fields of\n"
         "///     @ref #^#CLASS_NAME#$# string.\n"
         "#^#EXTRA_PREFIX#$#\n"
         "struct #^#CLASS_NAME#$#Members\n"
         "{\n"
         "    #^#FIELD_DEF#$#\n"
-        "};\n";
+        "};\n");
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("CLASS_NAME", common::nameToClassCopy(name())));
     replacements.insert(std::make_pair("EXTRA_PREFIX", std::move(prefix)));
     replacements.insert(std::make_pair("FIELD_DEF", std::move(fieldDef)));
-    return common::processTemplate(Templ, replacements);
+    return Templ.render(replacements);
 }
 
 void StringField::checkFixedLengthOpt(StringField::StringsList& list) const
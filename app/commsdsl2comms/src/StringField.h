@@ -34,7 +34,7 @@ protected:
     virtual void updateIncludesImpl(IncludesList& includes) const override;
     virtual void updateIncludesCommonImpl(IncludesList& includes) const override;
     virtual std::size_t maxLengthImpl() const override;
-    virtual std::string getClassDefinitionImpl(
+    virtual common::Fragment getClassDefinitionImpl(
         const std::string& scope,
         const std::string& className) const override;
     virtual std::string getExtraDefaultOptionsImpl(const std::string& scope) const override;
@@ -64,7 +64,7 @@ private:
 
     std::string getFieldOpts(const std::string& scope) const;
     std::string getConstructor(const std::string& className) const;
-    std::string getPrefixField(const std::string& scope) const;
+    common::Fragment getPrefixField(const std::string& scope) const;
     void checkFixedLengthOpt(StringsList& list) const;
     void checkPrefixOpt(StringsList& list) const;
     void checkSuffixOpt(StringsList& list) const;
@@ -32,7 +32,7 @@ public:
 protected:
     virtual bool prepareImpl() override;
     virtual void updateIncludesImpl(IncludesList& includes) const override;
-    virtual std::string getClassDefinitionImpl(
+    virtual common::Fragment getClassDefinitionImpl(
         const std::string& scope,
         std::string& prevLayer,
         bool& hasInputMessages) const override;
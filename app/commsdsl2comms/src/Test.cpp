@@ -15,7 +15,6 @@
 
 #include "Test.h"
 
-#include <fstream>
 
 #include <boost/filesystem.hpp>
 
@@ -51,12 +50,6 @@ bool Test::writeInputTest() const
     std::string filePathStr(filePath.string());
 
     m_generator.logger().info("Generating " + filePathStr);
-    std::ofstream stream(filePathStr);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePathStr + "\" for writing.");
-        return false;
-    }
-
     common::ReplacementMap replacements;
     replacements.insert(std::make_pair("GEN_COMMENT", m_generator.fileGeneratedComment()));
     
@@ -428,15 +421,7 @@ bool Test::writeInputTest() const
         "}\n\n";
 
     auto str = common::processTemplate(Template, replacements);
-    stream << str;
-
-    stream.flush();
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePathStr + "\".");
-        return false;
-    }
-
-    return true;
+    return m_generator.writeOutputFile(filePathStr, str);
 }
 
 } // namespace commsdsl2comms
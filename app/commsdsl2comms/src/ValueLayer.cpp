@@ -43,12 +43,12 @@ void ValueLayer::updateIncludesImpl(Layer::IncludesList& includes) const
     common::mergeInclude(generator().headerfileForInput(common::allMessagesStr(), false), includes);
 }
 
-std::string ValueLayer::getClassDefinitionImpl(
+common::Fragment ValueLayer::getClassDefinitionImpl(
     const std::string& scope,
     std::string& prevLayer,
     bool& hasInputMessages) const
 {
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "#^#FIELD_DEF#$#\n"
         "#^#PREFIX#$#\n"
         "#^#TEMPL_PARAM#$#\n"
@@ -58,10 +58,10 @@ std::string ValueLayer::getClassDefinitionImpl(
         "        #^#INTERFACE_FIELD_IDX#$#,\n"
         "        #^#PREV_LAYER#$##^#COMMA#$#\n"
         "        #^#EXTRA_OPT#$#\n"
-        "    >;\n";
+        "    >;\n");
     
     auto obj = valueLayerDslObj();
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("FIELD_DEF", getFieldDefinition(scope)));
     replacements.insert(std::make_pair("PREFIX", getPrefix()));
     replacements.insert(std::make_pair("FIELD_TYPE", getFieldType()));
@@ -73,7 +73,7 @@ std::string ValueLayer::getClassDefinitionImpl(
         static const std::string TemplParam =
             "template <typename TMessage, typename TAllMessages>";
         replacements.insert(std::make_pair("TEMPL_PARAM", TemplParam));
-        replacements["PREV_LAYER"] += "<TMessage, TAllMessages>";
+        replacements["PREV_LAYER"] = prevLayer + "<TMessage, TAllMessages>";
     }
 
     if (obj.pseudo()) {
@@ -82,7 +82,7 @@ std::string ValueLayer::getClassDefinitionImpl(
     }
 
     prevLayer = common::nameToClassCopy(name());
-    return common::processTemplate(Templ, replacements);
+    return Templ.render(replacements);
 }
 
 bool ValueLayer::isPseudoVersionLayerImpl(const std::vector<std::string>& interfaceVersionFields) const
@@ -35,7 +35,7 @@ namespace
 
 constexpr std::size_t MaxMembersSupportedByComms = 120;
 
-const std::string MembersDefTemplate =
+const common::CompiledTemplate MembersDefTemplate(
     "/// @brief Scope for all the member fields of\n"
     "///     @ref #^#CLASS_NAME#$# bitfield.\n"
     "#^#EXTRA_PREFIX#$#\n"
@@ -47,7 +47,7 @@ const std::string MembersDefTemplate =
     "        std::tuple<\n"
     "           #^#MEMBERS#$#\n"
     "        >;\n"
-    "};\n";
+    "};\n");
 
 const std::string MembersOptionsTemplate =
     "/// @brief Extra options for all the member fields of\n"
@@ -57,7 +57,7 @@ const std::string MembersOptionsTemplate =
     "    #^#OPTIONS#$#\n"
     "};\n";
 
-const std::string ClassTemplate(
+const common::CompiledTemplate ClassTemplate(
     "#^#MEMBERS_STRUCT_DEF#$#\n"
     "#^#PREFIX#$#"
     "class #^#CLASS_NAME#$# : public\n"
@@ -170,11 +170,11 @@ std::size_t VariantField::maxLengthImpl() const
             });
 }
 
-std::string VariantField::getClassDefinitionImpl(
+common::Fragment VariantField::getClassDefinitionImpl(
     const std::string& scope,
     const std::string& className) const
 {
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("PREFIX", getClassPrefix(className)));
     replacements.insert(std::make_pair("CLASS_NAME", className));
     replacements.insert(std::make_pair("ORIG_CLASS_NAME", common::nameToClassCopy(name())));
@@ -193,14 +193,14 @@ std::string VariantField::getClassDefinitionImpl(
     replacements.insert(std::make_pair("PUBLIC", getExtraPublic()));
     replacements.insert(std::make_pair("PROTECTED", getFullProtected()));
     if (!replacements["FIELD_OPTS"].empty()) {
-        replacements["COMMA"] = ',';
+        replacements["COMMA"] = ",";
     }
 
     if (!externalRef().empty()) {
         replacements.insert(std::make_pair("MEMBERS_OPT", "<TOpt>"));
     }
 
-    return common::processTemplate(ClassTemplate, replacements);
+    return ClassTemplate.render(replacements);
 }
 
 std::string VariantField::getExtraDefaultOptionsImpl(const std::string& scope) const
@@ -218,7 +218,7 @@ std::string VariantField::getExtraDataViewDefaultOptionsImpl(const std::string&
     return getExtraOptions(scope, &Field::getDataViewDefaultOptions, base);
 }
 
-std::string VariantField::getPluginAnonNamespaceImpl(
+common::Fragment VariantField::getPluginAnonNamespaceImpl(
     const std::string& scope,
     bool forcedSerialisedHidden,
     bool serHiddenParam) const
@@ -229,21 +229,21 @@ std::string VariantField::getPluginAnonNamespaceImpl(
     }
     fullScope += "::";
 
-    common::StringsList props;
+    common::FragmentsList props;
     for (auto& f : m_members) {
         props.push_back(f->getPluginCreatePropsFunc(fullScope, forcedSerialisedHidden, serHiddenParam));
     }
 
-    static const std::string Templ =
+    static const common::CompiledTemplate Templ(
         "struct #^#CLASS_NAME#$#Members\n"
         "{\n"
         "    #^#PROPS#$#\n"
-        "};\n";
+        "};\n");
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("CLASS_NAME", common::nameToClassCopy(name())));
-    replacements.insert(std::make_pair("PROPS", common::listToString(props, "\n", common::emptyString())));
-    return common::processTemplate(Templ, replacements);
+    replacements.insert(std::make_pair("PROPS", common::Fragment::join(props, "\n")));
+    return Templ.render(replacements);
 }
 
 std::string VariantField::getPluginPropertiesImpl(bool serHiddenParam) const
@@ -380,14 +380,14 @@ std::string VariantField::getFieldOpts(const std::string& scope) const
     return common::listToString(options, ",\n", common::emptyString());
 }
 
-std::string VariantField::getMembersDef(const std::string& scope) const
+common::Fragment VariantField::getMembersDef(const std::string& scope) const
 {
     auto className = common::nameToClassCopy(name());
     std::string memberScope;
     if (!scope.empty()) {
         memberScope = scope + className + common::membersSuffixStr() + "::";
     }
-    StringsList membersDefs;
+    common::FragmentsList membersDefs;
     StringsList membersNames;
 
     membersDefs.reserve(m_members.size());
@@ -403,12 +403,12 @@ std::string VariantField::getMembersDef(const std::string& scope) const
         prefix += "template <typename TOpt = " + generator().scopeForOptions(common::defaultOptionsStr(), true, true) + ">";
     }
 
-    common::ReplacementMap replacements;
+    common::FragmentsMap replacements;
     replacements.insert(std::make_pair("CLASS_NAME", className));
     replacements.insert(std::make_pair("EXTRA_PREFIX", std::move(prefix)));
-    replacements.insert(std::make_pair("MEMBERS_DEFS", common::listToString(membersDefs, "\n", common::emptyString())));
+    replacements.insert(std::make_pair("MEMBERS_DEFS", common::Fragment::join(membersDefs, "\n")));
     replacements.insert(std::make_pair("MEMBERS", common::listToString(membersNames, ",\n", common::emptyString())));
-    return common::processTemplate(MembersDefTemplate, replacements);
+    return MembersDefTemplate.render(replacements);
 
 }
 
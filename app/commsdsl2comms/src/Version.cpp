@@ -15,7 +15,6 @@
 
 #include "Version.h"
 
-#include <fstream>
 #include <vector>
 
 #include <boost/filesystem.hpp>
@@ -83,12 +82,6 @@ bool Version::writeDefinition() const
         return true;
     }
 
-    std::ofstream stream(filePath);
-    if (!stream) {
-        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
-        return false;
-    }
-
     auto versionHeaderFileName = 
         common::nameToClassCopy(common::versionStr()) + common::headerSuffix();
         
@@ -143,14 +136,7 @@ bool Version::writeDefinition() const
         "#^#APPEND#$#\n"
     );
     auto str = common::processTemplate(Template, replacements);
-    stream << str;
-
-    stream.flush();
-    if (!stream.good()) {
-        m_generator.logger().error("Failed to write \"" + filePath + "\".");
-        return false;
-    }
-    return true;
+    return m_generator.writeOutputFile(filePath, str);
 }
 
 
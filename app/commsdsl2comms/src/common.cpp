@@ -38,8 +38,117 @@ namespace
 
 const std::size_t MaxPossibleLength = std::numeric_limits<std::size_t>::max();
 
+// Placement of a single "#^#KEY#$#" slot within the template.
+struct TemplateSlot
+{
+    std::size_t m_prefixPos = 0U;
+    std::size_t m_keyPos = 0U;
+    std::size_t m_keyLen = 0U;
+    std::size_t m_afterSuffixPos = 0U;
+    std::size_t m_lineStartPos = 0U;
+    std::size_t m_nextLinePos = 0U;
+    bool m_removableLine = false; // only spaces around the slot on its line
+    bool m_lineEndMissing = false; // no new line after the slot on blank line
+};
+
+// Finds all the slots of the template in order and reports them to the
+// provided callback. Returns false if the template is malformed, the
+// text after the last reported slot must be ignored in such case.
+template <typename TFunc>
+bool scanTemplate(const std::string& templ, TFunc&& func)
+{
+    static const std::string Prefix("#^#");
+    static const std::string Suffix("#$#");
+    static const std::string WhiteSpaces(" \t\r");
+
+    std::size_t templPos = 0U;
+    while (templPos < templ.size()) {
+        auto prefixPos = templ.find(Prefix, templPos);
+        if (prefixPos == std::string::npos) {
+            break;
+        }
+
+        auto suffixPos = templ.find(Suffix, prefixPos + Prefix.size());
+        if (suffixPos == std::string::npos) {
+            static constexpr bool Incorrect_template = false;
+            static_cast<void>(Incorrect_template);
+            assert(Incorrect_template);
+            return false;
+        }
+
+        TemplateSlot slot;
+        slot.m_prefixPos = prefixPos;
+        slot.m_keyPos = prefixPos + Prefix.size();
+        slot.m_keyLen = suffixPos - slot.m_keyPos;
+        slot.m_afterSuffixPos = suffixPos + Suffix.size();
+
+        std::size_t lastNewLinePos = templ.find_last_of('\n', prefixPos);
+        if (lastNewLinePos != std::string::npos) {
+            slot.m_lineStartPos = lastNewLinePos + 1U;
+        }
+
+        assert(slot.m_lineStartPos <= prefixPos);
+
+        do {
+            if (templ.find_first_not_of(WhiteSpaces, slot.m_lineStartPos) < prefixPos) {
+                break;
+            }
+
+            auto nextNewLinePos = templ.find_first_of('\n', slot.m_afterSuffixPos);
+            if (nextNewLinePos == std::string::npos) {
+                slot.m_lineEndMissing = true;
+                break;
+            }
+
+            if (templ.find_first_not_of(WhiteSpaces, slot.m_afterSuffixPos) < nextNewLinePos) {
+                break;
+            }
+
+            slot.m_removableLine = true;
+            slot.m_nextLinePos = nextNewLinePos + 1U;
+        } while (false);
+
+        func(slot);
+        templPos = slot.m_afterSuffixPos;
+    }
+
+    return true;
+}
+
+void appendIndented(std::string& out, const std::string& value, std::size_t indent)
+{
+    if (indent == 0U) {
+        out += value;
+        return;
+    }
+
+    std::size_t pos = 0U;
+    while (pos < value.size()) {
+        auto nlPos = value.find('\n', pos);
+        if (nlPos == std::string::npos) {
+            out.append(value, pos, std::string::npos);
+            break;
+        }
+
+        out.append(value, pos, nlPos + 1U - pos);
+        out.append(indent, ' ');
+        pos = nlPos + 1U;
+    }
 }
 
+void checkEmptySlot(bool lineEndMissing)
+{
+    // The empty slot on a blank line is expected to be followed by
+    // the new line character.
+    if (lineEndMissing) {
+        static constexpr bool Incorrect_template = false;
+        static_cast<void>(Incorrect_template);
+        assert(Incorrect_template);
+    }
+}
+
+} // namespace
+
 const std::string& emptyString()
 {
     static const std::string Str;
@@ -546,97 +655,256 @@ std::string processTemplate(const std::string& templ, const ReplacementMap& repl
     std::string result;
     result.reserve(templ.size() * 2U);
     std::size_t templPos = 0U;
-    while (templPos < templ.size()) {
-        static const std::string Prefix("#^#");
-        auto prefixPos = templ.find(Prefix, templPos);
-        if (prefixPos == std::string::npos) {
-            break;
-        }
+    bool valid =
+        scanTemplate(
+            templ,
+            [&templ, &repl, &result, &templPos](const TemplateSlot& slot)
+            {
+                const std::string* valuePtr = &emptyString();
+                auto iter = repl.find(std::string(templ, slot.m_keyPos, slot.m_keyLen));
+                if (iter != repl.end()) {
+                    valuePtr = &(iter->second);
+                }
+                auto& value = *valuePtr;
+
+                if (value.empty()) {
+                    checkEmptySlot(slot.m_lineEndMissing);
+                }
+
+                if (value.empty() && slot.m_removableLine) {
+                    result.append(templ, templPos, slot.m_lineStartPos - templPos);
+                    templPos = slot.m_nextLinePos;
+                    return;
+                }
+
+                result.append(templ, templPos, slot.m_prefixPos - templPos);
+                templPos = slot.m_afterSuffixPos;
+                appendIndented(result, value, slot.m_prefixPos - slot.m_lineStartPos);
+            });
+
+    if (valid && (templPos < templ.size())) {
+        result.append(templ, templPos, std::string::npos);
+    }
+    return result;
+}
 
-        static const std::string Suffix("#$#");
-        auto suffixPos = templ.find(Suffix, prefixPos + Prefix.size());
-        if (suffixPos == std::string::npos) {
-            static constexpr bool Incorrect_template = false;
-            static_cast<void>(Incorrect_template);
-            assert(Incorrect_template);            
-            templPos = templ.size();
-            break;
+Fragment::Fragment(std::string str)
+  : m_text(std::move(str)),
+    m_size(m_text.size()),
+    m_newLines(static_cast<std::size_t>(std::count(m_text.begin(), m_text.end(), '\n')))
+{
+}
+
+Fragment::Fragment(const char* str)
+  : Fragment(std::string(str))
+{
+}
+
+void Fragment::append(Fragment frag, std::size_t indent)
+{
+    if (frag.empty()) {
+        return;
+    }
+
+    m_size += frag.m_size + (frag.m_newLines * indent);
+    m_newLines += frag.m_newLines;
+
+    if (m_parts.empty() && frag.m_parts.empty() && (indent == 0U)) {
+        m_text += frag.m_text;
+        return;
+    }
+
+    Part part;
+    part.m_frag = std::make_shared<Fragment>(std::move(frag));
+    part.m_indent = indent;
+    m_parts.push_back(std::move(part));
+}
+
+void Fragment::flatten(std::string& out) const
+{
+    out.reserve(out.size() + m_size);
+    flattenImpl(out, 0U);
+}
+
+std::string Fragment::str() const
+{
+    std::string result;
+    flatten(result);
+    return result;
+}
+
+Fragment Fragment::join(const std::vector<Fragment>& list, const std::string& sep)
+{
+    Fragment result;
+    for (auto& f : list) {
+        if (&f != &list.front()) {
+            result.append(sep);
         }
-        auto afterSuffixPos = suffixPos + Suffix.size();
+        result.append(f);
+    }
+    return result;
+}
+
+void Fragment::flattenImpl(std::string& out, std::size_t indent) const
+{
+    appendIndented(out, m_text, indent);
+    for (auto& p : m_parts) {
+        p.m_frag->flattenImpl(out, indent + p.m_indent);
+    }
+}
+
+CompiledTemplate::CompiledTemplate(const std::string& templ)
+{
+    std::size_t templPos = 0U;
+    bool valid =
+        scanTemplate(
+            templ,
+            [this, &templ, &templPos](const TemplateSlot& slot)
+            {
+                Segment seg;
+                seg.m_literal.assign(templ, templPos, slot.m_prefixPos - templPos);
+
+                std::string key(templ, slot.m_keyPos, slot.m_keyLen);
+                seg.m_slotIdx = slotIdx(key);
+                if (m_keys.size() <= seg.m_slotIdx) {
+                    m_keys.push_back(std::move(key));
+                }
+
+                seg.m_indent = slot.m_prefixPos - slot.m_lineStartPos;
+                seg.m_lineEndMissing = slot.m_lineEndMissing;
+
+                // The whole line is removed when the slot is the only non-space
+                // content of it and its value is empty.
+                if (slot.m_removableLine) {
+                    assert(templPos <= slot.m_lineStartPos);
+                    seg.m_removableLine = true;
+                    seg.m_lineCut = seg.m_indent;
+                    seg.m_tailSkip = slot.m_nextLinePos - slot.m_afterSuffixPos;
+                }
+
+                m_literalsSize += seg.m_literal.size();
+                m_segments.push_back(std::move(seg));
+                templPos = slot.m_afterSuffixPos;
+            });
+
+    if (valid && (templPos < templ.size())) {
+        m_tail.assign(templ, templPos, std::string::npos);
+        m_literalsSize += m_tail.size();
+    }
+}
+
+std::size_t CompiledTemplate::slotIdx(const std::string& key) const
+{
+    auto iter = std::find(m_keys.begin(), m_keys.end(), key);
+    return static_cast<std::size_t>(std::distance(m_keys.begin(), iter));
+}
+
+void CompiledTemplate::render(const Values& values, std::string& out) const
+{
+    ValuePtrsList valuePtrs(m_keys.size(), &emptyString());
+    auto count = std::min(values.size(), valuePtrs.size());
+    for (auto idx = 0U; idx < count; ++idx) {
+        valuePtrs[idx] = &values[idx];
+    }
+
+    renderImpl(valuePtrs, out);
+}
 
-        std::string key(templ.begin() + prefixPos + Prefix.size(), templ.begin() + suffixPos);
-        const std::string* valuePtr = &emptyString();
-        auto iter = repl.find(key);
+std::string CompiledTemplate::render(const ReplacementMap& repl) const
+{
+    ValuePtrsList valuePtrs(m_keys.size(), &emptyString());
+    for (auto idx = 0U; idx < m_keys.size(); ++idx) {
+        auto iter = repl.find(m_keys[idx]);
         if (iter != repl.end()) {
-            valuePtr = &(iter->second);
+            valuePtrs[idx] = &iter->second;
         }
-        auto& value = *valuePtr;
+    }
 
-        std::size_t lineStartPos = 0U;
-        std::size_t lastNewLinePos = templ.find_last_of('\n', prefixPos);
-        if (lastNewLinePos != std::string::npos) {
-            lineStartPos = lastNewLinePos + 1U;
+    std::string result;
+    renderImpl(valuePtrs, result);
+    return result;
+}
+
+Fragment CompiledTemplate::render(const FragmentsMap& repl) const
+{
+    static const Fragment EmptyFragment;
+    std::vector<const Fragment*> valuePtrs(m_keys.size(), &EmptyFragment);
+    for (auto idx = 0U; idx < m_keys.size(); ++idx) {
+        auto iter = repl.find(m_keys[idx]);
+        if (iter != repl.end()) {
+            valuePtrs[idx] = &iter->second;
         }
+    }
 
-        assert(lineStartPos <= prefixPos);
-        auto indent = prefixPos - lineStartPos;
+    Fragment result;
+    std::size_t skip = 0U;
+    auto appendLiteral =
+        [&result, &skip](const std::string& literal, std::size_t cut)
+        {
+            assert(skip + cut <= literal.size());
+            result.append(std::string(literal, skip, literal.size() - skip - cut));
+            skip = 0U;
+        };
 
-        // Check empty row
-        std::size_t posToCopyUntil = prefixPos;
-        std::size_t nextTemplPos = afterSuffixPos;
-        do {
-            if (!value.empty()) {
-                break;
-            }
+    for (auto& seg : m_segments) {
+        assert(seg.m_slotIdx < valuePtrs.size());
+        auto& value = *valuePtrs[seg.m_slotIdx];
 
-            static const std::string WhiteSpaces(" \t\r");
-            std::string preStr(templ.begin() + lineStartPos, templ.begin() + prefixPos);
-            if ((!preStr.empty()) &&
-                (preStr.find_first_not_of(WhiteSpaces) != std::string::npos)) {
-                break;
+        if (value.empty()) {
+            checkEmptySlot(seg.m_lineEndMissing);
+            if (!seg.m_removableLine) {
+                appendLiteral(seg.m_literal, 0U);
+                continue;
             }
 
-            auto nextNewLinePos = templ.find_first_of('\n', suffixPos + Suffix.size());
-            if (nextNewLinePos == std::string::npos) {
-                static constexpr bool Incorrect_template = false;
-                static_cast<void>(Incorrect_template);
-                assert(Incorrect_template);  
-                break;
-            }
+            appendLiteral(seg.m_literal, seg.m_lineCut);
+            skip = seg.m_tailSkip;
+            continue;
+        }
 
-            std::string postStr(templ.begin() + afterSuffixPos, templ.begin() + nextNewLinePos);
-            if ((!postStr.empty()) &&
-                (postStr.find_first_not_of(WhiteSpaces) != std::string::npos)) {
-                break;
-            }
+        appendLiteral(seg.m_literal, 0U);
+        result.append(value, seg.m_indent);
+    }
 
-            posToCopyUntil = lineStartPos;
-            nextTemplPos = nextNewLinePos + 1;
-        } while (false);
+    appendLiteral(m_tail, 0U);
+    return result;
+}
 
-        result.insert(result.end(), templ.begin() + templPos, templ.begin() + posToCopyUntil);
-        templPos = nextTemplPos;
+void CompiledTemplate::renderImpl(const ValuePtrsList& valuePtrs, std::string& out) const
+{
+    out.clear();
+    out.reserve(m_literalsSize * 2U);
+
+    std::size_t skip = 0U;
+    auto appendLiteral =
+        [&out, &skip](const std::string& literal, std::size_t cut)
+        {
+            assert(skip + cut <= literal.size());
+            out.append(literal, skip, literal.size() - skip - cut);
+            skip = 0U;
+        };
+
+    for (auto& seg : m_segments) {
+        assert(seg.m_slotIdx < valuePtrs.size());
+        auto& value = *valuePtrs[seg.m_slotIdx];
 
         if (value.empty()) {
-            continue;
-        }
+            checkEmptySlot(seg.m_lineEndMissing);
+            if (!seg.m_removableLine) {
+                appendLiteral(seg.m_literal, 0U);
+                continue;
+            }
 
-        if (indent == 0U) {
-            result += value;
+            appendLiteral(seg.m_literal, seg.m_lineCut);
+            skip = seg.m_tailSkip;
             continue;
         }
 
-        std::string repSep("\n");
-        repSep.reserve(repSep.size() + indent);
-        std::fill_n(std::back_inserter(repSep), indent, ' ');
-        auto updatedValue = ba::replace_all_copy(value, "\n", repSep);
-        result += updatedValue;
+        appendLiteral(seg.m_literal, 0U);
+        appendIndented(out, value, seg.m_indent);
     }
 
-    if (templPos < templ.size()) {
-        result.insert(result.end(), templ.begin() + templPos, templ.end());
-    }
-    return result;
+    appendLiteral(m_tail, 0U);
 }
 
 void mergeIncludes(const StringsList& from, StringsList& to)
@@ -19,6 +19,7 @@
 #include <map>
 #include <cstdint>
 #include <vector>
+#include <memory>
 
 #include "commsdsl/Endian.h"
 #include "commsdsl/Units.h"
@@ -107,6 +108,90 @@ std::string insertIndentCopy(const std::string& str);
 using ReplacementMap = std::map<std::string, std::string>;
 std::string processTemplate(const std::string& templ, const ReplacementMap& repl);
 
+// Piece of generated code composed of other pieces, each with its own
+// indentation relative to the containing one. The indentation is applied
+// only once when the whole tree is flattened into a string, which avoids
+// copying and re-indenting the nested code on every nesting level.
+class Fragment
+{
+public:
+    Fragment() = default;
+    Fragment(std::string str);
+    Fragment(const char* str);
+
+    bool empty() const
+    {
+        return m_size == 0U;
+    }
+
+    void append(Fragment frag, std::size_t indent = 0U);
+    void flatten(std::string& out) const;
+    std::string str() const;
+
+    static Fragment join(const std::vector<Fragment>& list, const std::string& sep);
+
+private:
+    struct Part
+    {
+        std::shared_ptr<const Fragment> m_frag;
+        std::size_t m_indent = 0U;
+    };
+
+    void flattenImpl(std::string& out, std::size_t indent) const;
+
+    std::string m_text;
+    std::vector<Part> m_parts;
+    std::size_t m_size = 0U;
+    std::size_t m_newLines = 0U;
+};
+
+using FragmentsList = std::vector<Fragment>;
+using FragmentsMap = std::map<std::string, Fragment>;
+
+// Template split once into literal and slot segments, to be used for
+// the templates rendered many times. The output is the same as of
+// processTemplate().
+class CompiledTemplate
+{
+public:
+    using Values = std::vector<std::string>;
+
+    explicit CompiledTemplate(const std::string& templ);
+
+    std::size_t slotsCount() const
+    {
+        return m_keys.size();
+    }
+
+    std::size_t slotIdx(const std::string& key) const;
+
+    void render(const Values& values, std::string& out) const;
+    std::string render(const ReplacementMap& repl) const;
+    Fragment render(const FragmentsMap& repl) const;
+
+private:
+    struct Segment
+    {
+        std::string m_literal;
+        std::size_t m_slotIdx = 0U;
+        std::size_t m_indent = 0U;
+        std::size_t m_lineCut = 0U;
+        std::size_t m_tailSkip = 0U;
+        bool m_removableLine = false;
+        bool m_lineEndMissing = false;
+    };
+
+    using SegmentsList = std::vector<Segment>;
+    using ValuePtrsList = std::vector<const std::string*>;
+
+    void renderImpl(const ValuePtrsList& valuePtrs, std::string& out) const;
+
+    SegmentsList m_segments;
+    std::string m_tail;
+    std::vector<std::string> m_keys;
+    std::size_t m_literalsSize = 0U;
+};
+
 using StringsList = std::vector<std::string>;
 void mergeIncludes(const StringsList& from, StringsList& to);
 void mergeInclude(const std::string& inc, StringsList& to);
@@ -17,6 +17,7 @@
 
 #include "Protocol.h"
 #include "IntField.h"
+#include "FlatMap.h"
 
 namespace commsdsl
 {
@@ -37,8 +38,8 @@ public:
     };
 
     using Type = IntField::Type;
-    using Values = std::map<std::string, ValueInfo>;
-    using RevValues = std::multimap<std::intmax_t, std::string>;
+    using Values = FlatMap<std::string, ValueInfo>;
+    using RevValues = FlatMap<std::intmax_t, std::string>;
 
     explicit EnumField(const EnumFieldImpl* impl);
     explicit EnumField(Field field);
@@ -0,0 +1,140 @@
+//
+// Copyright 2018 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace commsdsl
+{
+
+// Sorted contiguous storage with the lookup interface of std::multimap,
+// elements with equal keys are kept in the order of their insertion.
+template <typename TKey, typename TValue, typename TCompare = std::less<TKey> >
+class FlatMap
+{
+public:
+    using key_type = TKey;
+    using mapped_type = TValue;
+    using value_type = std::pair<TKey, TValue>;
+    using key_compare = TCompare;
+    using size_type = std::size_t;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+    using iterator = const_iterator;
+    using Range = std::pair<const_iterator, const_iterator>;
+
+    const_iterator begin() const
+    {
+        return m_data.begin();
+    }
+
+    const_iterator end() const
+    {
+        return m_data.end();
+    }
+
+    const_iterator cbegin() const
+    {
+        return m_data.cbegin();
+    }
+
+    const_iterator cend() const
+    {
+        return m_data.cend();
+    }
+
+    size_type size() const
+    {
+        return m_data.size();
+    }
+
+    bool empty() const
+    {
+        return m_data.empty();
+    }
+
+    const_iterator lower_bound(const TKey& key) const
+    {
+        return
+            std::lower_bound(
+                m_data.begin(), m_data.end(), key,
+                [](const value_type& elem, const TKey& k)
+                {
+                    return TCompare()(elem.first, k);
+                });
+    }
+
+    const_iterator upper_bound(const TKey& key) const
+    {
+        return
+            std::upper_bound(
+                m_data.begin(), m_data.end(), key,
+                [](const TKey& k, const value_type& elem)
+                {
+                    return TCompare()(k, elem.first);
+                });
+    }
+
+    Range equal_range(const TKey& key) const
+    {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+    }
+
+    const_iterator find(const TKey& key) const
+    {
+        auto iter = lower_bound(key);
+        if ((iter == m_data.end()) || TCompare()(key, iter->first)) {
+            return m_data.end();
+        }
+
+        return iter;
+    }
+
+    size_type count(const TKey& key) const
+    {
+        auto range = equal_range(key);
+        return static_cast<size_type>(std::distance(range.first, range.second));
+    }
+
+    void reserve(size_type count)
+    {
+        m_data.reserve(count);
+    }
+
+    // Appends without keeping the order, sort() must follow before any lookup
+    void append(TKey key, TValue value)
+    {
+        m_data.emplace_back(std::move(key), std::move(value));
+    }
+
+    void sort()
+    {
+        std::stable_sort(
+            m_data.begin(), m_data.end(),
+            [](const value_type& elem1, const value_type& elem2)
+            {
+                return TCompare()(elem1.first, elem2.first);
+            });
+    }
+
+private:
+    std::vector<value_type> m_data;
+};
+
+} // namespace commsdsl
@@ -40,7 +40,7 @@ public:
     bool valid() const;
     const std::string& name() const;
     const std::string& description() const;
-    LayersList layers() const;
+    const LayersList& layers() const;
     std::string externalRef() const;
 
     const AttributesMap& extraAttributes() const;
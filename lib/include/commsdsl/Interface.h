@@ -42,8 +42,8 @@ public:
     bool valid() const;
     const std::string& name() const;
     const std::string& description() const;
-    FieldsList fields() const;
-    AliasesList aliases() const;
+    const FieldsList& fields() const;
+    const AliasesList& aliases() const;
     std::string externalRef() const;
 
     const AttributesMap& extraAttributes() const;
@@ -60,8 +60,8 @@ public:
     unsigned sinceVersion() const;
     unsigned deprecatedSince() const;
     bool isDeprecatedRemoved() const;
-    FieldsList fields() const;
-    AliasesList aliases() const;
+    const FieldsList& fields() const;
+    const AliasesList& aliases() const;
     std::string externalRef() const;
     bool isCustomizable() const;
     Sender sender() const;
@@ -47,11 +47,11 @@ public:
     bool valid() const;
     const std::string& name() const;
     const std::string& description() const;
-    NamespacesList namespaces() const;
-    FieldsList fields() const;
-    MessagesList messages() const;
-    InterfacesList interfaces() const;
-    FramesList frames() const;
+    const NamespacesList& namespaces() const;
+    const FieldsList& fields() const;
+    const MessagesList& messages() const;
+    const InterfacesList& interfaces() const;
+    const FramesList& frames() const;
     std::string externalRef() const;
 
     const AttributesMap& extraAttributes() const;
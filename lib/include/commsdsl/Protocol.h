@@ -15,11 +15,15 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <functional>
 #include <vector>
 #include <limits>
+#include <utility>
+#include <array>
 
 #include "CommsdslApi.h"
 #include "ErrorLevel.h"
@@ -37,18 +41,103 @@ public:
     using ErrorReportFunction = std::function<void (ErrorLevel, const std::string&)>;
     using NamespacesList = std::vector<Namespace>;
     using MessagesList = Namespace::MessagesList;
+    using MessageIdsList = std::vector<std::uintmax_t>;
+    using MessagesRange = std::pair<MessagesList::const_iterator, MessagesList::const_iterator>;
     using PlatformsList = Message::PlatformsList;
+    using FilesList = std::vector<std::string>;
+
+    enum class ElementKind
+    {
+        Field,
+        Message,
+        Interface,
+        Frame,
+        NumOfValues
+    };
+
+    enum class DependencyKind
+    {
+        Reuse,
+        Ref,
+        Field,
+        Element,
+        LengthPrefix,
+        CountPrefix,
+        ElemLengthPrefix,
+        CopyFieldsFrom,
+        Interface,
+        Value,
+        NumOfValues
+    };
+
+    struct ElementInfo
+    {
+        ElementKind m_kind = ElementKind::NumOfValues;
+        std::string m_externalRef;
+    };
+
+    struct DependencyInfo
+    {
+        DependencyKind m_kind = DependencyKind::NumOfValues;
+        ElementInfo m_element;
+    };
+
+    using ElementsList = std::vector<ElementInfo>;
+    using DependenciesList = std::vector<DependencyInfo>;
+
+    struct FileStats
+    {
+        std::string m_file;
+        std::uint64_t m_parseTimeUs = 0U;
+    };
+
+    struct PhaseStats
+    {
+        std::string m_name;
+        std::uint64_t m_timeUs = 0U;
+    };
+
+    using FileStatsList = std::vector<FileStats>;
+    using PhaseStatsList = std::vector<PhaseStats>;
+    using ElementsCounts = std::array<std::size_t, static_cast<std::size_t>(ElementKind::NumOfValues)>;
+    using FieldsCounts = std::array<std::size_t, static_cast<std::size_t>(Field::Kind::NumOfValues)>;
+
+    struct Stats
+    {
+        FileStatsList m_files;
+        PhaseStatsList m_phases;
+        std::size_t m_namespacesCount = 0U;
+        ElementsCounts m_elementsCount = {};
+        std::size_t m_layersCount = 0U;
+        FieldsCounts m_createdFieldsCount = {};
+        std::size_t m_reusedFieldsCount = 0U;
+        std::size_t m_clonedFieldsCount = 0U;
+        std::size_t m_reuseBytes = 0U;
+        std::size_t m_refLookupsCount = 0U;
+        std::size_t m_failedRefLookupsCount = 0U;
+        std::size_t m_peakModelMemory = 0U;
+        std::size_t m_internedStringsCount = 0U;
+    };
 
     Protocol();
     ~Protocol();
 
     void setErrorReportCallback(ErrorReportFunction&& cb);
+    void setCompactModel(bool value);
+    void setValidationJobs(unsigned jobs);
+    void setStatsEnabled(bool value);
 
     bool parse(const std::string& input);
+    bool parseAll(const FilesList& files, unsigned jobs = 0U);
+    bool parseBuffer(const char* data, std::size_t len, const std::string& name);
+    bool parseStreamed(const std::string& input);
     bool validate();
+    bool update(const std::string& input);
+    bool loadCache(const std::string& cacheFile, const FilesList& files);
+    bool saveCache(const std::string& cacheFile, const FilesList& files) const;
 
     Schema schema() const;
-    NamespacesList namespaces() const;
+    const NamespacesList& namespaces() const;
 
     static constexpr unsigned notYetDeprecated() noexcept
     {
@@ -57,12 +146,23 @@ public:
 
     Field findField(const std::string& externalRef) const;
 
-    MessagesList allMessages() const;
+    const MessagesList& allMessages() const;
+    const MessageIdsList& messageIds() const;
+    std::size_t messageIdOrdinal(std::uintmax_t id) const;
+    MessagesRange messagesById(std::uintmax_t id) const;
+    MessagesRange messagesByIdOrdinal(std::size_t ordinal) const;
+    Message findMessage(std::uintmax_t id) const;
+
+    const DependenciesList& dependencies(ElementKind kind, const std::string& externalRef) const;
+    const DependenciesList& dependents(ElementKind kind, const std::string& externalRef) const;
+    ElementsList allDependents(ElementKind kind, const std::string& externalRef) const;
 
     void addExpectedExtraPrefix(const std::string& value);
 
     const PlatformsList& platforms() const;
 
+    Stats stats() const;
+
 private:
     std::unique_ptr<ProtocolImpl> m_pImpl;
 };
@@ -20,6 +20,8 @@
 
 #include "common.h"
 #include "ProtocolImpl.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
@@ -52,6 +54,62 @@ AliasImpl::Ptr AliasImpl::create(::xmlNodePtr node, ProtocolImpl& protocol)
     return Ptr(new AliasImpl(node, protocol));
 }
 
+void AliasImpl::writeCache(CacheWriter& writer) const
+{
+    writer.writeString(m_state.m_name);
+    writer.writeString(m_state.m_description);
+    writer.writeString(m_state.m_fieldName);
+    writer.writeProps(m_state.m_extraAttrs);
+    writer.writeContents(m_state.m_extraChildren);
+}
+
+AliasImpl::Ptr AliasImpl::createFromCache(CacheReader& reader, ProtocolImpl& protocol)
+{
+    auto alias = create(nullptr, protocol);
+    alias->m_state.m_name = reader.readString();
+    alias->m_state.m_description = reader.readString();
+    alias->m_state.m_fieldName = reader.readString();
+    alias->m_state.m_extraAttrs = reader.readProps();
+    alias->m_state.m_extraChildren = reader.readContents();
+    if (!reader.ok()) {
+        return Ptr();
+    }
+
+    return alias;
+}
+
+void AliasImpl::releaseNodesList(const AliasesList& aliases)
+{
+    for (auto& a : aliases) {
+        a->releaseNodes();
+    }
+}
+
+void AliasImpl::writeCacheList(CacheWriter& writer, const AliasesList& aliases)
+{
+    writer.writeUnsigned(aliases.size());
+    for (auto& a : aliases) {
+        a->writeCache(writer);
+    }
+}
+
+bool AliasImpl::readCacheList(CacheReader& reader, ProtocolImpl& protocol, AliasesList& aliases)
+{
+    auto count = reader.readSize();
+    aliases.clear();
+    aliases.reserve(count);
+    for (auto idx = 0U; idx < count; ++idx) {
+        auto alias = createFromCache(reader, protocol);
+        if (!alias) {
+            return false;
+        }
+
+        aliases.push_back(std::move(alias));
+    }
+
+    return reader.ok();
+}
+
 bool AliasImpl::parse()
 {
     auto props = XmlWrap::parseNodeProps(m_node);
@@ -83,8 +141,8 @@ bool AliasImpl::parse()
 }
 
 bool AliasImpl::verifyAlias(
-    const std::vector<Ptr>& aliases,
-    const std::vector<FieldImplPtr>& fields) const
+    const AliasesList& aliases,
+    const FieldImpl::FieldsList& fields) const
 {
     auto& aliasName = name();
     assert(!aliasName.empty());
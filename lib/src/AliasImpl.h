@@ -21,17 +21,21 @@
 
 #include "XmlWrap.h"
 #include "FieldImpl.h"
+#include "Arena.h"
 
 namespace commsdsl
 {
 
 class ProtocolImpl;
-class AliasImpl
+class CacheWriter;
+class CacheReader;
+class AliasImpl : public ArenaAllocated
 {
 public:
     using PropsMap = XmlWrap::PropsMap;
     using ContentsList = XmlWrap::ContentsList;
     using Ptr = std::unique_ptr<AliasImpl>;
+    using AliasesList = ArenaVector<Ptr>;
 
     const std::string& name() const
     {
@@ -79,7 +83,19 @@ public:
         return m_node;
     }
 
-    bool verifyAlias(const std::vector<Ptr>& aliases, const std::vector<FieldImplPtr>& fields) const;
+    bool verifyAlias(const AliasesList& aliases, const FieldImpl::FieldsList& fields) const;
+
+    void releaseNodes()
+    {
+        m_node = nullptr;
+    }
+
+    static void releaseNodesList(const AliasesList& aliases);
+
+    void writeCache(CacheWriter& writer) const;
+    static Ptr createFromCache(CacheReader& reader, ProtocolImpl& protocol);
+    static void writeCacheList(CacheWriter& writer, const AliasesList& aliases);
+    static bool readCacheList(CacheReader& reader, ProtocolImpl& protocol, AliasesList& aliases);
 
 protected:
     AliasImpl(::xmlNodePtr node, ProtocolImpl& protocol) : m_node(node), m_protocol(protocol) {}
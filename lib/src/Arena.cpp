@@ -0,0 +1,129 @@
+//
+// Copyright 2018 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Arena.h"
+
+#include <new>
+#include <utility>
+
+namespace commsdsl
+{
+
+namespace
+{
+
+const std::size_t BlockSize = 64U * 1024U;
+const std::size_t Alignment = alignof(std::max_align_t);
+
+// Every allocation is preceded by a header recording the arena it
+// came from, nullptr means the memory belongs to the global heap.
+struct AllocHeader
+{
+    Arena* m_arena = nullptr;
+};
+
+const std::size_t HeaderSize = ((sizeof(AllocHeader) + Alignment - 1U) / Alignment) * Alignment;
+
+thread_local Arena* CurrentArena = nullptr;
+
+std::size_t alignedSize(std::size_t size)
+{
+    return ((size + Alignment - 1U) / Alignment) * Alignment;
+}
+
+} // namespace
+
+Arena::Scope::Scope(Arena& arena)
+  : m_prev(CurrentArena)
+{
+    CurrentArena = &arena;
+}
+
+Arena::Scope::~Scope()
+{
+    CurrentArena = m_prev;
+}
+
+void* Arena::allocate(std::size_t size)
+{
+    size = alignedSize(size);
+    m_usedBytes += size;
+    if (BlockSize <= size) {
+        // Big allocations get a dedicated block, the current one stays in use.
+        m_blocks.emplace_back(new char[size]);
+        m_reservedBytes += size;
+        return m_blocks.back().get();
+    }
+
+    if (m_remaining < size) {
+        m_blocks.emplace_back(new char[BlockSize]);
+        m_next = m_blocks.back().get();
+        m_remaining = BlockSize;
+        m_reservedBytes += BlockSize;
+    }
+
+    auto* result = m_next;
+    m_next += size;
+    m_remaining -= size;
+    return result;
+}
+
+void Arena::swap(Arena& other)
+{
+    m_blocks.swap(other.m_blocks);
+    std::swap(m_next, other.m_next);
+    std::swap(m_remaining, other.m_remaining);
+    std::swap(m_usedBytes, other.m_usedBytes);
+    std::swap(m_reservedBytes, other.m_reservedBytes);
+}
+
+Arena* Arena::current()
+{
+    return CurrentArena;
+}
+
+void* Arena::allocateTagged(std::size_t size)
+{
+    auto* arena = current();
+    void* mem = nullptr;
+    if (arena != nullptr) {
+        mem = arena->allocate(HeaderSize + size);
+    }
+    else {
+        mem = ::operator new(HeaderSize + size);
+    }
+
+    auto* header = new (mem) AllocHeader;
+    header->m_arena = arena;
+    return static_cast<char*>(mem) + HeaderSize;
+}
+
+void Arena::releaseTagged(void* ptr)
+{
+    if (ptr == nullptr) {
+        return;
+    }
+
+    auto* mem = static_cast<char*>(ptr) - HeaderSize;
+    auto* header = reinterpret_cast<AllocHeader*>(mem);
+    if (header->m_arena != nullptr) {
+        // Released together with the arena
+        return;
+    }
+
+    ::operator delete(mem);
+}
+
+} // namespace commsdsl
@@ -0,0 +1,144 @@
+//
+// Copyright 2018 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace commsdsl
+{
+
+// Bump pointer storage of the object model elements and their internal
+// containers. It reduces the number of the global heap allocations and keeps
+// the elements of one input close together. The elements are still destroyed
+// one by one, the members exposed through the public API use the global heap.
+class Arena
+{
+public:
+    class Scope
+    {
+    public:
+        explicit Scope(Arena& arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Arena* m_prev = nullptr;
+    };
+
+    Arena() = default;
+    ~Arena() = default;
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(std::size_t size);
+    void swap(Arena& other);
+
+    std::size_t usedBytes() const
+    {
+        return m_usedBytes;
+    }
+
+    std::size_t reservedBytes() const
+    {
+        return m_reservedBytes;
+    }
+
+    static Arena* current();
+
+    // Allocation from the current arena (global heap if there is none)
+    // tagged with its origin, the release of the arena memory is a no-op.
+    static void* allocateTagged(std::size_t size);
+    static void releaseTagged(void* ptr);
+
+private:
+    using Block = std::unique_ptr<char[]>;
+    using BlocksList = std::vector<Block>;
+
+    BlocksList m_blocks;
+    char* m_next = nullptr;
+    std::size_t m_remaining = 0U;
+    std::size_t m_usedBytes = 0U;
+    std::size_t m_reservedBytes = 0U;
+};
+
+class ArenaAllocated
+{
+public:
+    static void* operator new(std::size_t size)
+    {
+        return Arena::allocateTagged(size);
+    }
+
+    static void operator delete(void* ptr)
+    {
+        Arena::releaseTagged(ptr);
+    }
+
+protected:
+    ArenaAllocated() = default;
+    ~ArenaAllocated() = default;
+};
+
+// Allocator of the internal (not exposed through the public API) containers
+// of the object model elements. The memory comes from the arena current on
+// the allocating thread, so the containers filled by the parallel parsing
+// jobs use the job's own arena.
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    ArenaAllocator() = default;
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>&) {}
+
+    T* allocate(std::size_t count)
+    {
+        return static_cast<T*>(Arena::allocateTagged(count * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t)
+    {
+        Arena::releaseTagged(ptr);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>&, const ArenaAllocator<U>&)
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>&, const ArenaAllocator<U>&)
+{
+    return false;
+}
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T> >;
+
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char> >;
+
+} // namespace commsdsl
@@ -23,6 +23,8 @@
 #include <iterator>
 
 #include "ProtocolImpl.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
@@ -287,7 +289,7 @@ bool BitfieldFieldImpl::updateMembers()
 
             if ((mem->getSinceVersion() != getSinceVersion()) ||
                 (mem->getDeprecated() != getDeprecated())) {
-                logError() << XmlWrap::logPrefix(mem->getNode()) <<
+                logError() << mem->schemaPos() <<
                     "Bitfield members are not allowed to update \"" << common::sinceVersionStr() << "\" and "
                     "\"" << common::deprecatedStr() << "\" properties.";
                 return false;
@@ -327,4 +329,28 @@ bool BitfieldFieldImpl::updateMembers()
     return true;
 }
 
+void BitfieldFieldImpl::collectDependenciesImpl(const DependencyReportFunc& func) const
+{
+    for (auto& m : m_members) {
+        m->collectDependencies(func);
+    }
+}
+
+void BitfieldFieldImpl::releaseNodesImpl()
+{
+    releaseNodesList(m_members);
+}
+
+void BitfieldFieldImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    writer.writeEnum(m_endian);
+    writeCacheList(writer, m_members);
+}
+
+bool BitfieldFieldImpl::readCacheImpl(CacheReader& reader)
+{
+    m_endian = reader.readEnum<Endian>();
+    return readCacheList(reader, protocol(), m_members);
+}
+
 } // namespace commsdsl
@@ -57,6 +57,10 @@ protected:
     virtual bool strToFpImpl(const std::string& ref, double& val) const override;
     virtual bool strToBoolImpl(const std::string& ref, bool& val) const override;
     virtual bool verifyAliasedMemberImpl(const std::string& fieldName) const override;
+    virtual void collectDependenciesImpl(const DependencyReportFunc& func) const override;
+    virtual void releaseNodesImpl() override;
+    virtual void writeCacheImpl(CacheWriter& writer) const override;
+    virtual bool readCacheImpl(CacheReader& reader) override;
 
 private:
     bool updateEndian();
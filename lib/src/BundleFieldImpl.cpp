@@ -24,6 +24,8 @@
 
 #include "ProtocolImpl.h"
 #include "OptionalFieldImpl.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
@@ -432,4 +434,30 @@ bool BundleFieldImpl::updateAliases()
     return true;
 }
 
+void BundleFieldImpl::collectDependenciesImpl(const DependencyReportFunc& func) const
+{
+    for (auto& m : m_members) {
+        m->collectDependencies(func);
+    }
+}
+
+void BundleFieldImpl::releaseNodesImpl()
+{
+    releaseNodesList(m_members);
+    AliasImpl::releaseNodesList(m_aliases);
+}
+
+void BundleFieldImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    writeCacheList(writer, m_members);
+    AliasImpl::writeCacheList(writer, m_aliases);
+}
+
+bool BundleFieldImpl::readCacheImpl(CacheReader& reader)
+{
+    return
+        readCacheList(reader, protocol(), m_members) &&
+        AliasImpl::readCacheList(reader, protocol(), m_aliases);
+}
+
 } // namespace commsdsl
@@ -56,13 +56,17 @@ protected:
     virtual bool strToStringImpl(const std::string& ref, std::string& val) const override;
     virtual bool strToDataImpl(const std::string& ref, std::vector<std::uint8_t>& val) const override;
     virtual bool verifyAliasedMemberImpl(const std::string& fieldName) const override;
+    virtual void collectDependenciesImpl(const DependencyReportFunc& func) const override;
+    virtual void releaseNodesImpl() override;
+    virtual void writeCacheImpl(CacheWriter& writer) const override;
+    virtual bool readCacheImpl(CacheReader& reader) override;
 
 private:
     bool updateMembers();
     bool updateAliases();
 
     FieldsList m_members;
-    std::vector<AliasImplPtr> m_aliases;
+    AliasImpl::AliasesList m_aliases;
 };
 
 } // namespace commsdsl
@@ -0,0 +1,252 @@
+//
+// Copyright 2018 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CacheReader.h"
+
+#include <cstring>
+#include <limits>
+#include <iterator>
+#include <utility>
+
+#include "common.h"
+
+namespace commsdsl
+{
+
+CacheReader::CacheReader(const char* data, std::size_t len)
+  : m_data(data),
+    m_len(len)
+{
+}
+
+bool CacheReader::readBool()
+{
+    return readUnsigned() != 0U;
+}
+
+std::uintmax_t CacheReader::readUnsigned()
+{
+    std::uintmax_t result = 0U;
+    unsigned shift = 0U;
+    while (!m_failed) {
+        if ((m_len <= m_pos) || (std::numeric_limits<std::uintmax_t>::digits <= shift)) {
+            m_failed = true;
+            break;
+        }
+
+        auto byte = static_cast<std::uint8_t>(m_data[m_pos]);
+        ++m_pos;
+        result |= (static_cast<std::uintmax_t>(byte & 0x7f) << shift);
+        if ((byte & 0x80) == 0U) {
+            return result;
+        }
+
+        shift += 7U;
+    }
+
+    return 0U;
+}
+
+std::intmax_t CacheReader::readSigned()
+{
+    auto value = readUnsigned();
+    if ((value & 1U) != 0U) {
+        return static_cast<std::intmax_t>(~(value >> 1));
+    }
+
+    return static_cast<std::intmax_t>(value >> 1);
+}
+
+double CacheReader::readDouble()
+{
+    std::uint64_t bits = 0U;
+    if ((m_failed) || ((m_len - m_pos) < sizeof(bits))) {
+        m_failed = true;
+        return 0.0;
+    }
+
+    for (auto idx = 0U; idx < sizeof(bits); ++idx) {
+        bits |= (static_cast<std::uint64_t>(static_cast<std::uint8_t>(m_data[m_pos + idx])) << (idx * 8U));
+    }
+    m_pos += sizeof(bits);
+
+    double value = 0.0;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string CacheReader::readString()
+{
+    auto len = readUnsigned();
+    if ((m_failed) || ((m_len - m_pos) < len)) {
+        m_failed = true;
+        return std::string();
+    }
+
+    std::string result(m_data + m_pos, static_cast<std::size_t>(len));
+    m_pos += static_cast<std::size_t>(len);
+    return result;
+}
+
+std::size_t CacheReader::readSize()
+{
+    // Every element takes at least one byte, reject bogus sizes
+    // before they are used to allocate memory.
+    auto value = readUnsigned();
+    if ((m_failed) || ((m_len - m_pos) < value)) {
+        m_failed = true;
+        return 0U;
+    }
+
+    return static_cast<std::size_t>(value);
+}
+
+CacheReader::PropsMap CacheReader::readProps()
+{
+    PropsMap result;
+    auto count = readSize();
+    for (auto idx = 0U; idx < count; ++idx) {
+        auto key = readString();
+        auto value = readString();
+        result.insert(result.end(), std::make_pair(std::move(key), std::move(value)));
+    }
+    return result;
+}
+
+CacheReader::ContentsList CacheReader::readContents()
+{
+    ContentsList result;
+    auto count = readSize();
+    result.reserve(count);
+    for (auto idx = 0U; idx < count; ++idx) {
+        result.push_back(readString());
+    }
+    return result;
+}
+
+const std::string* CacheReader::readPropRef(const PropsMap& props)
+{
+    auto pos = readUnsigned();
+    if (pos == 0U) {
+        return &common::emptyString();
+    }
+
+    if (props.size() < pos) {
+        m_failed = true;
+        return &common::emptyString();
+    }
+
+    return &(std::next(props.begin(), static_cast<long>(pos - 1U))->second);
+}
+
+void CacheReader::readObjectId(Object& obj)
+{
+    auto id = readUnsigned();
+    if ((m_failed) || (id == 0U) || (m_len < id)) {
+        m_failed = true;
+        return;
+    }
+
+    auto idx = static_cast<std::size_t>(id);
+    if (m_objects.size() <= idx) {
+        m_objects.resize(idx + 1U, nullptr);
+    }
+
+    if (m_objects[idx] != nullptr) {
+        m_failed = true;
+        return;
+    }
+
+    m_objects[idx] = &obj;
+}
+
+void CacheReader::readParent(Object& obj)
+{
+    obj.setParent(nullptr);
+    addRefFixup(
+        [&obj](Object* parent)
+        {
+            obj.setParent(parent);
+        });
+}
+
+std::uintmax_t CacheReader::readSharedId()
+{
+    auto id = readUnsigned();
+    if ((m_shared.size() + 1U) < id) {
+        m_failed = true;
+        return 0U;
+    }
+
+    return id;
+}
+
+std::shared_ptr<void> CacheReader::sharedData(std::uintmax_t id) const
+{
+    if ((id == 0U) || (m_shared.size() < id)) {
+        return std::shared_ptr<void>();
+    }
+
+    return m_shared[static_cast<std::size_t>(id - 1U)];
+}
+
+void CacheReader::addSharedData(std::uintmax_t id, std::shared_ptr<void> data)
+{
+    if (id != (m_shared.size() + 1U)) {
+        m_failed = true;
+        return;
+    }
+
+    m_shared.push_back(std::move(data));
+}
+
+bool CacheReader::resolveRefs()
+{
+    if (m_failed) {
+        return false;
+    }
+
+    for (auto& f : m_fixups) {
+        if (f.m_id == 0U) {
+            continue;
+        }
+
+        auto idx = static_cast<std::size_t>(f.m_id);
+        if ((m_objects.size() <= idx) || (m_objects[idx] == nullptr)) {
+            m_failed = true;
+            return false;
+        }
+
+        f.m_func(m_objects[idx]);
+    }
+
+    m_fixups.clear();
+    return true;
+}
+
+void CacheReader::addRefFixup(RefFixupFunc&& func)
+{
+    auto id = readUnsigned();
+    if (m_failed || (id == 0U)) {
+        return;
+    }
+
+    RefFixup fixup;
+    fixup.m_id = id;
+    fixup.m_func = std::move(func);
+    m_fixups.push_back(std::move(fixup));
+}
+
+} // namespace commsdsl
@@ -0,0 +1,114 @@
+//
+// Copyright 2018 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "XmlWrap.h"
+#include "Object.h"
+
+namespace commsdsl
+{
+
+class CacheReader
+{
+public:
+    using PropsMap = XmlWrap::PropsMap;
+    using ContentsList = XmlWrap::ContentsList;
+
+    CacheReader(const char* data, std::size_t len);
+
+    bool ok() const
+    {
+        return !m_failed;
+    }
+
+    bool atEnd() const
+    {
+        return m_pos == m_len;
+    }
+
+    std::size_t pos() const
+    {
+        return m_pos;
+    }
+
+    bool readBool();
+    std::uintmax_t readUnsigned();
+    std::intmax_t readSigned();
+    double readDouble();
+    std::string readString();
+    std::size_t readSize();
+    PropsMap readProps();
+    ContentsList readContents();
+    const std::string* readPropRef(const PropsMap& props);
+    void readObjectId(Object& obj);
+    void readParent(Object& obj);
+    std::uintmax_t readSharedId();
+    std::shared_ptr<void> sharedData(std::uintmax_t id) const;
+    void addSharedData(std::uintmax_t id, std::shared_ptr<void> data);
+
+    template <typename T>
+    T readUnsigned()
+    {
+        return static_cast<T>(readUnsigned());
+    }
+
+    template <typename T>
+    T readEnum()
+    {
+        return static_cast<T>(readUnsigned());
+    }
+
+    template <typename T>
+    void readObjectRef(const T*& ptr)
+    {
+        ptr = nullptr;
+        addRefFixup(
+            [&ptr](Object* obj)
+            {
+                ptr = static_cast<const T*>(obj);
+            });
+    }
+
+    bool resolveRefs();
+
+private:
+    using RefFixupFunc = std::function<void (Object*)>;
+
+    struct RefFixup
+    {
+        std::uintmax_t m_id = 0U;
+        RefFixupFunc m_func;
+    };
+
+    void addRefFixup(RefFixupFunc&& func);
+
+    const char* m_data = nullptr;
+    std::size_t m_len = 0U;
+    std::size_t m_pos = 0U;
+    bool m_failed = false;
+    std::vector<Object*> m_objects;
+    std::vector<RefFixup> m_fixups;
+    std::vector<std::shared_ptr<void>> m_shared;
+};
+
+} // namespace commsdsl
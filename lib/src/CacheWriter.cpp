@@ -0,0 +1,143 @@
+//
+// Copyright 2018 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CacheWriter.h"
+
+#include <cstring>
+
+namespace commsdsl
+{
+
+void CacheWriter::writeBool(bool value)
+{
+    m_data.push_back(static_cast<char>(value ? 1 : 0));
+}
+
+void CacheWriter::writeUnsigned(std::uintmax_t value)
+{
+    while (0x80 <= value) {
+        m_data.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    m_data.push_back(static_cast<char>(value));
+}
+
+void CacheWriter::writeSigned(std::intmax_t value)
+{
+    auto uValue = static_cast<std::uintmax_t>(value);
+    if (value < 0) {
+        writeUnsigned(((~uValue) << 1) | 1U);
+        return;
+    }
+
+    writeUnsigned(uValue << 1);
+}
+
+void CacheWriter::writeDouble(double value)
+{
+    static_assert(sizeof(double) == sizeof(std::uint64_t), "Unexpected double size");
+    std::uint64_t bits = 0U;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (auto idx = 0U; idx < sizeof(bits); ++idx) {
+        m_data.push_back(static_cast<char>((bits >> (idx * 8U)) & 0xff));
+    }
+}
+
+void CacheWriter::writeString(const std::string& value)
+{
+    writeUnsigned(value.size());
+    m_data.append(value);
+}
+
+void CacheWriter::writeProps(const PropsMap& value)
+{
+    writeUnsigned(value.size());
+    for (auto& p : value) {
+        writeString(p.first);
+        writeString(p.second);
+    }
+}
+
+void CacheWriter::writeContents(const ContentsList& value)
+{
+    writeUnsigned(value.size());
+    for (auto& c : value) {
+        writeString(c);
+    }
+}
+
+void CacheWriter::writePropRef(const PropsMap& props, const std::string* value)
+{
+    // Records position of the referenced property value (if any),
+    // zero stands for the value not being taken from the properties.
+    std::uintmax_t pos = 0U;
+    for (auto& p : props) {
+        ++pos;
+        if (&p.second == value) {
+            writeUnsigned(pos);
+            return;
+        }
+    }
+
+    writeUnsigned(0U);
+}
+
+void CacheWriter::writeObjectId(const Object& obj)
+{
+    writeUnsigned(objectId(&obj));
+}
+
+void CacheWriter::writeObjectRef(const Object* obj)
+{
+    if (obj == nullptr) {
+        writeUnsigned(0U);
+        return;
+    }
+
+    writeUnsigned(objectId(obj));
+}
+
+bool CacheWriter::writeSharedId(const void* data)
+{
+    if (data == nullptr) {
+        writeUnsigned(0U);
+        return false;
+    }
+
+    auto iter = m_sharedIds.find(data);
+    if (iter != m_sharedIds.end()) {
+        writeUnsigned(iter->second);
+        return false;
+    }
+
+    auto id = static_cast<std::uintmax_t>(m_sharedIds.size() + 1U);
+    m_sharedIds.insert(std::make_pair(data, id));
+    writeUnsigned(id);
+    return true;
+}
+
+std::uintmax_t CacheWriter::objectId(const Object* obj)
+{
+    auto iter = m_ids.find(obj);
+    if (iter != m_ids.end()) {
+        return iter->second;
+    }
+
+    auto id = static_cast<std::uintmax_t>(m_ids.size() + 1U);
+    m_ids.insert(std::make_pair(obj, id));
+    return id;
+}
+
+} // namespace commsdsl
@@ -0,0 +1,65 @@
+//
+// Copyright 2018 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "XmlWrap.h"
+
+namespace commsdsl
+{
+
+class Object;
+class CacheWriter
+{
+public:
+    using PropsMap = XmlWrap::PropsMap;
+    using ContentsList = XmlWrap::ContentsList;
+
+    void writeBool(bool value);
+    void writeUnsigned(std::uintmax_t value);
+    void writeSigned(std::intmax_t value);
+    void writeDouble(double value);
+    void writeString(const std::string& value);
+    void writeProps(const PropsMap& value);
+    void writeContents(const ContentsList& value);
+    void writePropRef(const PropsMap& props, const std::string* value);
+    void writeObjectId(const Object& obj);
+    void writeObjectRef(const Object* obj);
+    bool writeSharedId(const void* data);
+
+    template <typename T>
+    void writeEnum(T value)
+    {
+        writeUnsigned(static_cast<std::uintmax_t>(value));
+    }
+
+    const std::string& data() const
+    {
+        return m_data;
+    }
+
+private:
+    std::uintmax_t objectId(const Object* obj);
+
+    std::string m_data;
+    std::map<const Object*, std::uintmax_t> m_ids;
+    std::map<const void*, std::uintmax_t> m_sharedIds;
+};
+
+} // namespace commsdsl
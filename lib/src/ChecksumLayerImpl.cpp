@@ -20,6 +20,8 @@
 
 #include "ProtocolImpl.h"
 #include "common.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
@@ -180,5 +182,23 @@ bool ChecksumLayerImpl::updateVerifyBeforeRead()
     return true;
 }
 
+void ChecksumLayerImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    writer.writeEnum(m_alg);
+    writer.writePropRef(props(), m_algName);
+    writer.writePropRef(props(), m_from);
+    writer.writePropRef(props(), m_until);
+    writer.writeBool(m_verifyBeforeRead);
+}
+
+bool ChecksumLayerImpl::readCacheImpl(CacheReader& reader)
+{
+    m_alg = reader.readEnum<Alg>();
+    m_algName = reader.readPropRef(props());
+    m_from = reader.readPropRef(props());
+    m_until = reader.readPropRef(props());
+    m_verifyBeforeRead = reader.readBool();
+    return reader.ok();
+}
 
 } // namespace commsdsl
@@ -57,6 +57,8 @@ protected:
     virtual const XmlWrap::NamesList& extraPropsNamesImpl() const override;
     virtual bool parseImpl() override;
     virtual bool verifyImpl(const LayersList& layers) override;
+    virtual void writeCacheImpl(CacheWriter& writer) const override;
+    virtual bool readCacheImpl(CacheReader& reader) override;
 
 private:
     bool updateAlg();
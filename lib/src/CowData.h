@@ -0,0 +1,95 @@
+//
+// Copyright 2018 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+
+#include "CacheReader.h"
+#include "CacheWriter.h"
+
+namespace commsdsl
+{
+
+// Shares the held data between copies until one of them modifies it.
+template <typename T>
+class CowData
+{
+public:
+    const T& get() const
+    {
+        if (!m_data) {
+            return emptyData();
+        }
+
+        return *m_data;
+    }
+
+    const T* operator->() const
+    {
+        return &get();
+    }
+
+    T& modify()
+    {
+        if (!m_data) {
+            m_data = std::make_shared<T>();
+        }
+        else if (1 < m_data.use_count()) {
+            m_data = std::make_shared<T>(*m_data);
+        }
+
+        return *m_data;
+    }
+
+    template <typename TFunc>
+    void writeCache(CacheWriter& writer, TFunc&& func) const
+    {
+        if (writer.writeSharedId(m_data.get())) {
+            func(*m_data);
+        }
+    }
+
+    template <typename TFunc>
+    void readCache(CacheReader& reader, TFunc&& func)
+    {
+        m_data.reset();
+        auto id = reader.readSharedId();
+        if (id == 0U) {
+            return;
+        }
+
+        auto shared = reader.sharedData(id);
+        if (shared) {
+            m_data = std::static_pointer_cast<T>(shared);
+            return;
+        }
+
+        m_data = std::make_shared<T>();
+        func(*m_data);
+        reader.addSharedData(id, m_data);
+    }
+
+private:
+    static const T& emptyData()
+    {
+        static const T Data;
+        return Data;
+    }
+
+    std::shared_ptr<T> m_data;
+};
+
+} // namespace commsdsl
@@ -17,6 +17,8 @@
 
 #include "ProtocolImpl.h"
 #include "common.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
@@ -60,4 +62,15 @@ const XmlWrap::NamesList& CustomLayerImpl::extraPropsNamesImpl() const
     return List;
 }
 
+void CustomLayerImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    writer.writeBool(m_idReplacement);
+}
+
+bool CustomLayerImpl::readCacheImpl(CacheReader& reader)
+{
+    m_idReplacement = reader.readBool();
+    return reader.ok();
+}
+
 } // namespace commsdsl
@@ -35,6 +35,8 @@ protected:
     virtual Kind kindImpl() const override;
     virtual bool parseImpl() override;
     virtual const XmlWrap::NamesList& extraPropsNamesImpl() const override;
+    virtual void writeCacheImpl(CacheWriter& writer) const override;
+    virtual bool readCacheImpl(CacheReader& reader) override;
 
 private:
     bool m_idReplacement = false;
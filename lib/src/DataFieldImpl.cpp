@@ -26,6 +26,8 @@
 #include "IntFieldImpl.h"
 #include "RefFieldImpl.h"
 #include "util.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
@@ -432,28 +434,56 @@ bool DataFieldImpl::strToValue(const std::string& str, ValueType& val) const
 
     val.clear();
     val.reserve(adjStr.size() / 2U);
-    std::string byteStr;
-    for (auto ch : adjStr) {
-        byteStr.push_back(ch);
-        if (byteStr.size() <= 1U) {
-            continue;
-        }
-
-        try {
-            auto byte = static_cast<std::uint8_t>(std::stoul(byteStr, 0, 16));
-            val.push_back(byte);
-            byteStr.clear();
-        }
-        catch (...) {
+    for (auto idx = 0U; idx < adjStr.size(); idx += 2U) {
+        std::uint8_t byte = 0U;
+        if (!common::decodeHexByte(adjStr[idx], adjStr[idx + 1U], byte)) {
             static constexpr bool Should_not_happen = false;
             static_cast<void>(Should_not_happen);
             assert(Should_not_happen);
             return false;
         }
+
+        val.push_back(byte);
     }
 
     assert(val.size() == (adjStr.size() / 2U));
     return true;
 }
 
+void DataFieldImpl::collectDependenciesImpl(const DependencyReportFunc& func) const
+{
+    if (m_state.m_extPrefixField != nullptr) {
+        func(DependencyKind::LengthPrefix, *m_state.m_extPrefixField);
+        return;
+    }
+
+    if (m_prefixField) {
+        m_prefixField->collectDependencies(func);
+    }
+}
+
+void DataFieldImpl::releaseNodesImpl()
+{
+    releaseNodesOptional(m_prefixField);
+}
+
+void DataFieldImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    writer.writeString(std::string(m_state.m_defaultValue.begin(), m_state.m_defaultValue.end()));
+    writer.writeUnsigned(m_state.m_length);
+    writer.writeObjectRef(m_state.m_extPrefixField);
+    writer.writeString(m_state.m_detachedPrefixField);
+    writeCacheOptional(writer, m_prefixField);
+}
+
+bool DataFieldImpl::readCacheImpl(CacheReader& reader)
+{
+    auto defaultValue = reader.readString();
+    m_state.m_defaultValue.assign(defaultValue.begin(), defaultValue.end());
+    m_state.m_length = reader.readUnsigned<std::size_t>();
+    reader.readObjectRef(m_state.m_extPrefixField);
+    m_state.m_detachedPrefixField = reader.readString();
+    return readCacheOptional(reader, protocol(), m_prefixField);
+}
+
 } // namespace commsdsl
@@ -78,6 +78,10 @@ protected:
     virtual std::size_t minLengthImpl() const override;
     virtual std::size_t maxLengthImpl() const override;
     virtual bool strToDataImpl(const std::string& ref, std::vector<std::uint8_t>& val) const override;
+    virtual void collectDependenciesImpl(const DependencyReportFunc& func) const override;
+    virtual void releaseNodesImpl() override;
+    virtual void writeCacheImpl(CacheWriter& writer) const override;
+    virtual bool readCacheImpl(CacheReader& reader) override;
 
 private:
     bool updateDefaultValue();
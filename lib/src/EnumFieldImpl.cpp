@@ -20,11 +20,16 @@
 #include <iterator>
 #include <limits>
 #include <cassert>
+#include <numeric>
+#include <vector>
+#include <unordered_map>
 
 #include "common.h"
 #include "ProtocolImpl.h"
 #include "IntFieldImpl.h"
 #include "util.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
@@ -47,7 +52,7 @@ bool EnumFieldImpl::isUnique() const
 {
     std::intmax_t prevKey = 0;
     bool firstElem = true;
-    for (auto& v : m_state.m_revValues) {
+    for (auto& v : m_state.m_revValues.get()) {
         if (firstElem) {
             prevKey = v.first;
             firstElem = false;
@@ -182,8 +187,8 @@ bool EnumFieldImpl::strToNumericImpl(const std::string& ref, std::intmax_t& val,
         return true;
     }
 
-    auto iter = m_state.m_values.find(ref);
-    if (iter == m_state.m_values.end()) {
+    auto iter = m_state.m_values->find(ref);
+    if (iter == m_state.m_values->end()) {
         return false;
     }
 
@@ -386,8 +391,8 @@ bool EnumFieldImpl::updateValues()
 {
     auto validValues = XmlWrap::getChildren(getNode(), common::validValueStr());
     if (validValues.empty()) {
-        if (!m_state.m_values.empty()) {
-            assert(!m_state.m_revValues.empty());
+        if (!m_state.m_values->empty()) {
+            assert(!m_state.m_revValues->empty());
             return true; // already has values
         }
 
@@ -396,6 +401,29 @@ bool EnumFieldImpl::updateValues()
         return false;
     }
 
+    // New values are appended in the order of definition and sorted once
+    // all of them are known, the duplicates are detected using the hashed
+    // lookups to report the errors in the order of definition. The names
+    // referenced by the "val" property are also resolved using the hashed
+    // lookup, the binary search of m_values cannot be used until sorted.
+    auto& values = m_state.m_values.modify();
+    auto& revValues = m_state.m_revValues.modify();
+    auto prevCount = values.size();
+    values.reserve(prevCount + validValues.size());
+    revValues.reserve(prevCount + validValues.size());
+
+    std::unordered_map<std::string, std::intmax_t> names;
+    std::unordered_map<std::intmax_t, std::size_t> revIndices;
+    names.reserve(values.size() + validValues.size());
+    revIndices.reserve(revValues.size() + validValues.size());
+    for (auto& v : values) {
+        names.insert(std::make_pair(v.first, v.second.m_value));
+    }
+
+    for (auto idx = 0U; idx < revValues.size(); ++idx) {
+        revIndices.insert(std::make_pair((revValues.begin() + idx)->first, idx));
+    }
+
     for (auto* vNode : validValues) {
         static const XmlWrap::NamesList PropNames = {
             common::nameStr(),
@@ -450,8 +478,7 @@ bool EnumFieldImpl::updateValues()
             return false;
         }
 
-        auto valuesIter = m_state.m_values.find(nameIter->second);
-        if (valuesIter != m_state.m_values.end()) {
+        if (names.find(nameIter->second) != names.end()) {
             logError() << XmlWrap::logPrefix(vNode) << "Value with name \"" << nameIter->second <<
                           "\" has already been defined for enum \"" << name() << "\".";
             return false;
@@ -461,7 +488,11 @@ bool EnumFieldImpl::updateValues()
         assert(valIter != props.end());
 
         std::intmax_t val = 0;
-        if (!strToValue(valIter->second, val)) {
+        auto refIter = names.find(valIter->second);
+        if (refIter != names.end()) {
+            val = refIter->second;
+        }
+        else if (!strToValue(valIter->second, val)) {
             logError() << XmlWrap::logPrefix(vNode) << "Value of \"" << nameIter->second <<
                           "\" (" << valIter->second << ") cannot be recognized.";
             return false;
@@ -498,14 +529,15 @@ bool EnumFieldImpl::updateValues()
             return false;
         }
 
-        if (!m_state.m_nonUniqueAllowed) {
-            auto revIter = m_state.m_revValues.find(val);
-            if (revIter != m_state.m_revValues.end()) {
-                logError() << XmlWrap::logPrefix(vNode) <<
-                              "Value \"" << valIter->second << "\" has been already defined "
-                              "as \"" << revIter->second << "\".";
-                return false;
-            }
+        auto revIndexIter = revIndices.find(val);
+        if (revIndexIter == revIndices.end()) {
+            revIndices.insert(std::make_pair(val, revValues.size()));
+        }
+        else if (!m_state.m_nonUniqueAllowed) {
+            logError() << XmlWrap::logPrefix(vNode) <<
+                          "Value \"" << valIter->second << "\" has been already defined "
+                          "as \"" << (revValues.begin() + revIndexIter->second)->second << "\".";
+            return false;
         }
 
         ValueInfo info;
@@ -529,9 +561,13 @@ bool EnumFieldImpl::updateValues()
             return false;
         }
 
-        m_state.m_values.emplace(nameIter->second, info);
-        m_state.m_revValues.emplace(val, nameIter->second);
+        names.insert(std::make_pair(nameIter->second, val));
+        values.append(nameIter->second, std::move(info));
+        revValues.append(val, nameIter->second);
     }
+
+    values.sort();
+    revValues.sort();
     return true;
 }
 
@@ -627,8 +663,8 @@ bool EnumFieldImpl::strToValue(
 {
     if (common::isValidName(str)) {
         // Check among specials
-        auto iter = m_state.m_values.find(str);
-        if (iter != m_state.m_values.end()) {
+        auto iter = m_state.m_values->find(str);
+        if (iter != m_state.m_values->end()) {
             val = iter->second.m_value;
             return true;
         }
@@ -670,4 +706,91 @@ bool EnumFieldImpl::strToValue(
 }
 
 
+void EnumFieldImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    writer.writeEnum(m_state.m_type);
+    writer.writeEnum(m_state.m_endian);
+    writer.writeUnsigned(m_state.m_length);
+    writer.writeUnsigned(m_state.m_bitLength);
+    writer.writeSigned(m_state.m_typeAllowedMinValue);
+    writer.writeSigned(m_state.m_typeAllowedMaxValue);
+    writer.writeSigned(m_state.m_minValue);
+    writer.writeSigned(m_state.m_maxValue);
+    writer.writeSigned(m_state.m_defaultValue);
+    m_state.m_values.writeCache(
+        writer,
+        [&writer](const Values& values)
+        {
+            writer.writeUnsigned(values.size());
+            for (auto& v : values) {
+                writer.writeString(v.first);
+                writer.writeSigned(v.second.m_value);
+                writer.writeUnsigned(v.second.m_sinceVersion);
+                writer.writeUnsigned(v.second.m_deprecatedSince);
+                writer.writeString(v.second.m_description);
+                writer.writeString(v.second.m_displayName);
+            }
+        });
+
+    m_state.m_revValues.writeCache(
+        writer,
+        [&writer](const RevValues& revValues)
+        {
+            writer.writeUnsigned(revValues.size());
+            for (auto& v : revValues) {
+                writer.writeSigned(v.first);
+                writer.writeString(v.second);
+            }
+        });
+
+    writer.writeBool(m_state.m_nonUniqueAllowed);
+    writer.writeBool(m_state.m_validCheckVersion);
+    writer.writeBool(m_state.m_hexAssign);
+}
+
+bool EnumFieldImpl::readCacheImpl(CacheReader& reader)
+{
+    m_state.m_type = reader.readEnum<Type>();
+    m_state.m_endian = reader.readEnum<Endian>();
+    m_state.m_length = reader.readUnsigned<std::size_t>();
+    m_state.m_bitLength = reader.readUnsigned<std::size_t>();
+    m_state.m_typeAllowedMinValue = reader.readSigned();
+    m_state.m_typeAllowedMaxValue = reader.readSigned();
+    m_state.m_minValue = reader.readSigned();
+    m_state.m_maxValue = reader.readSigned();
+    m_state.m_defaultValue = reader.readSigned();
+    m_state.m_values.readCache(
+        reader,
+        [&reader](Values& values)
+        {
+            auto valuesCount = reader.readSize();
+            for (auto idx = 0U; idx < valuesCount; ++idx) {
+                auto name = reader.readString();
+                ValueInfo info;
+                info.m_value = reader.readSigned();
+                info.m_sinceVersion = reader.readUnsigned<unsigned>();
+                info.m_deprecatedSince = reader.readUnsigned<unsigned>();
+                info.m_description = reader.readString();
+                info.m_displayName = reader.readString();
+                values.append(std::move(name), std::move(info));
+            }
+        });
+
+    m_state.m_revValues.readCache(
+        reader,
+        [&reader](RevValues& revValues)
+        {
+            auto revValuesCount = reader.readSize();
+            for (auto idx = 0U; idx < revValuesCount; ++idx) {
+                auto value = reader.readSigned();
+                revValues.append(value, reader.readString());
+            }
+        });
+
+    m_state.m_nonUniqueAllowed = reader.readBool();
+    m_state.m_validCheckVersion = reader.readBool();
+    m_state.m_hexAssign = reader.readBool();
+    return reader.ok();
+}
+
 } // namespace commsdsl
@@ -21,6 +21,7 @@
 
 #include "commsdsl/Endian.h"
 #include "commsdsl/EnumField.h"
+#include "CowData.h"
 #include "FieldImpl.h"
 
 namespace commsdsl
@@ -56,12 +57,12 @@ public:
 
     const Values& values() const
     {
-        return m_state.m_values;
+        return m_state.m_values.get();
     }
 
     const RevValues& revValues() const
     {
-        return m_state.m_revValues;
+        return m_state.m_revValues.get();
     }
 
     bool isNonUniqueAllowed() const
@@ -96,6 +97,8 @@ protected:
     virtual bool strToNumericImpl(const std::string& ref, std::intmax_t& val, bool& isBigUnsigned) const override;
     virtual bool validateBitLengthValueImpl(::xmlNodePtr node, std::size_t bitLength) const override;
     virtual bool verifySemanticTypeImpl(::xmlNodePtr node, SemanticType type) const override;
+    virtual void writeCacheImpl(CacheWriter& writer) const override;
+    virtual bool readCacheImpl(CacheReader& reader) override;
 
 private:
     bool updateType();
@@ -121,8 +124,8 @@ private:
         std::intmax_t m_minValue = 0;
         std::intmax_t m_maxValue = 0;
         std::intmax_t m_defaultValue = 0;
-        Values m_values;
-        RevValues m_revValues;
+        CowData<Values> m_values;
+        CowData<RevValues> m_revValues;
         bool m_nonUniqueAllowed = false;
         bool m_validCheckVersion = false;
         bool m_hexAssign = false;
@@ -35,6 +35,8 @@
 #include "OptionalFieldImpl.h"
 #include "VariantFieldImpl.h"
 #include "NamespaceImpl.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 #include "common.h"
 
 namespace commsdsl
@@ -58,11 +60,34 @@ FieldImpl::Ptr FieldImpl::create(
         return Ptr();
     }
 
-    return iter->second(node, protocol);
+    auto field = iter->second(node, protocol);
+    if (node != nullptr) {
+        // Fields re-created from cache are not counted
+        protocol.recordFieldCreated(field->kind());
+    }
+    return field;
+}
+
+FieldImpl::Ptr FieldImpl::clone() const
+{
+    m_protocol.recordFieldCloned();
+    return cloneImpl();
+}
+
+FieldImpl::Ptr FieldImpl::createFromCache(CacheReader& reader, ProtocolImpl& protocol)
+{
+    auto kind = reader.readString();
+    auto field = create(kind, nullptr, protocol);
+    if ((!field) || (!field->readCache(reader))) {
+        return Ptr();
+    }
+
+    return field;
 }
 
 bool FieldImpl::parse()
 {
+    ValueRefsScope valueRefsScope(*this);
     m_props = XmlWrap::parseNodeProps(m_node);
 
     if (!XmlWrap::parseChildrenAsProps(m_node, commonProps(), m_protocol.logger(), m_props)) {
@@ -155,6 +180,16 @@ const std::string& FieldImpl::description() const
     return m_state.m_description;
 }
 
+void FieldImpl::setName(const std::string& val)
+{
+    m_state.m_name = protocol().intern(val);
+}
+
+void FieldImpl::setDisplayName(const std::string& val)
+{
+    m_state.m_displayName = protocol().intern(val);
+}
+
 const std::string& FieldImpl::kindStr() const
 {
     static const std::string* const Map[] = {
@@ -196,16 +231,16 @@ XmlWrap::NamesList FieldImpl::supportedTypes()
 
 bool FieldImpl::validateMembersNames(
     const FieldImpl::FieldsList& fields,
-    Logger& logger)
+    const Logger& logger)
 {
-    std::set<std::string> usedNames;
+    // Names are interned, equal names share the same storage
+    std::set<const std::string*> usedNames;
     for (auto& f : fields) {
-        if (usedNames.find(f->name()) != usedNames.end()) {
-            commsdsl::logError(logger) << XmlWrap::logPrefix(f->getNode()) <<
+        if (!usedNames.insert(f->m_state.m_name.ptr()).second) {
+            commsdsl::logError(logger) << f->schemaPos() <<
                 "Member field with name \"" << f->name() << "\" has already been defined.";
             return false;
         }
-        usedNames.insert(f->name());
     }
     return true;
 }
@@ -241,6 +276,10 @@ std::string FieldImpl::externalRef() const
         return common::emptyString();
     }
 
+    if (!internedExternalRef().empty()) {
+        return internedExternalRef();
+    }
+
     auto& ns = static_cast<const commsdsl::NamespaceImpl&>(*getParent());
     auto nsRef = ns.externalRef();
     if (nsRef.empty()) {
@@ -334,17 +373,145 @@ bool FieldImpl::verifyAliasedMember(const std::string& fieldName)
 
 std::string FieldImpl::schemaPos() const
 {
+    if ((!m_schemaPos.empty()) || (m_node == nullptr)) {
+        return std::string(m_schemaPos.begin(), m_schemaPos.end());
+    }
+
     return XmlWrap::logPrefix(m_node);
 }
 
+void FieldImpl::collectDependencies(const DependencyReportFunc& func) const
+{
+    auto iter = m_props.find(common::reuseStr());
+    if (iter != m_props.end()) {
+        auto* field = m_protocol.findField(iter->second, false);
+        if (field != nullptr) {
+            func(DependencyKind::Reuse, *field);
+        }
+    }
+
+    reportValueRefs(func);
+    collectDependenciesImpl(func);
+}
+
+void FieldImpl::releaseNodes()
+{
+    m_node = nullptr;
+    releaseNodesImpl();
+}
+
+void FieldImpl::releaseNodesList(const FieldsList& fields)
+{
+    for (auto& f : fields) {
+        f->releaseNodes();
+    }
+}
+
+void FieldImpl::releaseNodesOptional(const Ptr& field)
+{
+    if (field) {
+        field->releaseNodes();
+    }
+}
+
+void FieldImpl::writeCache(CacheWriter& writer) const
+{
+    writer.writeString(kindStr());
+    writeObjectCache(writer);
+    writer.writeProps(m_props);
+    writer.writeString(schemaPos());
+    writer.writeString(m_state.m_name);
+    writer.writeString(m_state.m_displayName);
+    writer.writeString(m_state.m_description);
+    writer.writeProps(m_state.m_extraAttrs);
+    writer.writeContents(m_state.m_extraChildren);
+    writer.writeEnum(m_state.m_semanticType);
+    writer.writeBool(m_state.m_pseudo);
+    writer.writeBool(m_state.m_displayReadOnly);
+    writer.writeBool(m_state.m_displayHidden);
+    writer.writeBool(m_state.m_customizable);
+    writer.writeBool(m_state.m_failOnInvalid);
+    writer.writeBool(m_state.m_forceGen);
+    writeCacheImpl(writer);
+}
+
+void FieldImpl::writeCacheList(CacheWriter& writer, const FieldsList& fields)
+{
+    writer.writeUnsigned(fields.size());
+    for (auto& f : fields) {
+        f->writeCache(writer);
+    }
+}
+
+bool FieldImpl::readCacheList(CacheReader& reader, ProtocolImpl& protocol, FieldsList& fields)
+{
+    auto count = reader.readSize();
+    fields.clear();
+    fields.reserve(count);
+    for (auto idx = 0U; idx < count; ++idx) {
+        auto field = createFromCache(reader, protocol);
+        if (!field) {
+            return false;
+        }
+
+        fields.push_back(std::move(field));
+    }
+
+    return reader.ok();
+}
+
+void FieldImpl::writeCacheOptional(CacheWriter& writer, const Ptr& field)
+{
+    writer.writeBool(static_cast<bool>(field));
+    if (field) {
+        field->writeCache(writer);
+    }
+}
+
+bool FieldImpl::readCacheOptional(CacheReader& reader, ProtocolImpl& protocol, Ptr& field)
+{
+    field.reset();
+    if (!reader.readBool()) {
+        return reader.ok();
+    }
+
+    field = createFromCache(reader, protocol);
+    return static_cast<bool>(field);
+}
+
 FieldImpl::FieldImpl(::xmlNodePtr node, ProtocolImpl& protocol)
   : m_node(node),
     m_protocol(protocol)
 {
+    if ((node != nullptr) && protocol.isStreamParsing()) {
+        auto pos = XmlWrap::logPrefix(node);
+        m_schemaPos.assign(pos.begin(), pos.end());
+    }
 }
 
 FieldImpl::FieldImpl(const FieldImpl&) = default;
 
+bool FieldImpl::readCache(CacheReader& reader)
+{
+    readObjectCache(reader);
+    m_props = reader.readProps();
+    auto pos = reader.readString();
+    m_schemaPos.assign(pos.begin(), pos.end());
+    m_state.m_name = protocol().intern(reader.readString());
+    m_state.m_displayName = protocol().intern(reader.readString());
+    m_state.m_description = protocol().intern(reader.readString());
+    m_state.m_extraAttrs = reader.readProps();
+    m_state.m_extraChildren = reader.readContents();
+    m_state.m_semanticType = reader.readEnum<SemanticType>();
+    m_state.m_pseudo = reader.readBool();
+    m_state.m_displayReadOnly = reader.readBool();
+    m_state.m_displayHidden = reader.readBool();
+    m_state.m_customizable = reader.readBool();
+    m_state.m_failOnInvalid = reader.readBool();
+    m_state.m_forceGen = reader.readBool();
+    return readCacheImpl(reader) && reader.ok();
+}
+
 LogWrapper FieldImpl::logError() const
 {
     return commsdsl::logError(m_protocol.logger());
@@ -525,6 +692,26 @@ bool FieldImpl::verifyAliasedMemberImpl(const std::string& fieldName) const
     return false;
 }
 
+void FieldImpl::collectDependenciesImpl(const DependencyReportFunc& func) const
+{
+    static_cast<void>(func);
+}
+
+void FieldImpl::releaseNodesImpl()
+{
+}
+
+void FieldImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    static_cast<void>(writer);
+}
+
+bool FieldImpl::readCacheImpl(CacheReader& reader)
+{
+    static_cast<void>(reader);
+    return true;
+}
+
 bool FieldImpl::validateSinglePropInstance(const std::string& str, bool mustHave)
 {
     return XmlWrap::validateSinglePropInstance(m_node, m_props, str, protocol().logger(), mustHave);
@@ -564,6 +751,21 @@ bool FieldImpl::validateAndUpdateStringPropValue(
     return true;
 }
 
+bool FieldImpl::validateAndUpdateStringPropValue(
+    const std::string& str,
+    InternedString& value,
+    bool mustHave,
+    bool allowDeref)
+{
+    std::string valueStr = value;
+    if (!validateAndUpdateStringPropValue(str, valueStr, mustHave, allowDeref)) {
+        return false;
+    }
+
+    value = protocol().intern(valueStr);
+    return true;
+}
+
 void FieldImpl::reportUnexpectedPropertyValue(const std::string& propName, const std::string& propValue)
 {
     XmlWrap::reportUnexpectedPropertyValue(m_node, name(), propName, propValue, protocol().logger());
@@ -836,13 +1038,18 @@ bool FieldImpl::checkReuse()
     }
 
     assert(field != this);
+    auto* arena = Arena::current();
+    auto usedBytesBefore = (arena != nullptr) ? arena->usedBytes() : 0U;
     Base::reuseState(*field);
     m_state = field->m_state;
 
     assert(getSinceVersion() == 0U);
     assert(getDeprecated() == commsdsl::Protocol::notYetDeprecated());
     assert(!isDeprecatedRemoved());
-    return reuseImpl(*field);
+    bool result = reuseImpl(*field);
+    auto usedBytesAfter = (arena != nullptr) ? arena->usedBytes() : 0U;
+    m_protocol.recordFieldReused(usedBytesAfter - usedBytesBefore);
+    return result;
 }
 
 bool FieldImpl::updateName()
@@ -24,11 +24,14 @@
 #include "XmlWrap.h"
 #include "Logger.h"
 #include "Object.h"
+#include "StringPool.h"
 
 namespace commsdsl
 {
 
 class ProtocolImpl;
+class CacheWriter;
+class CacheReader;
 class FieldImpl : public Object
 {
     using Base = Object;
@@ -36,17 +39,15 @@ public:
     using Ptr = std::unique_ptr<FieldImpl>;
     using PropsMap = XmlWrap::PropsMap;
     using ContentsList = XmlWrap::ContentsList;
-    using FieldsList = std::vector<Ptr>;
+    using FieldsList = ArenaVector<Ptr>;
     using Kind = Field::Kind;
     using SemanticType = Field::SemanticType;
 
     virtual ~FieldImpl() = default;
 
     static Ptr create(const std::string& kind, ::xmlNodePtr node, ProtocolImpl& protocol);
-    Ptr clone() const
-    {
-        return cloneImpl();
-    }
+    static Ptr createFromCache(CacheReader& reader, ProtocolImpl& protocol);
+    Ptr clone() const;
 
     ::xmlNodePtr getNode() const
     {
@@ -129,7 +130,7 @@ public:
 
     static bool validateMembersNames(
             const FieldsList& fields,
-            Logger& logger);
+            const Logger& logger);
 
     bool validateMembersNames(const FieldsList& fields);
 
@@ -227,6 +228,18 @@ public:
 
     std::string schemaPos() const;
 
+    void collectDependencies(const DependencyReportFunc& func) const;
+
+    void releaseNodes();
+    static void releaseNodesList(const FieldsList& fields);
+    static void releaseNodesOptional(const Ptr& field);
+
+    void writeCache(CacheWriter& writer) const;
+    static void writeCacheList(CacheWriter& writer, const FieldsList& fields);
+    static bool readCacheList(CacheReader& reader, ProtocolImpl& protocol, FieldsList& fields);
+    static void writeCacheOptional(CacheWriter& writer, const Ptr& field);
+    static bool readCacheOptional(CacheReader& reader, ProtocolImpl& protocol, Ptr& field);
+
 protected:
     FieldImpl(::xmlNodePtr node, ProtocolImpl& protocol);
     FieldImpl(const FieldImpl&);
@@ -241,15 +254,8 @@ protected:
         return m_protocol;
     }
 
-    void setName(const std::string& val)
-    {
-        m_state.m_name = val;
-    }
-
-    void setDisplayName(const std::string& val)
-    {
-        m_state.m_displayName = val;
-    }
+    void setName(const std::string& val);
+    void setDisplayName(const std::string& val);
 
     void setSemanticType(SemanticType val)
     {
@@ -283,6 +289,10 @@ protected:
     virtual bool validateBitLengthValueImpl(::xmlNodePtr node, std::size_t bitLength) const;
     virtual bool verifySemanticTypeImpl(::xmlNodePtr node, SemanticType type) const;
     virtual bool verifyAliasedMemberImpl(const std::string& fieldName) const;
+    virtual void collectDependenciesImpl(const DependencyReportFunc& func) const;
+    virtual void releaseNodesImpl();
+    virtual void writeCacheImpl(CacheWriter& writer) const;
+    virtual bool readCacheImpl(CacheReader& reader);
 
     bool validateSinglePropInstance(const std::string& str, bool mustHave = false);
     bool validateNoPropInstance(const std::string& str);
@@ -291,6 +301,11 @@ protected:
             std::string &value,
             bool mustHave = false,
             bool allowDeref = false);
+    bool validateAndUpdateStringPropValue(
+            const std::string& str,
+            InternedString &value,
+            bool mustHave = false,
+            bool allowDeref = false);
     void reportUnexpectedPropertyValue(const std::string& propName, const std::string& propValue);
     bool validateAndUpdateBoolPropValue(const std::string& propName, bool& value, bool mustHave = false);
 
@@ -338,9 +353,9 @@ private:
 
     struct ReusableState
     {
-        std::string m_name;
-        std::string m_displayName;
-        std::string m_description;
+        InternedString m_name;
+        InternedString m_displayName;
+        InternedString m_description;
         PropsMap m_extraAttrs;
         ContentsList m_extraChildren;
         SemanticType m_semanticType = SemanticType::None;
@@ -368,12 +383,14 @@ private:
     bool updateExtraChildren(const XmlWrap::NamesList& names);
 
     bool verifyName() const;
+    bool readCache(CacheReader& reader);
 
     static const CreateMap& createMap();
 
     ::xmlNodePtr m_node = nullptr;
     ProtocolImpl& m_protocol;
     PropsMap m_props;
+    ArenaString m_schemaPos;
     ReusableState m_state;
 };
 
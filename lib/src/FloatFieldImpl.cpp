@@ -25,6 +25,8 @@
 #include "common.h"
 #include "util.h"
 #include "ProtocolImpl.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
@@ -121,9 +123,9 @@ bool FloatFieldImpl::hasNonUniqueSpecials() const
 
 
     std::vector<double> specValues;
-    specValues.reserve(m_state.m_specials.size());
+    specValues.reserve(m_state.m_specials->size());
 
-    for (auto& s : m_state.m_specials) {
+    for (auto& s : m_state.m_specials.get()) {
         if (std::isnan(s.second.m_value)) {
             continue;
         }
@@ -131,7 +133,7 @@ bool FloatFieldImpl::hasNonUniqueSpecials() const
         specValues.push_back(s.second.m_value);
     }
 
-    if ((specValues.size() + 1U) < m_state.m_specials.size()) {
+    if ((specValues.size() + 1U) < m_state.m_specials->size()) {
         // More than one NaN inside
         return true;
     }
@@ -239,8 +241,8 @@ bool FloatFieldImpl::strToFpImpl(const std::string& ref, double& val) const
         return true;
     }
 
-    auto iter = m_state.m_specials.find(ref);
-    if (iter == m_state.m_specials.end()) {
+    auto iter = m_state.m_specials->find(ref);
+    if (iter == m_state.m_specials->end()) {
         return false;
     }
 
@@ -382,6 +384,7 @@ bool FloatFieldImpl::updateValidCheckVersion()
 
 bool FloatFieldImpl::updateValidRanges()
 {
+    auto prevRangesCount = m_state.m_validRanges->size();
     auto attrs = XmlWrap::parseNodeProps(getNode());
     bool result =
         checkFullRangeProps(attrs) &&
@@ -393,10 +396,17 @@ bool FloatFieldImpl::updateValidRanges()
         return false;
     }
 
+    if (m_state.m_validRanges->size() == prevRangesCount) {
+        // Nothing new, keep sharing the (already sorted) reused ranges
+        return true;
+    }
+
+    auto& validRanges = m_state.m_validRanges.modify();
+
     // sort by version
     assert(std::isinf(-std::numeric_limits<double>::infinity()));
     std::sort(
-        m_state.m_validRanges.begin(), m_state.m_validRanges.end(),
+        validRanges.begin(), validRanges.end(),
         [](auto& elem1, auto& elem2)
         {
             assert(elem1.m_deprecatedSince != 0U);
@@ -421,12 +431,12 @@ bool FloatFieldImpl::updateValidRanges()
         });
 
     // Merge
-    for (auto iter = m_state.m_validRanges.begin(); iter != m_state.m_validRanges.end(); ++iter) {
+    for (auto iter = validRanges.begin(); iter != validRanges.end(); ++iter) {
         if (iter->m_deprecatedSince == 0U) {
             continue;
         }
 
-        for (auto nextIter = iter + 1; nextIter != m_state.m_validRanges.end(); ++nextIter) {
+        for (auto nextIter = iter + 1; nextIter != validRanges.end(); ++nextIter) {
             if (nextIter->m_deprecatedSince == 0U) {
                 continue;
             }
@@ -452,17 +462,17 @@ bool FloatFieldImpl::updateValidRanges()
     }
 
     // Remove invalid
-    m_state.m_validRanges.erase(
-        std::remove_if(m_state.m_validRanges.begin(), m_state.m_validRanges.end(),
+    validRanges.erase(
+        std::remove_if(validRanges.begin(), validRanges.end(),
                     [](auto& elem)
                     {
                         return elem.m_deprecatedSince == 0U;
                     }),
-        m_state.m_validRanges.end());
+        validRanges.end());
 
     // Sort by min/max value
     std::sort(
-        m_state.m_validRanges.begin(), m_state.m_validRanges.end(),
+        validRanges.begin(), validRanges.end(),
         [](auto& elem1, auto& elem2)
         {
             assert(elem1.m_deprecatedSince != 0U);
@@ -556,8 +566,8 @@ bool FloatFieldImpl::updateSpecials()
             return false;
         }
 
-        auto specialsIter = m_state.m_specials.find(nameIter->second);
-        if (specialsIter != m_state.m_specials.end()) {
+        auto specialsIter = m_state.m_specials->find(nameIter->second);
+        if (specialsIter != m_state.m_specials->end()) {
             logError() << XmlWrap::logPrefix(s) << "Special with name \"" << nameIter->second <<
                           "\" was already assigned to \"" << name() << "\" element.";
             return false;
@@ -632,7 +642,7 @@ bool FloatFieldImpl::updateSpecials()
             info.m_displayName = displayNameIter->second;
         }
 
-        m_state.m_specials.emplace(nameIter->second, info);
+        m_state.m_specials.modify().emplace(nameIter->second, info);
     }
 
     return true;
@@ -708,7 +718,7 @@ bool FloatFieldImpl::checkFullRangeAsAttr(const FieldImpl::PropsMap& xmlAttrs)
     info.m_max = m_state.m_typeAllowedMaxValue;
     info.m_sinceVersion = getSinceVersion();
     info.m_deprecatedSince = getDeprecated();
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -740,7 +750,7 @@ bool FloatFieldImpl::checkFullRangeAsChild(::xmlNodePtr child)
         return false;
     }
 
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -779,7 +789,7 @@ bool FloatFieldImpl::checkValidRangeAsAttr(const FieldImpl::PropsMap& xmlAttrs)
 
     info.m_sinceVersion = getSinceVersion();
     info.m_deprecatedSince = getDeprecated();
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -802,7 +812,7 @@ bool FloatFieldImpl::checkValidRangeAsChild(::xmlNodePtr child)
         return false;
     }
 
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -838,7 +848,7 @@ bool FloatFieldImpl::checkValidValueAsAttr(const FieldImpl::PropsMap& xmlAttrs)
     info.m_sinceVersion = getSinceVersion();
     info.m_deprecatedSince = getDeprecated();
 
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -863,7 +873,7 @@ bool FloatFieldImpl::checkValidValueAsChild(::xmlNodePtr child)
         return false;
     }
 
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -899,7 +909,7 @@ bool FloatFieldImpl::checkValidMinAsAttr(const FieldImpl::PropsMap& xmlAttrs)
     info.m_sinceVersion = getSinceVersion();
     info.m_deprecatedSince = getDeprecated();
 
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -924,7 +934,7 @@ bool FloatFieldImpl::checkValidMinAsChild(::xmlNodePtr child)
         return false;
     }
 
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -960,7 +970,7 @@ bool FloatFieldImpl::checkValidMaxAsAttr(const FieldImpl::PropsMap& xmlAttrs)
     info.m_sinceVersion = getSinceVersion();
     info.m_deprecatedSince = getDeprecated();
 
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -985,7 +995,7 @@ bool FloatFieldImpl::checkValidMaxAsChild(::xmlNodePtr child)
         return false;
     }
 
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -1077,8 +1087,8 @@ bool FloatFieldImpl::strToValue(
         }
 
         if (common::isValidName(str)) {
-            auto iter = m_state.m_specials.find(str);
-            if (iter != m_state.m_specials.end()) {
+            auto iter = m_state.m_specials->find(str);
+            if (iter != m_state.m_specials->end()) {
                 val = iter->second.m_value;
                 return true;
             }
@@ -1100,4 +1110,93 @@ bool FloatFieldImpl::strToValue(
     return ok;
 }
 
+void FloatFieldImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    writer.writeEnum(m_state.m_type);
+    writer.writeEnum(m_state.m_endian);
+    writer.writeUnsigned(m_state.m_length);
+    writer.writeDouble(m_state.m_typeAllowedMinValue);
+    writer.writeDouble(m_state.m_typeAllowedMaxValue);
+    writer.writeDouble(m_state.m_defaultValue);
+    m_state.m_validRanges.writeCache(
+        writer,
+        [&writer](const ValidRangesList& validRanges)
+        {
+            writer.writeUnsigned(validRanges.size());
+            for (auto& r : validRanges) {
+                writer.writeDouble(r.m_min);
+                writer.writeDouble(r.m_max);
+                writer.writeUnsigned(r.m_sinceVersion);
+                writer.writeUnsigned(r.m_deprecatedSince);
+            }
+        });
+
+    m_state.m_specials.writeCache(
+        writer,
+        [&writer](const SpecialValues& specials)
+        {
+            writer.writeUnsigned(specials.size());
+            for (auto& s : specials) {
+                writer.writeString(s.first);
+                writer.writeDouble(s.second.m_value);
+                writer.writeUnsigned(s.second.m_sinceVersion);
+                writer.writeUnsigned(s.second.m_deprecatedSince);
+                writer.writeString(s.second.m_description);
+                writer.writeString(s.second.m_displayName);
+            }
+        });
+
+    writer.writeEnum(m_state.m_units);
+    writer.writeUnsigned(m_state.m_displayDecimals);
+    writer.writeBool(m_state.m_validCheckVersion);
+    writer.writeBool(m_state.m_nonUniqueSpecialsAllowed);
+    writer.writeBool(m_state.m_displaySpecials);
+}
+
+bool FloatFieldImpl::readCacheImpl(CacheReader& reader)
+{
+    m_state.m_type = reader.readEnum<Type>();
+    m_state.m_endian = reader.readEnum<Endian>();
+    m_state.m_length = reader.readUnsigned<std::size_t>();
+    m_state.m_typeAllowedMinValue = reader.readDouble();
+    m_state.m_typeAllowedMaxValue = reader.readDouble();
+    m_state.m_defaultValue = reader.readDouble();
+    m_state.m_validRanges.readCache(
+        reader,
+        [&reader](ValidRangesList& validRanges)
+        {
+            validRanges.resize(reader.readSize());
+            for (auto& r : validRanges) {
+                r.m_min = reader.readDouble();
+                r.m_max = reader.readDouble();
+                r.m_sinceVersion = reader.readUnsigned<unsigned>();
+                r.m_deprecatedSince = reader.readUnsigned<unsigned>();
+            }
+        });
+
+    m_state.m_specials.readCache(
+        reader,
+        [&reader](SpecialValues& specials)
+        {
+            auto specialsCount = reader.readSize();
+            for (auto idx = 0U; idx < specialsCount; ++idx) {
+                auto name = reader.readString();
+                SpecialValueInfo info;
+                info.m_value = reader.readDouble();
+                info.m_sinceVersion = reader.readUnsigned<unsigned>();
+                info.m_deprecatedSince = reader.readUnsigned<unsigned>();
+                info.m_description = reader.readString();
+                info.m_displayName = reader.readString();
+                specials.insert(specials.end(), std::make_pair(std::move(name), std::move(info)));
+            }
+        });
+
+    m_state.m_units = reader.readEnum<Units>();
+    m_state.m_displayDecimals = reader.readUnsigned<unsigned>();
+    m_state.m_validCheckVersion = reader.readBool();
+    m_state.m_nonUniqueSpecialsAllowed = reader.readBool();
+    m_state.m_displaySpecials = reader.readBool();
+    return reader.ok();
+}
+
 } // namespace commsdsl
@@ -21,6 +21,7 @@
 
 #include "commsdsl/Endian.h"
 #include "commsdsl/FloatField.h"
+#include "CowData.h"
 #include "FieldImpl.h"
 
 namespace commsdsl
@@ -58,12 +59,12 @@ public:
 
     const ValidRangesList& validRanges() const
     {
-        return m_state.m_validRanges;
+        return m_state.m_validRanges.get();
     }
 
     const SpecialValues& specialValues() const
     {
-        return m_state.m_specials;
+        return m_state.m_specials.get();
     }
 
     bool validCheckVersion() const
@@ -98,6 +99,8 @@ protected:
     virtual std::size_t minLengthImpl() const override;
     virtual bool isComparableToValueImpl(const std::string& val) const override;
     virtual bool strToFpImpl(const std::string& ref, double& val) const override;
+    virtual void writeCacheImpl(CacheWriter& writer) const override;
+    virtual bool readCacheImpl(CacheReader& reader) override;
 
 private:
     bool updateType();
@@ -143,8 +146,8 @@ private:
         double m_typeAllowedMinValue = 0.0;
         double m_typeAllowedMaxValue = 0.0;
         double m_defaultValue = 0.0;
-        ValidRangesList m_validRanges;
-        SpecialValues m_specials;
+        CowData<ValidRangesList> m_validRanges;
+        CowData<SpecialValues> m_specials;
         Units m_units = Units::Unknown;
         unsigned m_displayDecimals = 0U;
         bool m_validCheckVersion = false;
@@ -47,7 +47,7 @@ const std::string& Frame::description() const
     return m_pImpl->description();
 }
 
-Frame::LayersList Frame::layers() const
+const Frame::LayersList& Frame::layers() const
 {
     assert(m_pImpl != nullptr);
     return m_pImpl->layersList();
@@ -25,6 +25,8 @@
 #include "ProtocolImpl.h"
 #include "NamespaceImpl.h"
 #include "common.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
@@ -47,6 +49,19 @@ FrameImpl::FrameImpl(::xmlNodePtr node, ProtocolImpl& protocol)
     m_name(&common::emptyString()),
     m_description(&common::emptyString())
 {
+    if ((node != nullptr) && protocol.isStreamParsing()) {
+        auto pos = XmlWrap::logPrefix(node);
+        m_schemaPos.assign(pos.begin(), pos.end());
+    }
+}
+
+std::string FrameImpl::schemaPos() const
+{
+    if ((!m_schemaPos.empty()) || (m_node == nullptr)) {
+        return std::string(m_schemaPos.begin(), m_schemaPos.end());
+    }
+
+    return XmlWrap::logPrefix(m_node);
 }
 
 bool FrameImpl::parse()
@@ -77,17 +92,31 @@ const std::string& FrameImpl::description() const
     return *m_description;
 }
 
-FrameImpl::LayersList FrameImpl::layersList() const
+void FrameImpl::collectDependencies(const DependencyReportFunc& func) const
 {
-    LayersList result;
-    result.reserve(m_layers.size());
+    for (auto& l : m_layers) {
+        l->collectDependencies(func);
+    }
+}
+
+void FrameImpl::releaseNodes()
+{
+    m_node = nullptr;
+    for (auto& l : m_layers) {
+        l->releaseNodes();
+    }
+}
+
+void FrameImpl::cacheLists()
+{
+    m_layersList.clear();
+    m_layersList.reserve(m_layers.size());
     std::transform(
-        m_layers.begin(), m_layers.end(), std::back_inserter(result),
-        [](auto& f)
+        m_layers.begin(), m_layers.end(), std::back_inserter(m_layersList),
+        [](auto& l)
         {
-            return Layer(f.get());
+            return Layer(l.get());
         });
-    return result;
 }
 
 std::string FrameImpl::externalRef() const
@@ -95,6 +124,10 @@ std::string FrameImpl::externalRef() const
     assert(getParent() != nullptr);
     assert(getParent()->objKind() == ObjKind::Namespace);
 
+    if (!internedExternalRef().empty()) {
+        return internedExternalRef();
+    }
+
     auto& ns = static_cast<const commsdsl::NamespaceImpl&>(*getParent());
     auto nsRef = ns.externalRef();
     if (nsRef.empty()) {
@@ -317,5 +350,26 @@ bool FrameImpl::updateExtraChildren()
     return true;
 }
 
+void FrameImpl::writeCache(CacheWriter& writer) const
+{
+    writeObjectCache(writer);
+    writer.writeProps(m_props);
+    writer.writeProps(m_extraAttrs);
+    writer.writeContents(m_extraChildren);
+    writer.writePropRef(m_props, m_name);
+    writer.writePropRef(m_props, m_description);
+    LayerImpl::writeCacheList(writer, m_layers);
+}
+
+bool FrameImpl::readCache(CacheReader& reader)
+{
+    readObjectCache(reader);
+    m_props = reader.readProps();
+    m_extraAttrs = reader.readProps();
+    m_extraChildren = reader.readContents();
+    m_name = reader.readPropRef(m_props);
+    m_description = reader.readPropRef(m_props);
+    return LayerImpl::readCacheList(reader, m_protocol, m_layers);
+}
 
 } // namespace commsdsl
@@ -50,6 +50,8 @@ public:
         return m_node;
     }
 
+    std::string schemaPos() const;
+
     bool parse();
 
     const PropsMap& props() const
@@ -60,10 +62,18 @@ public:
     const std::string& name() const;
     const std::string& description() const;
 
-    LayersList layersList() const;
+    const LayersList& layersList() const
+    {
+        return m_layersList;
+    }
+
+    void cacheLists();
 
     std::string externalRef() const;
 
+    void collectDependencies(const DependencyReportFunc& func) const;
+    void releaseNodes();
+
     const PropsMap& extraAttributes() const
     {
         return m_extraAttrs;
@@ -74,6 +84,9 @@ public:
         return m_extraChildren;
     }
 
+    void writeCache(CacheWriter& writer) const;
+    bool readCache(CacheReader& reader);
+
 protected:
 
     virtual ObjKind objKindImpl() const override;
@@ -98,13 +111,15 @@ private:
 
     ::xmlNodePtr m_node = nullptr;
     ProtocolImpl& m_protocol;
+    ArenaString m_schemaPos;
     PropsMap m_props;
     PropsMap m_extraAttrs;
     ContentsList m_extraChildren;
 
     const std::string* m_name = nullptr;
     const std::string* m_description = nullptr;
-    std::vector<LayerImplPtr> m_layers;
+    LayerImpl::LayersList m_layers;
+    LayersList m_layersList;
 };
 
 using FrameImplPtr = FrameImpl::Ptr;
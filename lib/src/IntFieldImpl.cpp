@@ -26,6 +26,8 @@
 #include "ProtocolImpl.h"
 #include "RefFieldImpl.h"
 #include "util.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
@@ -443,8 +445,8 @@ bool IntFieldImpl::strToNumericImpl(const std::string& ref, std::intmax_t& val,
         return true;
     }
 
-    auto iter = m_state.m_specials.find(ref);
-    if (iter == m_state.m_specials.end()) {
+    auto iter = m_state.m_specials->find(ref);
+    if (iter == m_state.m_specials->end()) {
         return false;
     }
 
@@ -890,6 +892,7 @@ bool IntFieldImpl::updateValidCheckVersion()
 
 bool IntFieldImpl::updateValidRanges()
 {
+    auto prevRangesCount = m_state.m_validRanges->size();
     auto attrs = XmlWrap::parseNodeProps(getNode());
     bool result =
         checkValidRangeProps(attrs) &&
@@ -900,10 +903,17 @@ bool IntFieldImpl::updateValidRanges()
         return false;
     }
 
+    if (m_state.m_validRanges->size() == prevRangesCount) {
+        // Nothing new, keep sharing the (already sorted) reused ranges
+        return true;
+    }
+
+    auto& validRanges = m_state.m_validRanges.modify();
+
     // Sort by version first
     bool bigUnsigned = isBigUnsigned(m_state.m_type);
     std::sort(
-        m_state.m_validRanges.begin(), m_state.m_validRanges.end(),
+        validRanges.begin(), validRanges.end(),
         [bigUnsigned](auto& elem1, auto& elem2)
         {
             assert(elem1.m_deprecatedSince != 0U);
@@ -932,12 +942,12 @@ bool IntFieldImpl::updateValidRanges()
         });
 
     // Merge
-    for (auto iter = m_state.m_validRanges.begin(); iter != m_state.m_validRanges.end(); ++iter) {
+    for (auto iter = validRanges.begin(); iter != validRanges.end(); ++iter) {
         if (iter->m_deprecatedSince == 0U) {
             continue;
         }
 
-        for (auto nextIter = iter + 1; nextIter != m_state.m_validRanges.end(); ++nextIter) {
+        for (auto nextIter = iter + 1; nextIter != validRanges.end(); ++nextIter) {
             if (nextIter->m_deprecatedSince == 0U) {
                 continue;
             }
@@ -955,17 +965,17 @@ bool IntFieldImpl::updateValidRanges()
     }
 
     // Remove invalid
-    m_state.m_validRanges.erase(
-        std::remove_if(m_state.m_validRanges.begin(), m_state.m_validRanges.end(),
+    validRanges.erase(
+        std::remove_if(validRanges.begin(), validRanges.end(),
                     [](auto& elem)
                     {
                         return elem.m_deprecatedSince == 0U;
                     }),
-        m_state.m_validRanges.end());
+        validRanges.end());
 
     // Sort by min/max value
     std::sort(
-        m_state.m_validRanges.begin(), m_state.m_validRanges.end(),
+        validRanges.begin(), validRanges.end(),
         [bigUnsigned](auto& elem1, auto& elem2)
         {
             assert(elem1.m_deprecatedSince != 0U);
@@ -1061,8 +1071,8 @@ bool IntFieldImpl::updateSpecials()
             return false;
         }
 
-        auto specialsIter = m_state.m_specials.find(nameIter->second);
-        if (specialsIter != m_state.m_specials.end()) {
+        auto specialsIter = m_state.m_specials->find(nameIter->second);
+        if (specialsIter != m_state.m_specials->end()) {
             logError() << XmlWrap::logPrefix(s) << "Special with name \"" << nameIter->second <<
                           "\" was already assigned to \"" << name() << "\" element.";
             return false;
@@ -1141,7 +1151,7 @@ bool IntFieldImpl::updateSpecials()
             info.m_displayName = displayNameIter->second;
         }
 
-        m_state.m_specials.emplace(nameIter->second, info);
+        m_state.m_specials.modify().emplace(nameIter->second, info);
     }
 
     return true;
@@ -1251,7 +1261,7 @@ bool IntFieldImpl::checkValidRangeAsAttr(const FieldImpl::PropsMap& xmlAttrs)
 
     info.m_sinceVersion = getSinceVersion();
     info.m_deprecatedSince = getDeprecated();
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -1274,7 +1284,7 @@ bool IntFieldImpl::checkValidRangeAsChild(::xmlNodePtr child)
         return false;
     }
 
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -1310,7 +1320,7 @@ bool IntFieldImpl::checkValidValueAsAttr(const FieldImpl::PropsMap& xmlAttrs)
     info.m_sinceVersion = getSinceVersion();
     info.m_deprecatedSince = getDeprecated();
 
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -1335,7 +1345,7 @@ bool IntFieldImpl::checkValidValueAsChild(::xmlNodePtr child)
         return false;
     }
 
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -1371,7 +1381,7 @@ bool IntFieldImpl::checkValidMinAsAttr(const FieldImpl::PropsMap& xmlAttrs)
     info.m_sinceVersion = getSinceVersion();
     info.m_deprecatedSince = getDeprecated();
 
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -1396,7 +1406,7 @@ bool IntFieldImpl::checkValidMinAsChild(::xmlNodePtr child)
         return false;
     }
 
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -1432,7 +1442,7 @@ bool IntFieldImpl::checkValidMaxAsAttr(const FieldImpl::PropsMap& xmlAttrs)
     info.m_sinceVersion = getSinceVersion();
     info.m_deprecatedSince = getDeprecated();
 
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -1457,7 +1467,7 @@ bool IntFieldImpl::checkValidMaxAsChild(::xmlNodePtr child)
         return false;
     }
 
-    m_state.m_validRanges.push_back(info);
+    m_state.m_validRanges.modify().push_back(info);
     return true;
 }
 
@@ -1587,8 +1597,8 @@ bool IntFieldImpl::strToValue(
 {
     if (common::isValidName(str)) {
         // Check among specials
-        auto iter = m_state.m_specials.find(str);
-        if (iter != m_state.m_specials.end()) {
+        auto iter = m_state.m_specials->find(str);
+        if (iter != m_state.m_specials->end()) {
             val = iter->second.m_value;
             return true;
         }
@@ -1629,4 +1639,109 @@ bool IntFieldImpl::strToValue(
 }
 
 
+void IntFieldImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    writer.writeEnum(m_state.m_type);
+    writer.writeEnum(m_state.m_endian);
+    writer.writeUnsigned(m_state.m_length);
+    writer.writeUnsigned(m_state.m_bitLength);
+    writer.writeSigned(m_state.m_serOffset);
+    writer.writeSigned(m_state.m_typeAllowedMinValue);
+    writer.writeSigned(m_state.m_typeAllowedMaxValue);
+    writer.writeSigned(m_state.m_minValue);
+    writer.writeSigned(m_state.m_maxValue);
+    writer.writeSigned(m_state.m_defaultValue);
+    writer.writeSigned(m_state.m_scaling.first);
+    writer.writeSigned(m_state.m_scaling.second);
+    m_state.m_validRanges.writeCache(
+        writer,
+        [&writer](const ValidRangesList& validRanges)
+        {
+            writer.writeUnsigned(validRanges.size());
+            for (auto& r : validRanges) {
+                writer.writeSigned(r.m_min);
+                writer.writeSigned(r.m_max);
+                writer.writeUnsigned(r.m_sinceVersion);
+                writer.writeUnsigned(r.m_deprecatedSince);
+            }
+        });
+
+    m_state.m_specials.writeCache(
+        writer,
+        [&writer](const SpecialValues& specials)
+        {
+            writer.writeUnsigned(specials.size());
+            for (auto& s : specials) {
+                writer.writeString(s.first);
+                writer.writeSigned(s.second.m_value);
+                writer.writeUnsigned(s.second.m_sinceVersion);
+                writer.writeUnsigned(s.second.m_deprecatedSince);
+                writer.writeString(s.second.m_description);
+                writer.writeString(s.second.m_displayName);
+            }
+        });
+
+    writer.writeEnum(m_state.m_units);
+    writer.writeUnsigned(m_state.m_displayDecimals);
+    writer.writeSigned(m_state.m_displayOffset);
+    writer.writeBool(m_state.m_validCheckVersion);
+    writer.writeBool(m_state.m_signExt);
+    writer.writeBool(m_state.m_nonUniqueSpecialsAllowed);
+    writer.writeBool(m_state.m_displaySpecials);
+}
+
+bool IntFieldImpl::readCacheImpl(CacheReader& reader)
+{
+    m_state.m_type = reader.readEnum<Type>();
+    m_state.m_endian = reader.readEnum<Endian>();
+    m_state.m_length = reader.readUnsigned<std::size_t>();
+    m_state.m_bitLength = reader.readUnsigned<std::size_t>();
+    m_state.m_serOffset = reader.readSigned();
+    m_state.m_typeAllowedMinValue = reader.readSigned();
+    m_state.m_typeAllowedMaxValue = reader.readSigned();
+    m_state.m_minValue = reader.readSigned();
+    m_state.m_maxValue = reader.readSigned();
+    m_state.m_defaultValue = reader.readSigned();
+    m_state.m_scaling.first = reader.readSigned();
+    m_state.m_scaling.second = reader.readSigned();
+    m_state.m_validRanges.readCache(
+        reader,
+        [&reader](ValidRangesList& validRanges)
+        {
+            validRanges.resize(reader.readSize());
+            for (auto& r : validRanges) {
+                r.m_min = reader.readSigned();
+                r.m_max = reader.readSigned();
+                r.m_sinceVersion = reader.readUnsigned<unsigned>();
+                r.m_deprecatedSince = reader.readUnsigned<unsigned>();
+            }
+        });
+
+    m_state.m_specials.readCache(
+        reader,
+        [&reader](SpecialValues& specials)
+        {
+            auto specialsCount = reader.readSize();
+            for (auto idx = 0U; idx < specialsCount; ++idx) {
+                auto name = reader.readString();
+                SpecialValueInfo info;
+                info.m_value = reader.readSigned();
+                info.m_sinceVersion = reader.readUnsigned<unsigned>();
+                info.m_deprecatedSince = reader.readUnsigned<unsigned>();
+                info.m_description = reader.readString();
+                info.m_displayName = reader.readString();
+                specials.insert(specials.end(), std::make_pair(std::move(name), std::move(info)));
+            }
+        });
+
+    m_state.m_units = reader.readEnum<Units>();
+    m_state.m_displayDecimals = reader.readUnsigned<unsigned>();
+    m_state.m_displayOffset = reader.readSigned();
+    m_state.m_validCheckVersion = reader.readBool();
+    m_state.m_signExt = reader.readBool();
+    m_state.m_nonUniqueSpecialsAllowed = reader.readBool();
+    m_state.m_displaySpecials = reader.readBool();
+    return reader.ok();
+}
+
 } // namespace commsdsl
@@ -22,6 +22,7 @@
 #include "commsdsl/Endian.h"
 #include "commsdsl/IntField.h"
 #include "commsdsl/Units.h"
+#include "CowData.h"
 #include "FieldImpl.h"
 
 namespace commsdsl
@@ -79,12 +80,12 @@ public:
 
     const ValidRangesList& validRanges() const
     {
-        return m_state.m_validRanges;
+        return m_state.m_validRanges.get();
     }
 
     const SpecialValues& specialValues() const
     {
-        return m_state.m_specials;
+        return m_state.m_specials.get();
     }
 
     bool validCheckVersion() const
@@ -147,6 +148,8 @@ protected:
     virtual bool strToNumericImpl(const std::string& ref, std::intmax_t& val, bool& isBigUnsigned) const override;
     virtual bool validateBitLengthValueImpl(::xmlNodePtr node, std::size_t bitLength) const override;
     virtual bool verifySemanticTypeImpl(::xmlNodePtr node, SemanticType type) const override;
+    virtual void writeCacheImpl(CacheWriter& writer) const override;
+    virtual bool readCacheImpl(CacheReader& reader) override;
 
 private:
     bool updateType();
@@ -195,8 +198,8 @@ private:
         std::intmax_t m_maxValue = 0;
         std::intmax_t m_defaultValue = 0;
         ScalingRatio m_scaling;
-        ValidRangesList m_validRanges;
-        SpecialValues m_specials;
+        CowData<ValidRangesList> m_validRanges;
+        CowData<SpecialValues> m_specials;
         Units m_units = Units::Unknown;
         unsigned m_displayDecimals = 0U;
         std::intmax_t m_displayOffset = 0U;
@@ -47,13 +47,13 @@ const std::string& Interface::description() const
     return m_pImpl->description();
 }
 
-Interface::FieldsList Interface::fields() const
+const Interface::FieldsList& Interface::fields() const
 {
     assert(m_pImpl != nullptr);
     return m_pImpl->fieldsList();
 }
 
-Interface::AliasesList Interface::aliases() const
+const Interface::AliasesList& Interface::aliases() const
 {
     assert(m_pImpl != nullptr);
     return m_pImpl->aliasesList();
@@ -25,6 +25,8 @@
 #include "ProtocolImpl.h"
 #include "NamespaceImpl.h"
 #include "common.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 #include "OptionalFieldImpl.h"
 
 namespace commsdsl
@@ -48,10 +50,24 @@ InterfaceImpl::InterfaceImpl(::xmlNodePtr node, ProtocolImpl& protocol)
     m_name(&common::emptyString()),
     m_description(&common::emptyString())
 {
+    if ((node != nullptr) && protocol.isStreamParsing()) {
+        auto pos = XmlWrap::logPrefix(node);
+        m_schemaPos.assign(pos.begin(), pos.end());
+    }
+}
+
+std::string InterfaceImpl::schemaPos() const
+{
+    if ((!m_schemaPos.empty()) || (m_node == nullptr)) {
+        return std::string(m_schemaPos.begin(), m_schemaPos.end());
+    }
+
+    return XmlWrap::logPrefix(m_node);
 }
 
 bool InterfaceImpl::parse()
 {
+    ValueRefsScope valueRefsScope(*this);
     m_props = XmlWrap::parseNodeProps(m_node);
 
     if (!XmlWrap::parseChildrenAsProps(m_node, commonProps(), m_protocol.logger(), m_props)) {
@@ -81,30 +97,48 @@ const std::string& InterfaceImpl::description() const
     return *m_description;
 }
 
-InterfaceImpl::FieldsList InterfaceImpl::fieldsList() const
+void InterfaceImpl::collectDependencies(const DependencyReportFunc& func) const
+{
+    auto iter = m_props.find(common::copyFieldsFromStr());
+    if (iter != m_props.end()) {
+        auto* interface = m_protocol.findInterface(iter->second, false);
+        if (interface != nullptr) {
+            func(DependencyKind::CopyFieldsFrom, *interface);
+        }
+    }
+
+    reportValueRefs(func);
+    for (auto& f : m_fields) {
+        f->collectDependencies(func);
+    }
+}
+
+void InterfaceImpl::releaseNodes()
 {
-    FieldsList result;
-    result.reserve(m_fields.size());
+    m_node = nullptr;
+    FieldImpl::releaseNodesList(m_fields);
+    AliasImpl::releaseNodesList(m_aliases);
+}
+
+void InterfaceImpl::cacheLists()
+{
+    m_fieldsList.clear();
+    m_fieldsList.reserve(m_fields.size());
     std::transform(
-        m_fields.begin(), m_fields.end(), std::back_inserter(result),
+        m_fields.begin(), m_fields.end(), std::back_inserter(m_fieldsList),
         [](auto& f)
         {
             return Field(f.get());
         });
-    return result;
-}
 
-InterfaceImpl::AliasesList InterfaceImpl::aliasesList() const
-{
-    AliasesList result;
-    result.reserve(m_aliases.size());
+    m_aliasesList.clear();
+    m_aliasesList.reserve(m_aliases.size());
     std::transform(
-        m_aliases.begin(), m_aliases.end(), std::back_inserter(result),
+        m_aliases.begin(), m_aliases.end(), std::back_inserter(m_aliasesList),
         [](auto& a)
         {
             return Alias(a.get());
         });
-    return result;
 }
 
 std::string InterfaceImpl::externalRef() const
@@ -112,6 +146,10 @@ std::string InterfaceImpl::externalRef() const
     assert(getParent() != nullptr);
     assert(getParent()->objKind() == ObjKind::Namespace);
 
+    if (!internedExternalRef().empty()) {
+        return internedExternalRef();
+    }
+
     auto& ns = static_cast<const commsdsl::NamespaceImpl&>(*getParent());
     auto nsRef = ns.externalRef();
     if (nsRef.empty()) {
@@ -472,5 +510,29 @@ bool InterfaceImpl::updateExtraChildren()
     return true;
 }
 
+void InterfaceImpl::writeCache(CacheWriter& writer) const
+{
+    writeObjectCache(writer);
+    writer.writeProps(m_props);
+    writer.writeProps(m_extraAttrs);
+    writer.writeContents(m_extraChildren);
+    writer.writePropRef(m_props, m_name);
+    writer.writePropRef(m_props, m_description);
+    FieldImpl::writeCacheList(writer, m_fields);
+    AliasImpl::writeCacheList(writer, m_aliases);
+}
+
+bool InterfaceImpl::readCache(CacheReader& reader)
+{
+    readObjectCache(reader);
+    m_props = reader.readProps();
+    m_extraAttrs = reader.readProps();
+    m_extraChildren = reader.readContents();
+    m_name = reader.readPropRef(m_props);
+    m_description = reader.readPropRef(m_props);
+    return
+        FieldImpl::readCacheList(reader, m_protocol, m_fields) &&
+        AliasImpl::readCacheList(reader, m_protocol, m_aliases);
+}
 
 } // namespace commsdsl
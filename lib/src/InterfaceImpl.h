@@ -52,6 +52,8 @@ public:
         return m_node;
     }
 
+    std::string schemaPos() const;
+
     bool parse();
 
     const PropsMap& props() const
@@ -63,11 +65,23 @@ public:
     const std::string& displayName() const;
     const std::string& description() const;
 
-    FieldsList fieldsList() const;
-    AliasesList aliasesList() const;
+    const FieldsList& fieldsList() const
+    {
+        return m_fieldsList;
+    }
+
+    const AliasesList& aliasesList() const
+    {
+        return m_aliasesList;
+    }
+
+    void cacheLists();
 
     std::string externalRef() const;
 
+    void collectDependencies(const DependencyReportFunc& func) const;
+    void releaseNodes();
+
     const PropsMap& extraAttributes() const
     {
         return m_extraAttrs;
@@ -80,6 +94,9 @@ public:
 
     std::size_t findFieldIdx(const std::string& name) const;
 
+    void writeCache(CacheWriter& writer) const;
+    bool readCache(CacheReader& reader);
+
 protected:
 
     virtual ObjKind objKindImpl() const override;
@@ -108,6 +125,7 @@ private:
 
     ::xmlNodePtr m_node = nullptr;
     ProtocolImpl& m_protocol;
+    ArenaString m_schemaPos;
     PropsMap m_props;
     PropsMap m_extraAttrs;
     ContentsList m_extraChildren;
@@ -115,8 +133,10 @@ private:
     const std::string* m_name = nullptr;
     const std::string* m_description = nullptr;
     const InterfaceImpl* m_copyFieldsFromInterface = nullptr;
-    std::vector<FieldImplPtr> m_fields;
-    std::vector<AliasImplPtr> m_aliases;
+    FieldImpl::FieldsList m_fields;
+    AliasImpl::AliasesList m_aliases;
+    FieldsList m_fieldsList;
+    AliasesList m_aliasesList;
 };
 
 using InterfaceImplPtr = InterfaceImpl::Ptr;
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <set>
 #include <iterator>
+#include <type_traits>
 
 #include "ProtocolImpl.h"
 #include "NamespaceImpl.h"
@@ -31,10 +32,40 @@
 #include "ChecksumLayerImpl.h"
 #include "ValueLayerImpl.h"
 #include "CustomLayerImpl.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
 
+namespace
+{
+
+const std::string& kindToStr(Layer::Kind kind)
+{
+    static const std::string* Map[] = {
+        /* Custom */ &common::customStr(),
+        /* Sync */ &common::syncStr(),
+        /* Size */ &common::sizeStr(),
+        /* Id */ &common::idStr(),
+        /* Value */ &common::valueStr(),
+        /* Payload */ &common::payloadStr(),
+        /* Checksum */ &common::checksumStr(),
+    };
+
+    static const std::size_t MapSize = std::extent<decltype(Map)>::value;
+    static_assert(MapSize == static_cast<std::size_t>(Layer::Kind::NumOfValues), "Invalid map");
+
+    auto idx = static_cast<std::size_t>(kind);
+    if (MapSize <= idx) {
+        return common::emptyString();
+    }
+
+    return *Map[idx];
+}
+
+} // namespace
+
 LayerImpl::Ptr LayerImpl::create(
     const std::string& kind,
     ::xmlNodePtr node,
@@ -50,6 +81,17 @@ LayerImpl::Ptr LayerImpl::create(
     return iter->second(node, protocol);
 }
 
+LayerImpl::Ptr LayerImpl::createFromCache(CacheReader& reader, ProtocolImpl& protocol)
+{
+    auto kind = reader.readEnum<Kind>();
+    auto layer = create(kindToStr(kind), nullptr, protocol);
+    if ((!layer) || (!layer->readCache(reader))) {
+        return Ptr();
+    }
+
+    return layer;
+}
+
 bool LayerImpl::parse()
 {
     m_props = XmlWrap::parseNodeProps(m_node);
@@ -132,6 +174,63 @@ XmlWrap::NamesList LayerImpl::supportedTypes()
     return result;
 }
 
+void LayerImpl::collectDependencies(const DependencyReportFunc& func) const
+{
+    if (m_extField != nullptr) {
+        func(DependencyKind::Field, *m_extField);
+    }
+    else if (m_field) {
+        m_field->collectDependencies(func);
+    }
+
+    collectDependenciesImpl(func);
+}
+
+void LayerImpl::releaseNodes()
+{
+    m_node = nullptr;
+    FieldImpl::releaseNodesOptional(m_field);
+}
+
+void LayerImpl::writeCache(CacheWriter& writer) const
+{
+    writer.writeEnum(kind());
+    writeObjectCache(writer);
+    writer.writeProps(m_props);
+    writer.writePropRef(m_props, m_name);
+    writer.writePropRef(m_props, m_description);
+    writer.writeObjectRef(m_extField);
+    FieldImpl::writeCacheOptional(writer, m_field);
+    writer.writeProps(m_extraAttrs);
+    writer.writeContents(m_extraChildren);
+    writeCacheImpl(writer);
+}
+
+void LayerImpl::writeCacheList(CacheWriter& writer, const LayersList& layers)
+{
+    writer.writeUnsigned(layers.size());
+    for (auto& l : layers) {
+        l->writeCache(writer);
+    }
+}
+
+bool LayerImpl::readCacheList(CacheReader& reader, ProtocolImpl& protocol, LayersList& layers)
+{
+    auto count = reader.readSize();
+    layers.clear();
+    layers.reserve(count);
+    for (auto idx = 0U; idx < count; ++idx) {
+        auto layer = createFromCache(reader, protocol);
+        if (!layer) {
+            return false;
+        }
+
+        layers.push_back(std::move(layer));
+    }
+
+    return reader.ok();
+}
+
 LayerImpl::LayerImpl(::xmlNodePtr node, ProtocolImpl& protocol)
   : m_node(node),
     m_protocol(protocol),
@@ -181,6 +280,22 @@ bool LayerImpl::mustHaveFieldImpl() const
     return true;
 }
 
+void LayerImpl::collectDependenciesImpl(const DependencyReportFunc& func) const
+{
+    static_cast<void>(func);
+}
+
+void LayerImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    static_cast<void>(writer);
+}
+
+bool LayerImpl::readCacheImpl(CacheReader& reader)
+{
+    static_cast<void>(reader);
+    return true;
+}
+
 bool LayerImpl::validateSinglePropInstance(const std::string& str, bool mustHave)
 {
     return XmlWrap::validateSinglePropInstance(m_node, m_props, str, protocol().logger(), mustHave);
@@ -492,8 +607,7 @@ bool LayerImpl::checkFieldAsChild()
             break;
         }
 
-        auto attrs = XmlWrap::parseNodeProps(getNode());
-        if (attrs.find(common::fieldsStr()) != attrs.end()) {
+        if (XmlWrap::hasProp(getNode(), common::fieldsStr())) {
             logError() << "There must be only one occurance of \"" << common::fieldStr() << "\" definition.";
             return false;
         }
@@ -523,6 +637,22 @@ bool LayerImpl::checkFieldAsChild()
     return true;
 }
 
+bool LayerImpl::readCache(CacheReader& reader)
+{
+    readObjectCache(reader);
+    m_props = reader.readProps();
+    m_name = reader.readPropRef(m_props);
+    m_description = reader.readPropRef(m_props);
+    reader.readObjectRef(m_extField);
+    if (!FieldImpl::readCacheOptional(reader, m_protocol, m_field)) {
+        return false;
+    }
+
+    m_extraAttrs = reader.readProps();
+    m_extraChildren = reader.readContents();
+    return readCacheImpl(reader) && reader.ok();
+}
+
 const LayerImpl::CreateMap& LayerImpl::createMap()
 {
     static const CreateMap Map = {
@@ -30,6 +30,8 @@ namespace commsdsl
 {
 
 class ProtocolImpl;
+class CacheWriter;
+class CacheReader;
 class LayerImpl : public Object
 {
     using Base = Object;
@@ -37,12 +39,13 @@ public:
     using Ptr = std::unique_ptr<LayerImpl>;
     using PropsMap = XmlWrap::PropsMap;
     using ContentsList = XmlWrap::ContentsList;
-    using LayersList = std::vector<Ptr>;
+    using LayersList = ArenaVector<Ptr>;
     using Kind = Layer::Kind;
 
     virtual ~LayerImpl() = default;
 
     static Ptr create(const std::string& kind, ::xmlNodePtr node, ProtocolImpl& protocol);
+    static Ptr createFromCache(CacheReader& reader, ProtocolImpl& protocol);
 
     ::xmlNodePtr getNode() const
     {
@@ -110,6 +113,12 @@ public:
         return m_extraChildren;
     }
 
+    void collectDependencies(const DependencyReportFunc& func) const;
+    void releaseNodes();
+
+    void writeCache(CacheWriter& writer) const;
+    static void writeCacheList(CacheWriter& writer, const LayersList& layers);
+    static bool readCacheList(CacheReader& reader, ProtocolImpl& protocol, LayersList& layers);
 
 protected:
     LayerImpl(::xmlNodePtr node, ProtocolImpl& protocol);
@@ -135,6 +144,9 @@ protected:
     virtual bool parseImpl();
     virtual bool verifyImpl(const LayersList& layers);
     virtual bool mustHaveFieldImpl() const;
+    virtual void collectDependenciesImpl(const DependencyReportFunc& func) const;
+    virtual void writeCacheImpl(CacheWriter& writer) const;
+    virtual bool readCacheImpl(CacheReader& reader);
 
     bool validateSinglePropInstance(const std::string& str, bool mustHave = false);
     bool validateAndUpdateStringPropValue(const std::string& str, const std::string*& valuePtr, bool mustHave = false);
@@ -160,6 +172,7 @@ private:
     bool updateExtraChildren(const XmlWrap::NamesList& names);
     bool checkFieldFromRef();
     bool checkFieldAsChild();
+    bool readCache(CacheReader& reader);
 
     static const CreateMap& createMap();
 
@@ -24,6 +24,8 @@
 #include "common.h"
 #include "ProtocolImpl.h"
 #include "IntFieldImpl.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
@@ -486,8 +488,7 @@ bool ListFieldImpl::checkElementAsChild()
             return false;
         }
 
-        auto attrs = XmlWrap::parseNodeProps(getNode());
-        if (attrs.find(common::fieldsStr()) != attrs.end()) {
+        if (XmlWrap::hasProp(getNode(), common::fieldsStr())) {
             logError() << "There must be only one occurance of \"" << common::elementStr() << "\" definition.";
             return false;
         }
@@ -696,4 +697,68 @@ bool ListFieldImpl::verifySiblingsForPrefix(
     return true;    
 }
 
+void ListFieldImpl::collectDependenciesImpl(const DependencyReportFunc& func) const
+{
+    auto collectFunc =
+        [&func](DependencyKind kind, const FieldImpl* extField, const FieldImplPtr& field)
+        {
+            if (extField != nullptr) {
+                func(kind, *extField);
+                return;
+            }
+
+            if (field) {
+                field->collectDependencies(func);
+            }
+        };
+
+    collectFunc(DependencyKind::Element, m_state.m_extElementField, m_elementField);
+    collectFunc(DependencyKind::CountPrefix, m_state.m_extCountPrefixField, m_countPrefixField);
+    collectFunc(DependencyKind::LengthPrefix, m_state.m_extLengthPrefixField, m_lengthPrefixField);
+    collectFunc(DependencyKind::ElemLengthPrefix, m_state.m_extElemLengthPrefixField, m_elemLengthPrefixField);
+}
+
+void ListFieldImpl::releaseNodesImpl()
+{
+    releaseNodesOptional(m_elementField);
+    releaseNodesOptional(m_countPrefixField);
+    releaseNodesOptional(m_lengthPrefixField);
+    releaseNodesOptional(m_elemLengthPrefixField);
+}
+
+void ListFieldImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    writer.writeUnsigned(m_state.m_count);
+    writer.writeObjectRef(m_state.m_extElementField);
+    writer.writeObjectRef(m_state.m_extCountPrefixField);
+    writer.writeObjectRef(m_state.m_extLengthPrefixField);
+    writer.writeObjectRef(m_state.m_extElemLengthPrefixField);
+    writer.writeString(m_state.m_detachedCountPrefixField);
+    writer.writeString(m_state.m_detachedLengthPrefixField);
+    writer.writeString(m_state.m_detachedElemLengthPrefixField);
+    writer.writeBool(m_state.m_elemFixedLength);
+    writeCacheOptional(writer, m_elementField);
+    writeCacheOptional(writer, m_countPrefixField);
+    writeCacheOptional(writer, m_lengthPrefixField);
+    writeCacheOptional(writer, m_elemLengthPrefixField);
+}
+
+bool ListFieldImpl::readCacheImpl(CacheReader& reader)
+{
+    m_state.m_count = reader.readUnsigned<std::size_t>();
+    reader.readObjectRef(m_state.m_extElementField);
+    reader.readObjectRef(m_state.m_extCountPrefixField);
+    reader.readObjectRef(m_state.m_extLengthPrefixField);
+    reader.readObjectRef(m_state.m_extElemLengthPrefixField);
+    m_state.m_detachedCountPrefixField = reader.readString();
+    m_state.m_detachedLengthPrefixField = reader.readString();
+    m_state.m_detachedElemLengthPrefixField = reader.readString();
+    m_state.m_elemFixedLength = reader.readBool();
+    return
+        readCacheOptional(reader, protocol(), m_elementField) &&
+        readCacheOptional(reader, protocol(), m_countPrefixField) &&
+        readCacheOptional(reader, protocol(), m_lengthPrefixField) &&
+        readCacheOptional(reader, protocol(), m_elemLengthPrefixField);
+}
+
 } // namespace commsdsl
@@ -131,6 +131,10 @@ protected:
     virtual bool verifySiblingsImpl(const FieldsList& fields) const override;
     virtual std::size_t minLengthImpl() const override;
     virtual std::size_t maxLengthImpl() const override;
+    virtual void collectDependenciesImpl(const DependencyReportFunc& func) const override;
+    virtual void releaseNodesImpl() override;
+    virtual void writeCacheImpl(CacheWriter& writer) const override;
+    virtual bool readCacheImpl(CacheReader& reader) override;
 
 private:
     void cloneFields(const ListFieldImpl& other);
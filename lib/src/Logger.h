@@ -16,6 +16,7 @@
 #pragma once
 
 #include <sstream>
+#include <mutex>
 
 #include "commsdsl/ErrorLevel.h"
 #include "commsdsl/Protocol.h"
@@ -38,77 +39,127 @@ public:
 
     ~Logger() = default;
 
+    class Redirect
+    {
+    public:
+        explicit Redirect(const Logger& logger)
+          : m_prev(current())
+        {
+            current() = &logger;
+        }
+
+        ~Redirect()
+        {
+            current() = m_prev;
+        }
+
+        Redirect(const Redirect&) = delete;
+        Redirect& operator=(const Redirect&) = delete;
+
+    private:
+        const Logger* m_prev = nullptr;
+    };
+
+    static const Logger* redirected()
+    {
+        return current();
+    }
+
     void setMinLevel(ErrorLevel val)
     {
         m_minLevel = val;
     }
 
-    void setCurrLevel(ErrorLevel val)
+    bool isEnabled(ErrorLevel level) const
     {
-        m_currLevel = val;
+        return m_minLevel <= level;
     }
 
-    void flush()
+    void report(ErrorLevel level, const std::string& msg) const
     {
-        if (m_minLevel <= m_currLevel) {
-            m_func(m_currLevel, m_stream.str());
-            m_stream = std::stringstream();
+        if (!isEnabled(level)) {
+            return;
         }
+
+        // The logger is shared by the concurrent readers of the validated model,
+        // don't let the reports interleave.
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_func(level, msg);
     }
 
-    template <typename T>
-    Logger& operator<<(T&& val)
+private:
+    static const Logger*& current()
     {
-        if (m_minLevel <= m_currLevel) {
-            m_stream << std::forward<T>(val);
-        }
-        return *this;
+        // Reporting on the worker threads goes to their own loggers
+        thread_local const Logger* Current = nullptr;
+        return Current;
     }
 
-private:
     ErrorLevel m_minLevel = ErrorLevel_Debug;
-    ErrorLevel m_currLevel = ErrorLevel_Debug;
     ReportFunc m_func;
-
-    std::stringstream m_stream;
+    mutable std::mutex m_mutex;
 };
 
+// Every report is composed in its own stream, the logger itself
+// doesn't keep any state of the message being composed.
 class LogWrapper
 {
 public:
-    LogWrapper(Logger& logger) : m_logger(logger) {}
-    ~LogWrapper() { m_logger.flush(); }
+    LogWrapper(const Logger& logger, ErrorLevel level)
+      : m_logger(logger),
+        m_level(level),
+        m_enabled(logger.isEnabled(level))
+    {
+    }
+
+    LogWrapper(LogWrapper&& other)
+      : m_logger(other.m_logger),
+        m_level(other.m_level),
+        m_enabled(other.m_enabled),
+        m_stream(std::move(other.m_stream))
+    {
+        other.m_enabled = false;
+    }
+
+    ~LogWrapper()
+    {
+        if (m_enabled) {
+            m_logger.report(m_level, m_stream.str());
+        }
+    }
 
     template <typename T>
     LogWrapper& operator<<(T&& val)
     {
-        m_logger << std::forward<T>(val);
+        if (m_enabled) {
+            m_stream << std::forward<T>(val);
+        }
         return *this;
     }
 
 private:
-    Logger& m_logger;
+    const Logger& m_logger;
+    ErrorLevel m_level = ErrorLevel_Debug;
+    bool m_enabled = false;
+    std::stringstream m_stream;
 };
 
 inline
-LogWrapper logError(Logger& logger)
+LogWrapper logError(const Logger& logger)
 {
-    logger.setCurrLevel(ErrorLevel_Error);
-    return LogWrapper(logger);
+    return LogWrapper(logger, ErrorLevel_Error);
 }
 
 inline
-LogWrapper logWarning(Logger& logger)
+LogWrapper logWarning(const Logger& logger)
 {
-    logger.setCurrLevel(ErrorLevel_Warning);
-    return LogWrapper(logger);
+    return LogWrapper(logger, ErrorLevel_Warning);
 }
 
 inline
-LogWrapper logInfo(Logger& logger)
+LogWrapper logInfo(const Logger& logger)
 {
-    logger.setCurrLevel(ErrorLevel_Info);
-    return LogWrapper(logger);
+    return LogWrapper(logger, ErrorLevel_Info);
 }
 
 } // namespace commsdsl
@@ -0,0 +1,105 @@
+//
+// Copyright 2018 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "MappedFile.h"
+
+#include <fstream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define COMMSDSL_HAS_MMAP
+#endif
+
+#ifdef COMMSDSL_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace commsdsl
+{
+
+MappedFile::MappedFile(const std::string& path)
+{
+    // Fall back to reading the file into memory where mapping
+    // is not available or fails.
+    m_valid = map(path) || read(path);
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef COMMSDSL_HAS_MMAP
+    if (m_mapped) {
+        ::munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+}
+
+bool MappedFile::map(const std::string& path)
+{
+#ifdef COMMSDSL_HAS_MMAP
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    do {
+        struct stat info;
+        if ((::fstat(fd, &info) != 0) ||
+            (!S_ISREG(info.st_mode)) ||
+            (info.st_size <= 0)) {
+            // Empty files cannot be mapped, they are read instead.
+            break;
+        }
+
+        auto size = static_cast<std::size_t>(info.st_size);
+        auto* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            break;
+        }
+
+        m_data = static_cast<const char*>(addr);
+        m_size = size;
+        m_mapped = true;
+    } while (false);
+
+    ::close(fd);
+    return m_mapped;
+#else
+    static_cast<void>(path);
+    return false;
+#endif
+}
+
+bool MappedFile::read(const std::string& path)
+{
+    std::ifstream stream(path, std::ios_base::binary);
+    if (!stream) {
+        return false;
+    }
+
+    m_buf.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    if (stream.bad()) {
+        m_buf.clear();
+        return false;
+    }
+
+    m_data = m_buf.data();
+    m_size = m_buf.size();
+    return true;
+}
+
+} // namespace commsdsl
@@ -95,13 +95,13 @@ bool Message::isDeprecatedRemoved() const
     return m_pImpl->isDeprecatedRemoved();
 }
 
-Message::FieldsList Message::fields() const
+const Message::FieldsList& Message::fields() const
 {
     assert(m_pImpl != nullptr);
     return m_pImpl->fieldsList();
 }
 
-Message::AliasesList Message::aliases() const
+const Message::AliasesList& Message::aliases() const
 {
     assert(m_pImpl != nullptr);
     return m_pImpl->aliasesList();
@@ -25,6 +25,8 @@
 #include "ProtocolImpl.h"
 #include "NamespaceImpl.h"
 #include "common.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 #include "OptionalFieldImpl.h"
 
 namespace commsdsl
@@ -46,10 +48,31 @@ MessageImpl::MessageImpl(::xmlNodePtr node, ProtocolImpl& protocol)
   : m_node(node),
     m_protocol(protocol)
 {
+    if ((node != nullptr) && protocol.isStreamParsing()) {
+        auto pos = XmlWrap::logPrefix(node);
+        m_schemaPos.assign(pos.begin(), pos.end());
+    }
+}
+
+std::string MessageImpl::schemaPos() const
+{
+    if ((!m_schemaPos.empty()) || (m_node == nullptr)) {
+        return std::string(m_schemaPos.begin(), m_schemaPos.end());
+    }
+
+    return XmlWrap::logPrefix(m_node);
 }
 
 bool MessageImpl::parse()
 {
+    return
+        parseProps() &&
+        parseFields();
+}
+
+bool MessageImpl::parseProps()
+{
+    ValueRefsScope valueRefsScope(*this);
     m_props = XmlWrap::parseNodeProps(m_node);
 
     if (!XmlWrap::parseChildrenAsProps(m_node, commonProps(), m_protocol.logger(), m_props)) {
@@ -65,7 +88,14 @@ bool MessageImpl::parse()
         updateVersions() &&
         updatePlatforms() &&
         updateCustomizable() &&
-        updateSender() &&
+        updateSender();
+}
+
+bool MessageImpl::parseFields()
+{
+    ValueRefsScope valueRefsScope(*this);
+    m_fieldsParsed = true;
+    return
         copyFields() &&
         updateFields() &&
         copyAliases() &&
@@ -74,6 +104,11 @@ bool MessageImpl::parse()
         updateExtraChildren();
 }
 
+bool MessageImpl::hasCopyFieldsFrom() const
+{
+    return m_props.find(common::copyFieldsFromStr()) != m_props.end();
+}
+
 const std::string& MessageImpl::name() const
 {
     return m_name;
@@ -113,30 +148,48 @@ std::size_t MessageImpl::maxLength() const
     return soFar;
 }
 
-MessageImpl::FieldsList MessageImpl::fieldsList() const
+void MessageImpl::collectDependencies(const DependencyReportFunc& func) const
+{
+    auto iter = m_props.find(common::copyFieldsFromStr());
+    if (iter != m_props.end()) {
+        auto* msg = m_protocol.findMessage(iter->second, false);
+        if (msg != nullptr) {
+            func(DependencyKind::CopyFieldsFrom, *msg);
+        }
+    }
+
+    reportValueRefs(func);
+    for (auto& f : m_fields) {
+        f->collectDependencies(func);
+    }
+}
+
+void MessageImpl::releaseNodes()
 {
-    FieldsList result;
-    result.reserve(m_fields.size());
+    m_node = nullptr;
+    FieldImpl::releaseNodesList(m_fields);
+    AliasImpl::releaseNodesList(m_aliases);
+}
+
+void MessageImpl::cacheLists()
+{
+    m_fieldsList.clear();
+    m_fieldsList.reserve(m_fields.size());
     std::transform(
-        m_fields.begin(), m_fields.end(), std::back_inserter(result),
+        m_fields.begin(), m_fields.end(), std::back_inserter(m_fieldsList),
         [](auto& f)
         {
             return Field(f.get());
         });
-    return result;
-}
 
-MessageImpl::AliasesList MessageImpl::aliasesList() const
-{
-    AliasesList result;
-    result.reserve(m_aliases.size());
+    m_aliasesList.clear();
+    m_aliasesList.reserve(m_aliases.size());
     std::transform(
-        m_aliases.begin(), m_aliases.end(), std::back_inserter(result),
+        m_aliases.begin(), m_aliases.end(), std::back_inserter(m_aliasesList),
         [](auto& a)
         {
             return Alias(a.get());
         });
-    return result;
 }
 
 std::string MessageImpl::externalRef() const
@@ -144,6 +197,10 @@ std::string MessageImpl::externalRef() const
     assert(getParent() != nullptr);
     assert(getParent()->objKind() == ObjKind::Namespace);
 
+    if (!internedExternalRef().empty()) {
+        return internedExternalRef();
+    }
+
     auto& ns = static_cast<const commsdsl::NamespaceImpl&>(*getParent());
     auto nsRef = ns.externalRef();
     if (nsRef.empty()) {
@@ -207,6 +264,21 @@ bool MessageImpl::validateAndUpdateStringPropValue(
     return true;
 }
 
+bool MessageImpl::validateAndUpdateStringPropValue(
+    const std::string& str,
+    InternedString& value,
+    bool mustHave,
+    bool allowDeref)
+{
+    std::string valueStr = value;
+    if (!validateAndUpdateStringPropValue(str, valueStr, mustHave, allowDeref)) {
+        return false;
+    }
+
+    value = m_protocol.intern(valueStr);
+    return true;
+}
+
 void MessageImpl::reportUnexpectedPropertyValue(const std::string& propName, const std::string& propValue)
 {
     XmlWrap::reportUnexpectedPropertyValue(m_node, common::messageStr(), propName, propValue, m_protocol.logger());
@@ -527,6 +599,10 @@ bool MessageImpl::copyFields()
         return false;
     }
 
+    if (!m_protocol.completeDeferredMessage(*m_copyFieldsFromMsg)) {
+        return false;
+    }
+
     cloneFieldsFrom(*m_copyFieldsFromMsg);
 
     if (!m_fields.empty()) {
@@ -769,5 +845,44 @@ bool MessageImpl::updateExtraChildren()
     return true;
 }
 
+void MessageImpl::writeCache(CacheWriter& writer) const
+{
+    writeObjectCache(writer);
+    writer.writeProps(m_props);
+    writer.writeProps(m_extraAttrs);
+    writer.writeContents(m_extraChildren);
+    writer.writeString(m_name);
+    writer.writeString(m_displayName);
+    writer.writeString(m_description);
+    writer.writeUnsigned(m_id);
+    writer.writeUnsigned(m_order);
+    FieldImpl::writeCacheList(writer, m_fields);
+    AliasImpl::writeCacheList(writer, m_aliases);
+    writer.writeContents(m_platforms);
+    writer.writeEnum(m_sender);
+    writer.writeBool(m_customizable);
+}
+
+bool MessageImpl::readCache(CacheReader& reader)
+{
+    readObjectCache(reader);
+    m_props = reader.readProps();
+    m_extraAttrs = reader.readProps();
+    m_extraChildren = reader.readContents();
+    m_name = m_protocol.intern(reader.readString());
+    m_displayName = m_protocol.intern(reader.readString());
+    m_description = m_protocol.intern(reader.readString());
+    m_id = reader.readUnsigned();
+    m_order = reader.readUnsigned<unsigned>();
+    if ((!FieldImpl::readCacheList(reader, m_protocol, m_fields)) ||
+        (!AliasImpl::readCacheList(reader, m_protocol, m_aliases))) {
+        return false;
+    }
+
+    m_platforms = reader.readContents();
+    m_sender = reader.readEnum<Sender>();
+    m_customizable = reader.readBool();
+    return reader.ok();
+}
 
 } // namespace commsdsl
@@ -54,7 +54,18 @@ public:
         return m_node;
     }
 
+    std::string schemaPos() const;
+
     bool parse();
+    bool parseProps();
+    bool parseFields();
+
+    bool fieldsParsed() const
+    {
+        return m_fieldsParsed;
+    }
+
+    bool hasCopyFieldsFrom() const;
 
     const PropsMap& props() const
     {
@@ -79,11 +90,23 @@ public:
 
     std::size_t maxLength() const;
 
-    FieldsList fieldsList() const;
-    AliasesList aliasesList() const;
+    const FieldsList& fieldsList() const
+    {
+        return m_fieldsList;
+    }
+
+    const AliasesList& aliasesList() const
+    {
+        return m_aliasesList;
+    }
+
+    void cacheLists();
 
     std::string externalRef() const;
 
+    void collectDependencies(const DependencyReportFunc& func) const;
+    void releaseNodes();
+
     const PropsMap& extraAttributes() const
     {
         return m_extraAttrs;
@@ -109,6 +132,9 @@ public:
         return m_sender;
     }
 
+    void writeCache(CacheWriter& writer) const;
+    bool readCache(CacheReader& reader);
+
 protected:
 
     virtual ObjKind objKindImpl() const override;
@@ -123,6 +149,7 @@ private:
 
     bool validateSinglePropInstance(const std::string& str, bool mustHave = false);
     bool validateAndUpdateStringPropValue(const std::string& str, std::string& value, bool mustHave = false, bool allowDeref = false);
+    bool validateAndUpdateStringPropValue(const std::string& str, InternedString& value, bool mustHave = false, bool allowDeref = false);
     void reportUnexpectedPropertyValue(const std::string& propName, const std::string& propValue);
     bool updateName();
     bool updateDescription();
@@ -144,21 +171,25 @@ private:
 
     ::xmlNodePtr m_node = nullptr;
     ProtocolImpl& m_protocol;
+    ArenaString m_schemaPos;
     PropsMap m_props;
     PropsMap m_extraAttrs;
     ContentsList m_extraChildren;
 
-    std::string m_name;
-    std::string m_displayName;
-    std::string m_description;
+    InternedString m_name;
+    InternedString m_displayName;
+    InternedString m_description;
     std::uintmax_t m_id = 0;
     unsigned m_order = 0;
-    std::vector<FieldImplPtr> m_fields;
-    std::vector<AliasImplPtr> m_aliases;
+    FieldImpl::FieldsList m_fields;
+    AliasImpl::AliasesList m_aliases;
+    FieldsList m_fieldsList;
+    AliasesList m_aliasesList;
     PlatformsList m_platforms;
     Sender m_sender = Sender::Both;
     const MessageImpl* m_copyFieldsFromMsg = nullptr;
     bool m_customizable = false;
+    bool m_fieldsParsed = false;
 };
 
 using MessageImplPtr = MessageImpl::Ptr;
@@ -48,31 +48,31 @@ const std::string& Namespace::description() const
     return m_pImpl->description();
 }
 
-Namespace::NamespacesList Namespace::namespaces() const
+const Namespace::NamespacesList& Namespace::namespaces() const
 {
     assert(m_pImpl != nullptr);
     return m_pImpl->namespacesList();
 }
 
-Namespace::FieldsList Namespace::fields() const
+const Namespace::FieldsList& Namespace::fields() const
 {
     assert(m_pImpl != nullptr);
     return m_pImpl->fieldsList();
 }
 
-Namespace::MessagesList Namespace::messages() const
+const Namespace::MessagesList& Namespace::messages() const
 {
     assert(m_pImpl != nullptr);
     return m_pImpl->messagesList();
 }
 
-Namespace::InterfacesList Namespace::interfaces() const
+const Namespace::InterfacesList& Namespace::interfaces() const
 {
     assert(m_pImpl != nullptr);
     return m_pImpl->interfacesList();
 }
 
-Namespace::FramesList Namespace::frames() const
+const Namespace::FramesList& Namespace::frames() const
 {
     assert(m_pImpl != nullptr);
     return m_pImpl->framesList();
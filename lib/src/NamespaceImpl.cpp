@@ -22,7 +22,10 @@
 #include <numeric>
 
 #include "common.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 #include "ProtocolImpl.h"
+#include "XmlStream.h"
 
 namespace commsdsl
 {
@@ -53,6 +56,65 @@ XmlWrap::NamesList allNames()
     return names;
 }
 
+// Schema position without the trailing separator
+std::string definedAt(const std::string& schemaPos)
+{
+    static const std::string Sep(": ");
+    if ((Sep.size() <= schemaPos.size()) &&
+        (schemaPos.compare(schemaPos.size() - Sep.size(), Sep.size(), Sep) == 0)) {
+        return schemaPos.substr(0, schemaPos.size() - Sep.size());
+    }
+
+    return schemaPos;
+}
+
+bool isDefinedIn(::xmlNodePtr node, const NamespaceImpl::DocsSet& docs)
+{
+    return (node != nullptr) && (docs.find(node->doc) != docs.end());
+}
+
+// The reader frees the streamed element after it has been processed
+template <typename TObj>
+void releaseStreamedNodes(const ProtocolImpl& protocol, TObj& obj)
+{
+    if (protocol.isStreamParsing()) {
+        obj.releaseNodes();
+    }
+}
+
+template <typename TMap>
+void eraseDefinedIn(TMap& map, const NamespaceImpl::DocsSet& docs)
+{
+    for (auto iter = map.begin(); iter != map.end();) {
+        assert(iter->second);
+        if (isDefinedIn(iter->second->getNode(), docs)) {
+            iter = map.erase(iter);
+            continue;
+        }
+
+        ++iter;
+    }
+}
+
+template <typename TList, typename TMap>
+TList sortedByName(const TMap& map)
+{
+    TList result;
+    result.reserve(map.size());
+    for (auto& elem : map) {
+        assert(elem.second);
+        result.emplace_back(elem.second.get());
+    }
+
+    std::sort(
+        result.begin(), result.end(),
+        [](auto& e1, auto& e2) {
+            return e1.name() < e2.name();
+        });
+
+    return result;
+}
+
 bool updateStringProperty(const XmlWrap::PropsMap& map, const std::string& name, std::string& prop)
 {
     auto iter = map.find(name);
@@ -65,6 +127,45 @@ bool updateStringProperty(const XmlWrap::PropsMap& map, const std::string& name,
     return true;
 }
 
+template <typename TMap>
+void writeCacheMap(CacheWriter& writer, const TMap& map)
+{
+    writer.writeUnsigned(map.size());
+    for (auto& elem : map) {
+        writer.writeString(elem.first);
+        elem.second->writeCache(writer);
+    }
+}
+
+template <typename TMap, typename TFunc>
+bool readCacheMap(CacheReader& reader, TMap& map, TFunc&& createFunc)
+{
+    auto count = reader.readSize();
+    map.clear();
+    for (auto idx = 0U; idx < count; ++idx) {
+        auto key = reader.readString();
+        auto obj = createFunc();
+        if (!obj) {
+            return false;
+        }
+
+        map.emplace_hint(map.end(), std::move(key), std::move(obj));
+    }
+
+    return reader.ok();
+}
+
+template <typename T>
+std::unique_ptr<T> createObjFromCache(CacheReader& reader, ProtocolImpl& protocol)
+{
+    std::unique_ptr<T> obj(new T(nullptr, protocol));
+    if (!obj->readCache(reader)) {
+        obj.reset();
+    }
+
+    return obj;
+}
+
 } // namespace
 
 NamespaceImpl::NamespaceImpl(::xmlNodePtr node, ProtocolImpl& protocol)
@@ -103,11 +204,11 @@ bool NamespaceImpl::parseProps()
     return true;
 }
 
-bool NamespaceImpl::parseChildren(NamespaceImpl* realNs)
+bool NamespaceImpl::parseChildren(::xmlNodePtr node)
 {
-    auto children = XmlWrap::getChildren(m_node, ChildrenNames);
+    auto children = XmlWrap::getChildren(node, ChildrenNames);
     for (auto* c : children) {
-        if (!processChild(c, realNs)) {
+        if (!processChild(c)) {
             return false;
         }
     }
@@ -125,12 +226,11 @@ bool NamespaceImpl::parse()
         return false;
     }
 
-    return parseChildren();
+    return parseChildren(m_node);
 }
 
-bool NamespaceImpl::processChild(::xmlNodePtr node, NamespaceImpl* realNs)
+bool NamespaceImpl::processChild(::xmlNodePtr node)
 {
-    using ProcessFunc = bool (NamespaceImpl::*)(::xmlNodePtr node);
     static const std::map<std::string, ProcessFunc> ParseFuncMap = {
         std::make_pair(common::nsStr(), &NamespaceImpl::processNamespace),
         std::make_pair(common::fieldsStr(), &NamespaceImpl::processMultipleFields),
@@ -148,103 +248,215 @@ bool NamespaceImpl::processChild(::xmlNodePtr node, NamespaceImpl* realNs)
         return false;
     }
 
-    if (realNs == nullptr) {
-        realNs = this;
-    }
     auto func = iter->second;
-    return (realNs->*func)(node);
+    return (this->*func)(node);
 }
 
-const XmlWrap::NamesList& NamespaceImpl::supportedChildren()
+bool NamespaceImpl::streamChild(XmlStream& stream, ::xmlNodePtr skeletonParent)
 {
-    return ChildrenNames;
+    auto* node = stream.node();
+    std::string cName(reinterpret_cast<const char*>(node->name));
+    if (cName == common::nsStr()) {
+        Ptr ns(new NamespaceImpl(stream.copyElement(skeletonParent), m_protocol));
+        ns->setParent(this);
+        return
+            streamNamespace(
+                stream,
+                std::move(ns),
+                [this](Ptr childNs)
+                {
+                    return addNamespace(std::move(childNs));
+                });
+    }
+
+    if ((cName == common::fieldsStr()) ||
+        (cName == common::messagesStr()) ||
+        (cName == common::interfacesStr()) ||
+        (cName == common::framesStr())) {
+        return
+            stream.forEachChild(
+                [this, &stream, &cName]()
+                {
+                    auto* child = stream.expand();
+                    bool result = (child != nullptr) && processMultipleChild(cName, child);
+                    stream.skip();
+                    return result;
+                });
+    }
+
+    auto* child = stream.expand();
+    bool result = (child != nullptr) && processChild(child);
+    stream.skip();
+    return result;
 }
 
-NamespaceImpl::NamespacesList NamespaceImpl::namespacesList() const
+bool NamespaceImpl::streamNamespace(XmlStream& stream, Ptr ns, AddNamespaceFunc&& addFunc)
 {
-    NamespacesList result;
-    result.reserve(m_namespaces.size());
-    for (auto& n : m_namespaces) {
-        assert(n.second);
-        result.emplace_back(n.second.get());
+    auto* skeleton = ns->getNode();
+    auto& protocol = ns->m_protocol;
+    NamespaceImpl* realNs = nullptr;
+    std::unique_ptr<::xmlNode, decltype(&::xmlFreeNode)> lateProps(nullptr, &::xmlFreeNode);
+    bool result =
+        stream.processChildren(
+            skeleton,
+            ChildrenNames,
+            protocol.logger(),
+            [&ns, &realNs, &addFunc]()
+            {
+                if (!ns->parseProps()) {
+                    return false;
+                }
+
+                realNs = addFunc(std::move(ns));
+                return realNs != nullptr;
+            },
+            [&stream, &realNs, skeleton]()
+            {
+                return realNs->streamChild(stream, skeleton);
+            },
+            [&realNs, &lateProps, skeleton](::xmlNodePtr node)
+            {
+                // Properties following the definitions are merged at the end,
+                // the name is required earlier.
+                if (common::nameStr() == reinterpret_cast<const char*>(node->name)) {
+                    return false;
+                }
+
+                if (!lateProps) {
+                    lateProps.reset(::xmlDocCopyNode(skeleton, skeleton->doc, 0));
+                    auto* namePtr = reinterpret_cast<const xmlChar*>(realNs->name().c_str());
+                    ::xmlNewProp(lateProps.get(), reinterpret_cast<const xmlChar*>(common::nameStr().c_str()), namePtr);
+                }
+
+                ::xmlAddChild(lateProps.get(), ::xmlDocCopyNode(node, skeleton->doc, 1));
+                return true;
+            });
+
+    if ((!result) || (!lateProps)) {
+        return result;
     }
 
-    std::sort(
-        result.begin(), result.end(),
-        [](auto& e1, auto& e2) {
-            return e1.name() < e2.name();
-        });
+    NamespaceImpl late(lateProps.get(), protocol);
+    if (!late.parseProps()) {
+        return false;
+    }
 
-    return result;
+    realNs->mergeProps(late);
+    return true;
 }
 
-NamespaceImpl::FieldsList NamespaceImpl::fieldsList() const
+void NamespaceImpl::mergeProps(const NamespaceImpl& other)
 {
-    FieldsList result;
-    result.reserve(m_fields.size());
-    for (auto& f : m_fields) {
-        assert(f.second);
-        result.emplace_back(f.second.get());
+    if ((!other.description().empty()) &&
+        (other.description() != description())) {
+        if (description().empty()) {
+            updateDescription(other.description());
+        }
+        else {
+            logWarning() << XmlWrap::logPrefix(other.getNode()) <<
+                "Description of namespace \"" << other.name() << "\" differs to "
+                "one encountered before.";
+        }
     }
 
-    std::sort(
-        result.begin(), result.end(),
-        [](auto& e1, auto& e2) {
-            return e1.name() < e2.name();
-        });
+    for (auto& a : other.extraAttributes()) {
+        auto attIter = m_extraAttrs.find(a.first);
+        if (attIter == m_extraAttrs.end()) {
+            m_extraAttrs.insert(a);
+        }
+        else if (a.second != attIter->second) {
+            logWarning() << XmlWrap::logPrefix(other.getNode()) <<
+                "Value of attribute \"" << a.first << "\" differs to one defined before.";
+        }
+    }
 
-    return result;
+    m_extraChildren.insert(m_extraChildren.end(), other.extraChildren().begin(), other.extraChildren().end());
 }
 
-NamespaceImpl::MessagesList NamespaceImpl::messagesList() const
+const XmlWrap::NamesList& NamespaceImpl::supportedChildren()
 {
-    MessagesList result;
-    result.reserve(m_messages.size());
-    for (auto& m : m_messages) {
-        assert(m.second);
-        result.emplace_back(m.second.get());
+    return ChildrenNames;
+}
+
+void NamespaceImpl::removeDefinedIn(const DocsSet& docs)
+{
+    eraseDefinedIn(m_namespaces, docs);
+    for (auto& n : m_namespaces) {
+        n.second->removeDefinedIn(docs);
     }
 
-    std::sort(
-        result.begin(), result.end(),
-        [](auto& e1, auto& e2) {
-            return e1.name() < e2.name();
-        });    
-    return result;
+    eraseDefinedIn(m_fields, docs);
+    eraseDefinedIn(m_messages, docs);
+    eraseDefinedIn(m_interfaces, docs);
+    eraseDefinedIn(m_frames, docs);
+}
+
+bool NamespaceImpl::empty() const
+{
+    return
+        m_namespaces.empty() &&
+        m_fields.empty() &&
+        m_messages.empty() &&
+        m_interfaces.empty() &&
+        m_frames.empty();
 }
 
-NamespaceImpl::InterfacesList NamespaceImpl::interfacesList() const
+void NamespaceImpl::cacheLists()
 {
-    InterfacesList result;
-    result.reserve(m_interfaces.size());
-    for (auto& m : m_interfaces) {
-        assert(m.second);
-        result.emplace_back(m.second.get());
+    for (auto& n : m_namespaces) {
+        n.second->cacheLists();
     }
 
-    std::sort(
-        result.begin(), result.end(),
-        [](auto& e1, auto& e2) {
-            return e1.name() < e2.name();
-        });    
-    return result;
+    for (auto& m : m_messages) {
+        m.second->cacheLists();
+    }
+
+    for (auto& i : m_interfaces) {
+        i.second->cacheLists();
+    }
+
+    for (auto& f : m_frames) {
+        f.second->cacheLists();
+    }
+
+    m_namespacesList = sortedByName<NamespacesList>(m_namespaces);
+    m_fieldsList = sortedByName<FieldsList>(m_fields);
+    m_messagesList = sortedByName<MessagesList>(m_messages);
+    m_interfacesList = sortedByName<InterfacesList>(m_interfaces);
+    m_framesList = sortedByName<FramesList>(m_frames);
 }
 
-NamespaceImpl::FramesList NamespaceImpl::framesList() const
+void NamespaceImpl::collectDependencies(const ElementDependencyFunc& func) const
 {
-    FramesList result;
-    result.reserve(m_frames.size());
-    for (auto& m : m_frames) {
-        assert(m.second);
-        result.emplace_back(m.second.get());
+    for (auto& n : m_namespaces) {
+        n.second->collectDependencies(func);
     }
 
-    std::sort(
-        result.begin(), result.end(),
-        [](auto& e1, auto& e2) {
-            return e1.name() < e2.name();
-        });    
-    return result;
+    auto collectFunc =
+        [&func](const auto& elem)
+        {
+            elem.collectDependencies(
+                [&func, &elem](DependencyKind kind, const Object& obj)
+                {
+                    func(elem, kind, obj);
+                });
+        };
+
+    for (auto& f : m_fields) {
+        collectFunc(*f.second);
+    }
+
+    for (auto& m : m_messages) {
+        collectFunc(*m.second);
+    }
+
+    for (auto& i : m_interfaces) {
+        collectFunc(*i.second);
+    }
+
+    for (auto& f : m_frames) {
+        collectFunc(*f.second);
+    }
 }
 
 const FieldImpl* NamespaceImpl::findField(const std::string& fieldName) const
@@ -298,6 +510,10 @@ std::string NamespaceImpl::externalRef() const
         return name();
     }
 
+    if (!internedExternalRef().empty()) {
+        return internedExternalRef();
+    }
+
     auto& parentNs = static_cast<const NamespaceImpl&>(*getParent());
     auto parentRef = parentNs.externalRef();
     assert(!parentRef.empty());
@@ -326,79 +542,28 @@ unsigned NamespaceImpl::countMessageIds() const
             });
 }
 
-bool NamespaceImpl::strToNumeric(const std::string& ref, std::intmax_t& val, bool& isBigUnsigned) const
+void NamespaceImpl::addChildrenToRefIndex()
 {
-    return
-        strToValue(
-            ref,
-            [&val, &isBigUnsigned](const NamespaceImpl& ns, const std::string& str)
-            {
-                return ns.strToNumeric(str, val, isBigUnsigned);
-            },
-            [&val, &isBigUnsigned](const FieldImpl& f, const std::string& str)
-            {
-                return f.strToNumeric(str, val, isBigUnsigned);
-            });
-}
+    for (auto& ns : m_namespaces) {
+        addToRefIndex(ns.first, *ns.second);
+        ns.second->addChildrenToRefIndex();
+    }
 
-bool NamespaceImpl::strToFp(const std::string& ref, double& val) const
-{
-    return
-        strToValue(
-            ref,
-            [&val](const NamespaceImpl& ns, const std::string& str)
-            {
-                return ns.strToFp(str, val);
-            },
-            [&val](const FieldImpl& f, const std::string& str)
-            {
-                return f.strToFp(str, val);
-            });
-}
+    for (auto& f : m_fields) {
+        addToRefIndex(f.first, *f.second);
+    }
 
-bool NamespaceImpl::strToBool(const std::string& ref, bool& val) const
-{
-    return
-        strToValue(
-            ref,
-            [&val](const NamespaceImpl& ns, const std::string& str)
-            {
-                return ns.strToBool(str, val);
-            },
-            [&val](const FieldImpl& f, const std::string& str)
-            {
-                return f.strToBool(str, val);
-            });
-}
+    for (auto& m : m_messages) {
+        addToRefIndex(m.first, *m.second);
+    }
 
-bool NamespaceImpl::strToString(const std::string& ref, std::string& val) const
-{
-    return
-        strToValue(
-            ref,
-            [&val](const NamespaceImpl& ns, const std::string& str)
-            {
-                return ns.strToString(str, val);
-            },
-            [&val](const FieldImpl& f, const std::string& str)
-            {
-                return f.strToString(str, val);
-            });
-}
+    for (auto& i : m_interfaces) {
+        addToRefIndex(i.first, *i.second);
+    }
 
-bool NamespaceImpl::strToData(const std::string& ref, std::vector<std::uint8_t>& val) const
-{
-    return
-        strToValue(
-            ref,
-            [&val](const NamespaceImpl& ns, const std::string& str)
-            {
-                return ns.strToData(str, val);
-            },
-            [&val](const FieldImpl& f, const std::string& str)
-            {
-                return f.strToData(str, val);
-            });
+    for (auto& f : m_frames) {
+        addToRefIndex(f.first, *f.second);
+    }
 }
 
 Object::ObjKind NamespaceImpl::objKindImpl() const
@@ -415,107 +580,148 @@ bool NamespaceImpl::processNamespace(::xmlNodePtr node)
         return false;
     }
 
+    return addNamespace(std::move(ns))->parseChildren(node);
+}
+
+NamespaceImpl* NamespaceImpl::addNamespace(Ptr ns)
+{
     auto& nsName = ns->name();
     auto iter = m_namespaces.find(nsName);
-    NamespaceImpl* nsToProcess = nullptr;
-    NamespaceImpl* realNs = nullptr;
-    do {
-        if (iter == m_namespaces.end()) {
-            m_namespaces.emplace(nsName, std::move(ns));
-            iter = m_namespaces.find(nsName);
-            assert(iter != m_namespaces.end());
-            nsToProcess = iter->second.get();
-            break;
-        }
-
-        nsToProcess = ns.get();
-        realNs = iter->second.get();
-
-        if ((!nsToProcess->description().empty()) &&
-            (nsToProcess->description() != realNs->description())) {
-            if (realNs->description().empty()) {
-                realNs->updateDescription(nsToProcess->description());
-            }
-            else {
-                logWarning() << XmlWrap::logPrefix(nsToProcess->getNode()) <<
-                    "Description of namespace \"" << nsToProcess->name() << "\" differs to "
-                    "one encountered before.";
-            }
-        }
-
-        if (!nsToProcess->extraAttributes().empty()) {
-            for (auto& a : nsToProcess->extraAttributes()) {
-                auto attIter = realNs->extraAttributes().find(a.first);
-                if (attIter == realNs->extraAttributes().end()) {
-                    realNs->extraAttributes().insert(a);
-                }
-                else if (a.second != attIter->second) {
-                    logWarning() << XmlWrap::logPrefix(nsToProcess->getNode()) <<
-                        "Value of attribute \"" << a.first << "\" differs to one defined before.";
-                }
-            }
-        }
-
-        realNs->extraChildren().insert(realNs->extraChildren().end(), nsToProcess->extraChildren().begin(), nsToProcess->extraChildren().end());
-
-    } while (false);
+    if (iter == m_namespaces.end()) {
+        auto* nsPtr = ns.get();
+        m_namespaces.emplace(nsName, std::move(ns));
+        addToRefIndex(nsPtr->name(), *nsPtr);
+        return nsPtr;
+    }
 
-    return nsToProcess->parseChildren(realNs);
+    auto* realNs = iter->second.get();
+    realNs->mergeProps(*ns);
+    return realNs;
 }
 
 bool NamespaceImpl::processMultipleFields(::xmlNodePtr node)
 {
     auto childrenNodes = XmlWrap::getChildren(node);
     for (auto* c : childrenNodes) {
-        std::string cName(reinterpret_cast<const char*>(c->name));
-        auto field = FieldImpl::create(cName, c, m_protocol);
-        if (!field) {
-            logError() << XmlWrap::logPrefix(c) << "Invalid field type \"" << cName << "\"";
+        if (!processField(c)) {
             return false;
         }
+    }
 
-        field->setParent(this);
+    return true;
+}
 
-        if (!field->parse()) {
-            return false;
-        }
+bool NamespaceImpl::processField(::xmlNodePtr node)
+{
+    std::string cName(reinterpret_cast<const char*>(node->name));
+    auto field = FieldImpl::create(cName, node, m_protocol);
+    if (!field) {
+        logError() << XmlWrap::logPrefix(node) << "Invalid field type \"" << cName << "\"";
+        return false;
+    }
 
-        auto& name = field->name();
-        if (name.empty()) {
-            logError() << XmlWrap::logPrefix(c) << "Field \"" << cName << "\" doesn't have any name.";
-            return false;
-        }
+    field->setParent(this);
 
-        auto iter = m_fields.find(name);
-        if (iter != m_fields.end()) {
-            logError() << XmlWrap::logPrefix(c) << "Field with name \"" << name << "\" has been already defined at " <<
-                          iter->second->getNode()->doc->URL << ":" << iter->second->getNode()->line << '.';
-            return false;
-        }
+    if (!field->parse()) {
+        return false;
+    }
 
-        m_fields.insert(std::make_pair(name, std::move(field)));
+    auto& name = field->name();
+    if (name.empty()) {
+        logError() << XmlWrap::logPrefix(node) << "Field \"" << cName << "\" doesn't have any name.";
+        return false;
     }
 
+    auto iter = m_fields.find(name);
+    if (iter != m_fields.end()) {
+        logError() << XmlWrap::logPrefix(node) << "Field with name \"" << name << "\" has been already defined at " <<
+                      definedAt(iter->second->schemaPos()) << '.';
+        return false;
+    }
+
+    releaseStreamedNodes(m_protocol, *field);
+    addToRefIndex(name, *field);
+    m_fields.insert(std::make_pair(name, std::move(field)));
     return true;
 }
 
+bool NamespaceImpl::processMultipleChild(const std::string& multipleName, ::xmlNodePtr node)
+{
+    if (multipleName == common::fieldsStr()) {
+        return processField(node);
+    }
+
+    struct ElemInfo
+    {
+        const std::string& m_multipleName;
+        const std::string& m_name;
+        ProcessFunc m_func;
+    };
+
+    static const ElemInfo Map[] = {
+        {common::messagesStr(), common::messageStr(), &NamespaceImpl::processMessage},
+        {common::interfacesStr(), common::interfaceStr(), &NamespaceImpl::processInterface},
+        {common::framesStr(), common::frameStr(), &NamespaceImpl::processFrame},
+    };
+
+    auto iter =
+        std::find_if(
+            std::begin(Map), std::end(Map),
+            [&multipleName](const ElemInfo& info)
+            {
+                return info.m_multipleName == multipleName;
+            });
+
+    if (iter == std::end(Map)) {
+        assert(!"Unexpected element");
+        return false;
+    }
+
+    std::string cName(reinterpret_cast<const char*>(node->name));
+    if (cName != iter->m_name) {
+        logError() << XmlWrap::logPrefix(node) <<
+            "The \"" << multipleName << "\" element cannot contain \"" <<
+            cName << "\".";
+        return false;
+    }
+
+    return (this->*(iter->m_func))(node);
+}
+
 bool NamespaceImpl::processMessage(::xmlNodePtr node)
 {
     auto msg = std::make_unique<MessageImpl>(node, m_protocol);
     msg->setParent(this);
-    if (!msg->parse()) {
+    if (!msg->parseProps()) {
+        return false;
+    }
+
+    // The members of the message are parsed later (concurrently) when
+    // allowed, unless they are copied from another message.
+    bool deferred = m_protocol.isMessageParseDeferred() && (!msg->hasCopyFieldsFrom());
+    if (deferred) {
+        m_protocol.deferMessage(*msg);
+    }
+    else if (!msg->parseFields()) {
         return false;
     }
 
     auto msgPtr = findMessage(msg->name());
     auto& msgName = msg->name();
     if (msgPtr != nullptr) {
+        // Errors of the fields are reported first regardless of the deferral
+        if (deferred && (!m_protocol.completeDeferredMessage(*msg))) {
+            return false;
+        }
+
         logError() << XmlWrap::logPrefix(node) << "Message with name \"" << msgName << "\" has been already defined at " <<
-                      msgPtr->getNode()->doc->URL << ":" << msgPtr->getNode()->line << '.';
+                      definedAt(msgPtr->schemaPos()) << '.';
 
         return false;
     }
 
+    releaseStreamedNodes(m_protocol, *msg);
+    addToRefIndex(msgName, *msg);
     m_messages.insert(std::make_pair(msgName, std::move(msg)));
     return true;
 }
@@ -524,16 +730,7 @@ bool NamespaceImpl::processMultipleMessages(::xmlNodePtr node)
 {
     auto childrenNodes = XmlWrap::getChildren(node);
     for (auto c : childrenNodes) {
-        assert(c != nullptr);
-        std::string cName(reinterpret_cast<const char*>(c->name));
-        if (cName != common::messageStr()) {
-            logError() << XmlWrap::logPrefix(c) <<
-                "The \"" << common::messagesStr() << "\" element cannot contain \"" <<
-                cName << "\".";
-            return false;
-        }
-
-        if (!processMessage(c)) {
+        if (!processMultipleChild(common::messagesStr(), c)) {
             return false;
         }
     }
@@ -552,11 +749,13 @@ bool NamespaceImpl::processInterface(::xmlNodePtr node)
     auto& intName = interface->name();
     if (intPtr != nullptr) {
         logError() << XmlWrap::logPrefix(node) << "Interface with name \"" << intName << "\" has been already defined at " <<
-                      intPtr->getNode()->doc->URL << ":" << intPtr->getNode()->line << '.';
+                      definedAt(intPtr->schemaPos()) << '.';
 
         return false;
     }
 
+    releaseStreamedNodes(m_protocol, *interface);
+    addToRefIndex(intName, *interface);
     m_interfaces.insert(std::make_pair(intName, std::move(interface)));
     return true;
 }
@@ -565,16 +764,7 @@ bool NamespaceImpl::processMultipleInterfaces(::xmlNodePtr node)
 {
     auto childrenNodes = XmlWrap::getChildren(node);
     for (auto c : childrenNodes) {
-        assert(c != nullptr);
-        std::string cName(reinterpret_cast<const char*>(c->name));
-        if (cName != common::interfaceStr()) {
-            logError() << XmlWrap::logPrefix(c) <<
-                "The \"" << common::interfacesStr() << "\" element cannot contain \"" <<
-                cName << "\".";
-            return false;
-        }
-
-        if (!processInterface(c)) {
+        if (!processMultipleChild(common::interfacesStr(), c)) {
             return false;
         }
     }
@@ -593,11 +783,13 @@ bool NamespaceImpl::processFrame(::xmlNodePtr node)
     auto& frameName = frame->name();
     if (framePtr != nullptr) {
         logError() << XmlWrap::logPrefix(node) << "Frame with name \"" << frameName << "\" has been already defined at " <<
-                      framePtr->getNode()->doc->URL << ":" << framePtr->getNode()->line << '.';
+                      definedAt(framePtr->schemaPos()) << '.';
 
         return false;
     }
 
+    releaseStreamedNodes(m_protocol, *frame);
+    addToRefIndex(frameName, *frame);
     m_frames.insert(std::make_pair(frameName, std::move(frame)));
     return true;
 }
@@ -606,16 +798,7 @@ bool NamespaceImpl::processMultipleFrames(::xmlNodePtr node)
 {
     auto childrenNodes = XmlWrap::getChildren(node);
     for (auto c : childrenNodes) {
-        assert(c != nullptr);
-        std::string cName(reinterpret_cast<const char*>(c->name));
-        if (cName != common::frameStr()) {
-            logError() << XmlWrap::logPrefix(c) <<
-                "The \"" << common::framesStr() << "\" element cannot contain \"" <<
-                cName << "\".";
-            return false;
-        }
-
-        if (!processFrame(c)) {
+        if (!processMultipleChild(common::framesStr(), c)) {
             return false;
         }
     }
@@ -635,35 +818,15 @@ bool NamespaceImpl::updateExtraChildren()
     return true;
 }
 
-bool NamespaceImpl::strToValue(const std::string& ref, StrToValueNsConvertFunc&& nsFunc, StrToValueFieldConvertFunc&& fFunc) const
+void NamespaceImpl::addToRefIndex(const std::string& name, Object& obj) const
 {
-    auto firstDotPos = ref.find_first_of('.');
-    if (firstDotPos == std::string::npos) {
-        auto fieldIter = m_fields.find(ref);
-        if (fieldIter == m_fields.end()) {
-            return false;
-        }
-
-        assert(fieldIter->second);
-        return fFunc(*fieldIter->second, common::emptyString());
-    }
-
-    std::string firstName(ref, 0, firstDotPos);
-    std::string restName(ref, firstDotPos + 1);
-    assert(!firstName.empty());
-    auto nsIter = m_namespaces.find(firstName);
-    if (nsIter != m_namespaces.end()) {
-        assert(nsIter->second);
-        return nsFunc(*nsIter->second, restName);
-    }
-
-    auto fieldIter = m_fields.find(firstName);
-    if (fieldIter == m_fields.end()) {
-        return false;
+    auto nsRef = externalRef();
+    if (nsRef.empty()) {
+        m_protocol.addToRefIndex(name, obj);
+        return;
     }
 
-    assert(fieldIter->second);
-    return fFunc(*fieldIter->second, restName);
+    m_protocol.addToRefIndex(nsRef + '.' + name, obj);
 }
 
 LogWrapper NamespaceImpl::logError() const
@@ -681,5 +844,60 @@ LogWrapper NamespaceImpl::logInfo() const
     return commsdsl::logInfo(m_protocol.logger());
 }
 
+void NamespaceImpl::writeCache(CacheWriter& writer) const
+{
+    writeObjectCache(writer);
+    writer.writeProps(m_props);
+    writer.writeProps(m_extraAttrs);
+    writer.writeContents(m_extraChildren);
+    writer.writeString(m_name);
+    writer.writeString(m_description);
+    writeCacheMap(writer, m_namespaces);
+    writeCacheMap(writer, m_fields);
+    writeCacheMap(writer, m_messages);
+    writeCacheMap(writer, m_interfaces);
+    writeCacheMap(writer, m_frames);
+}
+
+bool NamespaceImpl::readCache(CacheReader& reader)
+{
+    readObjectCache(reader);
+    m_props = reader.readProps();
+    m_extraAttrs = reader.readProps();
+    m_extraChildren = reader.readContents();
+    m_name = reader.readString();
+    m_description = reader.readString();
+    return
+        readCacheMap(
+            reader, m_namespaces,
+            [this, &reader]()
+            {
+                return createObjFromCache<NamespaceImpl>(reader, m_protocol);
+            }) &&
+        readCacheMap(
+            reader, m_fields,
+            [this, &reader]()
+            {
+                return FieldImpl::createFromCache(reader, m_protocol);
+            }) &&
+        readCacheMap(
+            reader, m_messages,
+            [this, &reader]()
+            {
+                return createObjFromCache<MessageImpl>(reader, m_protocol);
+            }) &&
+        readCacheMap(
+            reader, m_interfaces,
+            [this, &reader]()
+            {
+                return createObjFromCache<InterfaceImpl>(reader, m_protocol);
+            }) &&
+        readCacheMap(
+            reader, m_frames,
+            [this, &reader]()
+            {
+                return createObjFromCache<FrameImpl>(reader, m_protocol);
+            });
+}
 
 } // namespace commsdsl
@@ -18,6 +18,8 @@
 #include <memory>
 #include <algorithm>
 #include <cctype>
+#include <functional>
+#include <set>
 
 #include "commsdsl/Namespace.h"
 
@@ -33,6 +35,7 @@ namespace commsdsl
 {
 
 class ProtocolImpl;
+class XmlStream;
 class NamespaceImpl final : public Object
 {
 public:
@@ -72,6 +75,9 @@ public:
     using MessagesMap = std::map<std::string, MessageImplPtr, KeyComp>;
     using InterfacesMap = std::map<std::string, InterfaceImplPtr, KeyComp>;
     using FramesMap = std::map<std::string, FrameImplPtr, KeyComp>;
+    using AddNamespaceFunc = std::function<NamespaceImpl* (Ptr)>;
+    using DocsSet = std::set<::xmlDocPtr>;
+    using ElementDependencyFunc = std::function<void (const Object& elem, DependencyKind kind, const Object& obj)>;
 
     NamespaceImpl(::xmlNodePtr node, ProtocolImpl& protocol);
     virtual ~NamespaceImpl() = default;
@@ -85,11 +91,17 @@ public:
 
     bool parseProps();
 
-    bool parseChildren(NamespaceImpl* realNs = nullptr);
+    bool parseChildren(::xmlNodePtr node);
 
     bool parse();
 
-    bool processChild(::xmlNodePtr node, NamespaceImpl* realNs = nullptr);
+    bool processChild(::xmlNodePtr node);
+
+    bool streamChild(XmlStream& stream, ::xmlNodePtr skeletonParent);
+
+    static bool streamNamespace(XmlStream& stream, Ptr ns, AddNamespaceFunc&& addFunc);
+
+    void mergeProps(const NamespaceImpl& other);
 
     static const XmlWrap::NamesList& supportedChildren();
 
@@ -113,16 +125,45 @@ public:
         m_description = value;
     }
 
+    const NamespacesMap& namespaces() const
+    {
+        return m_namespaces;
+    }
+
     const InterfacesMap& interfaces() const
     {
         return m_interfaces;
     }
 
-    NamespacesList namespacesList() const;
-    FieldsList fieldsList() const;
-    MessagesList messagesList() const;
-    InterfacesList interfacesList() const;
-    FramesList framesList() const;
+    const NamespacesList& namespacesList() const
+    {
+        return m_namespacesList;
+    }
+
+    const FieldsList& fieldsList() const
+    {
+        return m_fieldsList;
+    }
+
+    const MessagesList& messagesList() const
+    {
+        return m_messagesList;
+    }
+
+    const InterfacesList& interfacesList() const
+    {
+        return m_interfacesList;
+    }
+
+    const FramesList& framesList() const
+    {
+        return m_framesList;
+    }
+
+    void cacheLists();
+    void collectDependencies(const ElementDependencyFunc& func) const;
+    void removeDefinedIn(const DocsSet& docs);
+    bool empty() const;
 
     const MessagesMap& messages() const
     {
@@ -163,21 +204,21 @@ public:
 
     unsigned countMessageIds() const;
 
-    bool strToNumeric(const std::string& ref, std::intmax_t& val, bool& isBigUnsigned) const;
-    bool strToFp(const std::string& ref, double& val) const;
-    bool strToBool(const std::string& ref, bool& val) const;
-    bool strToString(const std::string& ref, std::string& val) const;
-    bool strToData(const std::string& ref, std::vector<std::uint8_t>& val) const;
+    void addChildrenToRefIndex();
+
+    void writeCache(CacheWriter& writer) const;
+    bool readCache(CacheReader& reader);
 
 protected:
     virtual ObjKind objKindImpl() const override;
 
 private:
-
-    using StrToValueNsConvertFunc = std::function<bool (const NamespaceImpl& ns, const std::string& ref)>;
-    using StrToValueFieldConvertFunc = std::function<bool (const FieldImpl& f, const std::string& ref)>;
+    using ProcessFunc = bool (NamespaceImpl::*)(::xmlNodePtr node);
 
     bool processNamespace(::xmlNodePtr node);
+    NamespaceImpl* addNamespace(Ptr ns);
+    bool processMultipleChild(const std::string& multipleName, ::xmlNodePtr node);
+    bool processField(::xmlNodePtr node);
     bool processMultipleFields(::xmlNodePtr node);
     bool processMessage(::xmlNodePtr node);
     bool processMultipleMessages(::xmlNodePtr node);
@@ -187,7 +228,7 @@ private:
     bool processMultipleFrames(::xmlNodePtr node);
     bool updateExtraAttrs();
     bool updateExtraChildren();
-    bool strToValue(const std::string& ref, StrToValueNsConvertFunc&& nsFunc, StrToValueFieldConvertFunc&& fFunc) const;
+    void addToRefIndex(const std::string& name, Object& obj) const;
 
     LogWrapper logError() const;
     LogWrapper logWarning() const;
@@ -208,6 +249,12 @@ private:
     MessagesMap m_messages;
     InterfacesMap m_interfaces;
     FramesMap m_frames;
+
+    NamespacesList m_namespacesList;
+    FieldsList m_fieldsList;
+    MessagesList m_messagesList;
+    InterfacesList m_interfacesList;
+    FramesList m_framesList;
 };
 
 using NamespaceImplPtr = NamespaceImpl::Ptr;
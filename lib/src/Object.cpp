@@ -0,0 +1,90 @@
+//
+// Copyright 2018 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Object.h"
+
+#include <algorithm>
+
+#include "CacheWriter.h"
+#include "CacheReader.h"
+
+namespace commsdsl
+{
+
+namespace
+{
+
+// Messages are parsed concurrently, every thread records into its own object
+thread_local Object* ValueRefsObj = nullptr;
+
+} // namespace
+
+Object::ValueRefsScope::ValueRefsScope(Object& obj)
+  : m_prev(ValueRefsObj)
+{
+    ValueRefsObj = &obj;
+}
+
+Object::ValueRefsScope::~ValueRefsScope()
+{
+    ValueRefsObj = m_prev;
+}
+
+void Object::recordValueRef(const Object& obj)
+{
+    if ((ValueRefsObj == nullptr) || (ValueRefsObj == &obj)) {
+        return;
+    }
+
+    auto& refs = ValueRefsObj->m_valueRefs;
+    if (std::find(refs.begin(), refs.end(), &obj) == refs.end()) {
+        refs.push_back(&obj);
+    }
+}
+
+void Object::reportValueRefs(const DependencyReportFunc& func) const
+{
+    for (auto* obj : m_valueRefs) {
+        func(DependencyKind::Value, *obj);
+    }
+}
+
+void Object::writeObjectCache(CacheWriter& writer) const
+{
+    writer.writeObjectId(*this);
+    writer.writeObjectRef(m_parent);
+    writer.writeUnsigned(m_rState.m_sinceVersion);
+    writer.writeUnsigned(m_rState.m_deprecated);
+    writer.writeBool(m_rState.m_deprecatedRemoved);
+    writer.writeUnsigned(m_valueRefs.size());
+    for (auto* obj : m_valueRefs) {
+        writer.writeObjectRef(obj);
+    }
+}
+
+void Object::readObjectCache(CacheReader& reader)
+{
+    reader.readObjectId(*this);
+    reader.readParent(*this);
+    m_rState.m_sinceVersion = reader.readUnsigned<unsigned>();
+    m_rState.m_deprecated = reader.readUnsigned<unsigned>();
+    m_rState.m_deprecatedRemoved = reader.readBool();
+    m_valueRefs.resize(reader.readSize());
+    for (auto& obj : m_valueRefs) {
+        reader.readObjectRef(obj);
+    }
+}
+
+} // namespace commsdsl
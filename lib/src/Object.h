@@ -16,13 +16,20 @@
 #pragma once
 
 #include <limits>
+#include <functional>
+#include <vector>
 
 #include "commsdsl/Protocol.h"
+#include "Arena.h"
+#include "StringPool.h"
 
 namespace commsdsl
 {
 
-class Object
+class CacheWriter;
+class CacheReader;
+
+class Object : public ArenaAllocated
 {
 public:
     enum class ObjKind
@@ -36,6 +43,25 @@ public:
         NumOfValues
     };
 
+    using DependencyKind = Protocol::DependencyKind;
+    using DependencyReportFunc = std::function<void (DependencyKind kind, const Object& obj)>;
+    using ValueRefsList = ArenaVector<const Object*>;
+
+    // The elements whose values are referenced while parsing the object
+    // (within the scope's lifetime) are recorded in the object.
+    class ValueRefsScope
+    {
+    public:
+        explicit ValueRefsScope(Object& obj);
+        ~ValueRefsScope();
+
+        ValueRefsScope(const ValueRefsScope&) = delete;
+        ValueRefsScope& operator=(const ValueRefsScope&) = delete;
+
+    private:
+        Object* m_prev = nullptr;
+    };
+
     Object* getParent()
     {
         return m_parent;
@@ -76,9 +102,42 @@ public:
         return m_rState.m_deprecatedRemoved;
     }
 
+    const ValueRefsList& valueRefs() const
+    {
+        return m_valueRefs;
+    }
+
+    // Interned external reference, recorded when the element is added
+    // to the references index.
+    const InternedString& internedExternalRef() const
+    {
+        return m_externalRef;
+    }
+
+    void setExternalRef(InternedString ref)
+    {
+        m_externalRef = ref;
+    }
+
+    static void recordValueRef(const Object& obj);
+    void reportValueRefs(const DependencyReportFunc& func) const;
+
+    void writeObjectCache(CacheWriter& writer) const;
+    void readObjectCache(CacheReader& reader);
+
 protected:
     Object() = default;
     ~Object() = default;
+
+    // The copies are not registered in the references index
+    Object(const Object& other)
+      : m_parent(other.m_parent),
+        m_rState(other.m_rState),
+        m_valueRefs(other.m_valueRefs)
+    {
+    }
+
+    Object& operator=(const Object&) = delete;
     
     virtual ObjKind objKindImpl() const = 0;
 
@@ -108,6 +167,8 @@ private:
 
     Object* m_parent = nullptr;
     ReusableState m_rState;
+    ValueRefsList m_valueRefs;
+    InternedString m_externalRef;
 };
 
 } // namespace commsdsl
@@ -23,6 +23,8 @@
 #include "BitfieldFieldImpl.h"
 #include "SetFieldImpl.h"
 #include "util.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 //#include <iostream>
 
@@ -37,7 +39,7 @@ const char Deref = '$';
 
 } // namespace
 
-bool OptCondExprImpl::parse(const std::string& expr, ::xmlNodePtr node, Logger& logger)
+bool OptCondExprImpl::parse(const std::string& expr, ::xmlNodePtr node, const Logger& logger)
 {
     if (expr.empty()) {
         logError(logger) << XmlWrap::logPrefix(node) <<
@@ -67,7 +69,7 @@ OptCondImpl::Ptr OptCondExprImpl::cloneImpl() const
     return Ptr(new OptCondExprImpl(*this));
 }
 
-bool OptCondExprImpl::verifyImpl(const OptCondImpl::FieldsList& fields, ::xmlNodePtr node, Logger& logger) const
+bool OptCondExprImpl::verifyImpl(const OptCondImpl::FieldsList& fields, ::xmlNodePtr node, const Logger& logger) const
 {
     if (m_left.empty()) {
         return verifyBitCheck(fields, node, logger);
@@ -83,7 +85,7 @@ bool OptCondExprImpl::hasUpdatedValue()
            (!m_op.empty());
 }
 
-bool OptCondExprImpl::checkComparison(const std::string& expr, const std::string& op, ::xmlNodePtr node, Logger& logger)
+bool OptCondExprImpl::checkComparison(const std::string& expr, const std::string& op, ::xmlNodePtr node, const Logger& logger)
 {
     if (hasUpdatedValue()) {
         return true;
@@ -146,7 +148,7 @@ bool OptCondExprImpl::checkComparison(const std::string& expr, const std::string
     return true;
 }
 
-bool OptCondExprImpl::checkBool(const std::string& expr, ::xmlNodePtr node, Logger& logger)
+bool OptCondExprImpl::checkBool(const std::string& expr, ::xmlNodePtr node, const Logger& logger)
 {
     if (hasUpdatedValue()) {
         return true;
@@ -236,7 +238,7 @@ FieldImpl* OptCondExprImpl::findField(
     return iter->get();
 }
 
-bool OptCondExprImpl::verifyBitCheck(const OptCondImpl::FieldsList& fields, ::xmlNodePtr node, Logger& logger) const
+bool OptCondExprImpl::verifyBitCheck(const OptCondImpl::FieldsList& fields, ::xmlNodePtr node, const Logger& logger) const
 {
     assert(!m_right.empty());
     assert(m_right[0] == Deref);
@@ -262,7 +264,7 @@ bool OptCondExprImpl::verifyBitCheck(const OptCondImpl::FieldsList& fields, ::xm
     return false;
 }
 
-bool OptCondExprImpl::verifyComparison(const OptCondImpl::FieldsList& fields, ::xmlNodePtr node, Logger& logger) const
+bool OptCondExprImpl::verifyComparison(const OptCondImpl::FieldsList& fields, ::xmlNodePtr node, const Logger& logger) const
 {
     assert(!m_left.empty());
     assert(!m_right.empty());
@@ -325,7 +327,7 @@ OptCondListImpl::CondList OptCondListImpl::condList() const
     return result;
 }
 
-bool OptCondListImpl::parse(xmlNodePtr node, Logger& logger)
+bool OptCondListImpl::parse(xmlNodePtr node, const Logger& logger)
 {
     static const std::string CondMap[] = {
         common::andStr(),
@@ -402,7 +404,7 @@ OptCondImpl::Ptr OptCondListImpl::cloneImpl() const
     return Ptr(new OptCondListImpl(*this));
 }
 
-bool OptCondListImpl::verifyImpl(const OptCondImpl::FieldsList& fields, ::xmlNodePtr node, Logger& logger) const
+bool OptCondListImpl::verifyImpl(const OptCondImpl::FieldsList& fields, ::xmlNodePtr node, const Logger& logger) const
 {
     return std::all_of(
         m_conds.begin(), m_conds.end(),
@@ -414,4 +416,70 @@ bool OptCondListImpl::verifyImpl(const OptCondImpl::FieldsList& fields, ::xmlNod
 
 
 
+void OptCondImpl::writeCache(CacheWriter& writer) const
+{
+    writer.writeEnum(kind());
+    writeCacheImpl(writer);
+}
+
+OptCondImpl::Ptr OptCondImpl::createFromCache(CacheReader& reader)
+{
+    Ptr cond;
+    auto condKind = reader.readEnum<Kind>();
+    if (condKind == Kind::Expr) {
+        cond.reset(new OptCondExprImpl);
+    }
+    else if (condKind == Kind::List) {
+        cond.reset(new OptCondListImpl);
+    }
+
+    if ((!cond) || (!cond->readCacheImpl(reader))) {
+        return Ptr();
+    }
+
+    return cond;
+}
+
+void OptCondExprImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    writer.writeString(m_left);
+    writer.writeString(m_op);
+    writer.writeString(m_right);
+}
+
+bool OptCondExprImpl::readCacheImpl(CacheReader& reader)
+{
+    m_left = reader.readString();
+    m_op = reader.readString();
+    m_right = reader.readString();
+    return reader.ok();
+}
+
+void OptCondListImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    writer.writeEnum(m_type);
+    writer.writeUnsigned(m_conds.size());
+    for (auto& c : m_conds) {
+        c->writeCache(writer);
+    }
+}
+
+bool OptCondListImpl::readCacheImpl(CacheReader& reader)
+{
+    m_type = reader.readEnum<Type>();
+    auto count = reader.readSize();
+    m_conds.clear();
+    m_conds.reserve(count);
+    for (auto idx = 0U; idx < count; ++idx) {
+        auto cond = createFromCache(reader);
+        if (!cond) {
+            return false;
+        }
+
+        m_conds.push_back(std::move(cond));
+    }
+
+    return reader.ok();
+}
+
 } // namespace commsdsl
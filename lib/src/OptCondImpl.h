@@ -22,16 +22,19 @@
 #include "XmlWrap.h"
 #include "Logger.h"
 #include "FieldImpl.h"
+#include "Arena.h"
 
 namespace commsdsl
 {
 
-class OptCondImpl
+class CacheWriter;
+class CacheReader;
+class OptCondImpl : public ArenaAllocated
 {
 public:
     using Ptr = std::unique_ptr<OptCondImpl>;
     using Kind = OptCond::Kind;
-    using FieldsList = std::vector<FieldImplPtr>;
+    using FieldsList = FieldImpl::FieldsList;
 
     OptCondImpl() = default;
     OptCondImpl(const OptCondImpl&) = default;
@@ -48,15 +51,20 @@ public:
         return cloneImpl();
     }
 
-    bool verify(const FieldsList& fields, ::xmlNodePtr node, Logger& logger) const
+    bool verify(const FieldsList& fields, ::xmlNodePtr node, const Logger& logger) const
     {
         return verifyImpl(fields, node, logger);
     }
 
+    void writeCache(CacheWriter& writer) const;
+    static Ptr createFromCache(CacheReader& reader);
+
 protected:
     virtual Kind kindImpl() const = 0;
     virtual Ptr cloneImpl() const = 0;
-    virtual bool verifyImpl(const FieldsList& fields, ::xmlNodePtr node, Logger& logger) const = 0;
+    virtual bool verifyImpl(const FieldsList& fields, ::xmlNodePtr node, const Logger& logger) const = 0;
+    virtual void writeCacheImpl(CacheWriter& writer) const = 0;
+    virtual bool readCacheImpl(CacheReader& reader) = 0;
 };
 
 class OptCondExprImpl final: public OptCondImpl
@@ -66,7 +74,7 @@ public:
     OptCondExprImpl(const OptCondExprImpl&) = default;
     OptCondExprImpl(OptCondExprImpl&&) = default;
 
-    bool parse(const std::string& expr, ::xmlNodePtr node, Logger& logger);
+    bool parse(const std::string& expr, ::xmlNodePtr node, const Logger& logger);
 
     const std::string& left() const
     {
@@ -86,18 +94,20 @@ public:
 protected:
     virtual Kind kindImpl() const override;
     virtual Ptr cloneImpl() const override;
-    virtual bool verifyImpl(const FieldsList& fields, ::xmlNodePtr node, Logger& logger) const override;
+    virtual bool verifyImpl(const FieldsList& fields, ::xmlNodePtr node, const Logger& logger) const override;
+    virtual void writeCacheImpl(CacheWriter& writer) const override;
+    virtual bool readCacheImpl(CacheReader& reader) override;
 
 private:
     bool hasUpdatedValue();
-    bool checkComparison(const std::string& expr, const std::string& op, ::xmlNodePtr node, Logger& logger);
-    bool checkBool(const std::string& expr, ::xmlNodePtr node, Logger& logger);
+    bool checkComparison(const std::string& expr, const std::string& op, ::xmlNodePtr node, const Logger& logger);
+    bool checkBool(const std::string& expr, ::xmlNodePtr node, const Logger& logger);
     static FieldImpl* findField(
         const FieldsList& fields,
         const std::string& name,
         std::size_t& remPos);
-    bool verifyBitCheck(const FieldsList& fields, ::xmlNodePtr node, Logger& logger) const;
-    bool verifyComparison(const FieldsList& fields, ::xmlNodePtr node, Logger& logger) const;
+    bool verifyBitCheck(const FieldsList& fields, ::xmlNodePtr node, const Logger& logger) const;
+    bool verifyComparison(const FieldsList& fields, ::xmlNodePtr node, const Logger& logger) const;
 
     std::string m_left;
     std::string m_op;
@@ -109,7 +119,7 @@ class OptCondListImpl final : public OptCondImpl
     using Base = OptCondImpl;
 public:
     using Type = OptCondList::Type;
-    using List = std::vector<Ptr>;
+    using List = ArenaVector<Ptr>;
     using CondList = OptCondList::CondList;
 
     OptCondListImpl() = default;
@@ -123,14 +133,16 @@ public:
 
     CondList condList() const;
 
-    bool parse(::xmlNodePtr node, Logger& logger);
+    bool parse(::xmlNodePtr node, const Logger& logger);
 
 
 
 protected:
     virtual Kind kindImpl() const override;
     virtual Ptr cloneImpl() const override;
-    virtual bool verifyImpl(const FieldsList& fields, ::xmlNodePtr node, Logger& logger) const override;
+    virtual bool verifyImpl(const FieldsList& fields, ::xmlNodePtr node, const Logger& logger) const override;
+    virtual void writeCacheImpl(CacheWriter& writer) const override;
+    virtual bool readCacheImpl(CacheReader& reader) override;
 
 private:
     List m_conds;
@@ -24,6 +24,8 @@
 
 #include "common.h"
 #include "ProtocolImpl.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
@@ -453,8 +455,7 @@ bool OptionalFieldImpl::checkFieldAsChild()
             break;
         }
 
-        auto attrs = XmlWrap::parseNodeProps(getNode());
-        if (attrs.find(common::fieldsStr()) != attrs.end()) {
+        if (XmlWrap::hasProp(getNode(), common::fieldsStr())) {
             logError() << "There must be only one occurance of \"" << common::fieldStr() << "\" definition.";
             return false;
         }
@@ -519,4 +520,51 @@ bool OptionalFieldImpl::strToValue(
     return forwardFunc(*m_field, restName);
 }
 
+void OptionalFieldImpl::collectDependenciesImpl(const DependencyReportFunc& func) const
+{
+    if (m_state.m_extField != nullptr) {
+        func(DependencyKind::Field, *m_state.m_extField);
+        return;
+    }
+
+    if (m_field) {
+        m_field->collectDependencies(func);
+    }
+}
+
+void OptionalFieldImpl::releaseNodesImpl()
+{
+    releaseNodesOptional(m_field);
+}
+
+void OptionalFieldImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    writer.writeEnum(m_state.m_mode);
+    writer.writeObjectRef(m_state.m_extField);
+    writer.writeBool(m_state.m_externalModeCtrl);
+    writeCacheOptional(writer, m_field);
+    writer.writeBool(static_cast<bool>(m_cond));
+    if (m_cond) {
+        m_cond->writeCache(writer);
+    }
+}
+
+bool OptionalFieldImpl::readCacheImpl(CacheReader& reader)
+{
+    m_state.m_mode = reader.readEnum<Mode>();
+    reader.readObjectRef(m_state.m_extField);
+    m_state.m_externalModeCtrl = reader.readBool();
+    if (!readCacheOptional(reader, protocol(), m_field)) {
+        return false;
+    }
+
+    m_cond.reset();
+    if (!reader.readBool()) {
+        return reader.ok();
+    }
+
+    m_cond = OptCondImpl::createFromCache(reader);
+    return static_cast<bool>(m_cond);
+}
+
 } // namespace commsdsl
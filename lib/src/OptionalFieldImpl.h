@@ -91,6 +91,10 @@ protected:
     virtual bool strToBoolImpl(const std::string& ref, bool& val) const override;
     virtual bool strToStringImpl(const std::string& ref, std::string& val) const override;
     virtual bool strToDataImpl(const std::string& ref, std::vector<std::uint8_t>& val) const override;
+    virtual void collectDependenciesImpl(const DependencyReportFunc& func) const override;
+    virtual void releaseNodesImpl() override;
+    virtual void writeCacheImpl(CacheWriter& writer) const override;
+    virtual bool readCacheImpl(CacheReader& reader) override;
 
 private:
     using StrToValueFieldConvertFunc = std::function<bool (const FieldImpl& f, const std::string& ref)>;
@@ -30,6 +30,21 @@ void Protocol::setErrorReportCallback(Protocol::ErrorReportFunction&& cb)
     m_pImpl->setErrorReportCallback(std::move(cb));
 }
 
+void Protocol::setCompactModel(bool value)
+{
+    m_pImpl->setCompactModel(value);
+}
+
+void Protocol::setValidationJobs(unsigned jobs)
+{
+    m_pImpl->setValidationJobs(jobs);
+}
+
+void Protocol::setStatsEnabled(bool value)
+{
+    m_pImpl->setStatsEnabled(value);
+}
+
 Protocol::~Protocol() = default;
 
 bool Protocol::parse(const std::string& input)
@@ -37,17 +52,47 @@ bool Protocol::parse(const std::string& input)
     return m_pImpl->parse(input);
 }
 
+bool Protocol::parseAll(const FilesList& files, unsigned jobs)
+{
+    return m_pImpl->parseAll(files, jobs);
+}
+
+bool Protocol::parseBuffer(const char* data, std::size_t len, const std::string& name)
+{
+    return m_pImpl->parseBuffer(data, len, name);
+}
+
+bool Protocol::parseStreamed(const std::string& input)
+{
+    return m_pImpl->parseStreamed(input);
+}
+
 bool Protocol::validate()
 {
     return m_pImpl->validate();
 }
 
+bool Protocol::update(const std::string& input)
+{
+    return m_pImpl->update(input);
+}
+
+bool Protocol::loadCache(const std::string& cacheFile, const FilesList& files)
+{
+    return m_pImpl->loadCache(cacheFile, files);
+}
+
+bool Protocol::saveCache(const std::string& cacheFile, const FilesList& files) const
+{
+    return m_pImpl->saveCache(cacheFile, files);
+}
+
 Schema Protocol::schema() const
 {
     return m_pImpl->schema();
 }
 
-Protocol::NamespacesList Protocol::namespaces() const
+const Protocol::NamespacesList& Protocol::namespaces() const
 {
     return m_pImpl->namespacesList();
 }
@@ -57,11 +102,56 @@ Field Protocol::findField(const std::string& externalRef) const
     return Field(m_pImpl->findField(externalRef));
 }
 
-Protocol::MessagesList Protocol::allMessages() const
+const Protocol::MessagesList& Protocol::allMessages() const
 {
     return m_pImpl->allMessages();
 }
 
+const Protocol::MessageIdsList& Protocol::messageIds() const
+{
+    return m_pImpl->messageIds();
+}
+
+std::size_t Protocol::messageIdOrdinal(std::uintmax_t id) const
+{
+    return m_pImpl->messageIdOrdinal(id);
+}
+
+Protocol::MessagesRange Protocol::messagesById(std::uintmax_t id) const
+{
+    return m_pImpl->messagesById(id);
+}
+
+Protocol::MessagesRange Protocol::messagesByIdOrdinal(std::size_t ordinal) const
+{
+    return m_pImpl->messagesByIdOrdinal(ordinal);
+}
+
+Message Protocol::findMessage(std::uintmax_t id) const
+{
+    auto range = m_pImpl->messagesById(id);
+    if (range.first == range.second) {
+        return Message(nullptr);
+    }
+
+    return *range.first;
+}
+
+const Protocol::DependenciesList& Protocol::dependencies(ElementKind kind, const std::string& externalRef) const
+{
+    return m_pImpl->dependencies(kind, externalRef);
+}
+
+const Protocol::DependenciesList& Protocol::dependents(ElementKind kind, const std::string& externalRef) const
+{
+    return m_pImpl->dependents(kind, externalRef);
+}
+
+Protocol::ElementsList Protocol::allDependents(ElementKind kind, const std::string& externalRef) const
+{
+    return m_pImpl->allDependents(kind, externalRef);
+}
+
 void Protocol::addExpectedExtraPrefix(const std::string& value)
 {
     return m_pImpl->addExpectedExtraPrefix(value);
@@ -72,4 +162,9 @@ const Protocol::PlatformsList&Protocol::platforms() const
     return m_pImpl->platforms();
 }
 
+Protocol::Stats Protocol::stats() const
+{
+    return m_pImpl->stats();
+}
+
 } // namespace commsdsl
@@ -20,14 +20,92 @@
 #include <cassert>
 #include <algorithm>
 #include <numeric>
-
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <limits>
+#include <cctype>
+#include <fstream>
+#include <cstdio>
+#include <unordered_set>
+
+#include "commsdsl/version.h"
+#include "MappedFile.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 #include "XmlWrap.h"
+#include "XmlStream.h"
 #include "FieldImpl.h"
 #include "EnumFieldImpl.h"
 
 namespace commsdsl
 {
 
+namespace
+{
+
+void initXmlParser()
+{
+    // Must be done once before any concurrent parsing
+    static std::once_flag Flag;
+    std::call_once(Flag, &::xmlInitParser);
+}
+
+std::uint64_t elapsedUs(ProtocolImpl::StatsClock::time_point start)
+{
+    auto elapsed = ProtocolImpl::StatsClock::now() - start;
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
+// Limits the elements visible to the parsing of the deferred message
+// to the ones defined before it.
+thread_local std::size_t VisibleRefsLimit = std::numeric_limits<std::size_t>::max();
+
+class VisibleRefsScope
+{
+public:
+    explicit VisibleRefsScope(std::size_t limit)
+      : m_prev(VisibleRefsLimit)
+    {
+        VisibleRefsLimit = limit;
+    }
+
+    ~VisibleRefsScope()
+    {
+        VisibleRefsLimit = m_prev;
+    }
+
+    VisibleRefsScope(const VisibleRefsScope&) = delete;
+    VisibleRefsScope& operator=(const VisibleRefsScope&) = delete;
+
+private:
+    std::size_t m_prev = 0U;
+};
+
+const std::string CacheMagic("commsdsl-cache");
+const unsigned CacheFormatVersion = 3U;
+const std::uint64_t FnvOffsetBasis = 0xcbf29ce484222325ULL;
+const std::uint64_t FnvPrime = 0x100000001b3ULL;
+
+std::uint64_t fnv1a(const char* data, std::size_t len, std::uint64_t hash = FnvOffsetBasis)
+{
+    for (auto idx = 0U; idx < len; ++idx) {
+        hash ^= static_cast<std::uint8_t>(data[idx]);
+        hash *= FnvPrime;
+    }
+    return hash;
+}
+
+std::uint64_t fnv1a(const std::string& str, std::uint64_t hash)
+{
+    // Length goes first to separate consecutive strings
+    auto len = std::to_string(str.size()) + ':';
+    hash = fnv1a(len.data(), len.size(), hash);
+    return fnv1a(str.data(), str.size(), hash);
+}
+
+} // namespace
+
 ProtocolImpl::ProtocolImpl()
   : m_logger(
         [this](ErrorLevel level, const std::string& msg)
@@ -51,7 +129,7 @@ ProtocolImpl::ProtocolImpl()
         }
     )
 {
-    xmlSetStructuredErrorFunc(this, &ProtocolImpl::cbXmlErrorFunc);
+    initXmlParser();
     m_logger.setMinLevel(m_minLevel);
 }
 
@@ -62,13 +140,86 @@ bool ProtocolImpl::parse(const std::string& input)
         return false;
     }
 
-    XmlDocPtr doc(xmlParseFile(input.c_str()));
-    if (!doc) {
-        std::cerr << "ERROR: Failed to parse" << input << std::endl;
+    auto result = parseFile(input);
+    return processParseResult(input, result);
+}
+
+bool ProtocolImpl::parseAll(const FilesList& files, unsigned jobs)
+{
+    if (m_validated) {
+        logError() << "Parsing extra files after validation is not allowed";
         return false;
     }
 
-    m_docs.push_back(std::move(doc));
+    if (jobs == 0U) {
+        jobs = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    std::vector<ParseResult> results(files.size());
+    std::atomic<std::size_t> nextIdx(0U);
+    auto worker =
+        [&files, &results, &nextIdx]()
+        {
+            while (true) {
+                auto idx = nextIdx++;
+                if (files.size() <= idx) {
+                    break;
+                }
+
+                results[idx] = parseFile(files[idx]);
+            }
+        };
+
+    auto threadsCount = std::min(static_cast<std::size_t>(jobs), files.size());
+    std::vector<std::thread> threads;
+    if (1U < threadsCount) {
+        threads.reserve(threadsCount - 1U);
+        for (auto idx = 1U; idx < threadsCount; ++idx) {
+            threads.emplace_back(worker);
+        }
+    }
+
+    worker();
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    for (auto idx = 0U; idx < files.size(); ++idx) {
+        if (!processParseResult(files[idx], results[idx])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ProtocolImpl::parseBuffer(const char* data, std::size_t len, const std::string& name)
+{
+    if (m_validated) {
+        logError() << "Parsing extra files after validation is not allowed";
+        return false;
+    }
+
+    if (static_cast<std::size_t>(std::numeric_limits<int>::max()) < len) {
+        logError() << "Schema buffer \"" << name << "\" is too big.";
+        return false;
+    }
+
+    auto result = parseMemory(data, len, name);
+    return processParseResult(name, result);
+}
+
+bool ProtocolImpl::parseStreamed(const std::string& input)
+{
+    if (m_validated) {
+        logError() << "Parsing extra files after validation is not allowed";
+        return false;
+    }
+
+    // The file is read when the protocol is validated
+    SchemaInput schemaInput;
+    schemaInput.m_streamFile = input;
+    m_inputs.push_back(std::move(schemaInput));
     return true;
 }
 
@@ -78,17 +229,162 @@ bool ProtocolImpl::validate()
         return true;
     }
 
-    if (m_docs.empty()) {
+    if (m_inputs.empty()) {
         logError() << "Cannot validate without any schema files";
         return false;
     }
 
-    for (auto& d : m_docs) {
-        if (!validateDoc(d.get())) {
+    Arena::Scope arenaScope(m_arena);
+    m_validationStarted = true;
+    if (!validateInputs(0U)) {
+        return false;
+    }
+
+    return completeValidation();
+}
+
+bool ProtocolImpl::update(const std::string& input)
+{
+    if (m_validated && m_inputs.empty()) {
+        logError() << "Updating schema files of the model loaded from cache or compacted is not allowed";
+        return false;
+    }
+
+    auto inputIter =
+        std::find_if(
+            m_inputs.begin(), m_inputs.end(),
+            [&input](const SchemaInput& i)
+            {
+                return
+                    (i.m_doc) &&
+                    (i.m_doc->URL != nullptr) &&
+                    (input == reinterpret_cast<const char*>(i.m_doc->URL));
+            });
+
+    if (inputIter == m_inputs.end()) {
+        logError() << "Schema file \"" << input << "\" hasn't been parsed before";
+        return false;
+    }
+
+    auto result = parseFile(input);
+    reportXmlErrors(result.m_errors);
+    recordFileParsed(input, result.m_parseTimeUs);
+    if (!result.m_doc) {
+        logError() << input << ": Failed to parse the schema.";
+        return false;
+    }
+
+    auto idx = static_cast<std::size_t>(std::distance(m_inputs.begin(), inputIter));
+    if (!m_validationStarted) {
+        inputIter->m_doc = std::move(result.m_doc);
+        return true;
+    }
+
+    // Everything contributed by the updated and all the following inputs
+    // gets re-validated together with the elements depending on it.
+    auto from = firstDependentInput(std::min(idx, m_validInputs));
+    auto streamIter =
+        std::find_if(
+            m_inputs.begin() + static_cast<std::ptrdiff_t>(from), m_inputs.end(),
+            [](const SchemaInput& i)
+            {
+                return !i.m_streamFile.empty();
+            });
+
+    if (streamIter != m_inputs.end()) {
+        logError() << "Updating schema files after \"" << streamIter->m_streamFile << "\" parsed in streaming mode is not allowed";
+        return false;
+    }
+
+    Arena::Scope arenaScope(m_arena);
+    discardInputs(from);
+    inputIter->m_doc = std::move(result.m_doc);
+    m_validated = false;
+    if (!validateInputs(from)) {
+        return false;
+    }
+
+    return completeValidation();
+}
+
+bool ProtocolImpl::validateInputs(std::size_t from)
+{
+    auto phaseStart = StatsClock::now();
+    bool result = false;
+    if (!isMessageParseDeferred()) {
+        result = processInputs(from);
+    }
+    else {
+        // Reported together with the logs of the deferred messages
+        Logger logger(
+            [this](ErrorLevel level, const std::string& msg)
+            {
+                XmlError info;
+                info.m_level = level;
+                info.m_msg = msg;
+                m_deferralLogs.push_back(std::move(info));
+            });
+        logger.setMinLevel(m_minLevel);
+
+        Logger::Redirect redirect(logger);
+        result = processInputs(from);
+    }
+
+    if (result) {
+        recordPhase("schema files", phaseStart);
+    }
+
+    phaseStart = StatsClock::now();
+    if (!validateDeferredMessages(result)) {
+        return false;
+    }
+
+    recordPhase("deferred messages", phaseStart);
+    return true;
+}
+
+bool ProtocolImpl::processInputs(std::size_t from)
+{
+    for (auto idx = from; idx < m_inputs.size(); ++idx) {
+        auto& i = m_inputs[idx];
+        saveCheckpoint(i.m_checkpoint);
+        if (!i.m_arena) {
+            i.m_arena.reset(new Arena);
+        }
+
+        Arena::Scope arenaScope(*i.m_arena);
+        StringPool::Scope stringsScope(idx);
+        m_currInput = idx;
+        i.m_firstRefSeq = m_refIndexSeq;
+
+        bool result = false;
+        if (!i.m_streamFile.empty()) {
+            // The file is parsed while being validated
+            auto parseStart = StatsClock::now();
+            result = validateStream(i);
+            recordFileParsed(i.m_streamFile, elapsedUs(parseStart));
+        }
+        else {
+            result = validateDoc(i.m_doc.get());
+        }
+
+        if (!result) {
             return false;
         }
+
+        m_validInputs = idx + 1U;
     }
 
+    return true;
+}
+
+bool ProtocolImpl::completeValidation()
+{
+    auto phaseStart = StatsClock::now();
+    cacheLists();
+    recordPhase("lists", phaseStart);
+
+    phaseStart = StatsClock::now();
     if (!validateAllMessages()) {
         return false;
     }
@@ -99,10 +395,404 @@ bool ProtocolImpl::validate()
         return false;
     }
 
+    recordPhase("messages", phaseStart);
+
+    if (m_compactModel) {
+        phaseStart = StatsClock::now();
+        if (!compactModel()) {
+            logError() << "Failed to compact the validated schema model.";
+            return false;
+        }
+
+        recordPhase("compact", phaseStart);
+    }
+
+    m_validated = true;
+    return true;
+}
+
+void ProtocolImpl::saveCheckpoint(ValidationCheckpoint& checkpoint) const
+{
+    checkpoint.m_platforms = m_platforms;
+    checkpoint.m_schemaExtraAttrs.clear();
+    checkpoint.m_schemaExtraChildrenCount = 0U;
+    if (m_schema) {
+        checkpoint.m_schemaExtraAttrs = m_schema->extraAttributes();
+        checkpoint.m_schemaExtraChildrenCount = m_schema->extraChildrenElements().size();
+    }
+
+    checkpoint.m_namespaces.clear();
+    std::function<void (const NamespacesMap&)> saveFunc =
+        [&checkpoint, &saveFunc](const NamespacesMap& namespaces)
+        {
+            for (auto& n : namespaces) {
+                NamespaceCheckpoint nsCheckpoint;
+                nsCheckpoint.m_ns = n.second.get();
+                nsCheckpoint.m_description = n.second->description();
+                nsCheckpoint.m_extraAttrs = n.second->extraAttributes();
+                nsCheckpoint.m_extraChildrenCount = n.second->extraChildren().size();
+                checkpoint.m_namespaces.push_back(std::move(nsCheckpoint));
+                saveFunc(n.second->namespaces());
+            }
+        };
+
+    saveFunc(m_namespaces);
+}
+
+void ProtocolImpl::restoreCheckpoint(const ValidationCheckpoint& checkpoint)
+{
+    m_platforms = checkpoint.m_platforms;
+    if (m_schema) {
+        m_schema->extraAttributes() = checkpoint.m_schemaExtraAttrs;
+        m_schema->extraChildrenElements().resize(checkpoint.m_schemaExtraChildrenCount);
+    }
+
+    for (auto& n : checkpoint.m_namespaces) {
+        assert(n.m_ns != nullptr);
+        n.m_ns->updateDescription(n.m_description);
+        n.m_ns->extraAttributes() = n.m_extraAttrs;
+        n.m_ns->extraChildren().resize(n.m_extraChildrenCount);
+    }
+}
+
+void ProtocolImpl::discardInputs(std::size_t from)
+{
+    m_deferredMessages.clear();
+    m_deferralLogs.clear();
+    m_dependencyGraph.clear();
+    if (from == 0U) {
+        m_namespaces.clear();
+        m_schema.reset();
+        m_platforms.clear();
+        m_refIndex.clear();
+        m_refIndexSeq = 0U;
+    }
+    else {
+        assert(from < m_inputs.size());
+        NamespaceImpl::DocsSet docs;
+        for (auto idx = from; idx < m_inputs.size(); ++idx) {
+            docs.insert(m_inputs[idx].m_doc.get());
+        }
+
+        for (auto iter = m_namespaces.begin(); iter != m_namespaces.end();) {
+            auto* node = iter->second->getNode();
+            if ((node != nullptr) && (docs.find(node->doc) != docs.end())) {
+                iter = m_namespaces.erase(iter);
+                continue;
+            }
+
+            iter->second->removeDefinedIn(docs);
+            if ((node == nullptr) && (iter->second->empty())) {
+                iter = m_namespaces.erase(iter);
+                continue;
+            }
+
+            ++iter;
+        }
+
+        // Namespaces present in the checkpoint were defined by preceding inputs
+        restoreCheckpoint(m_inputs[from].m_checkpoint);
+
+        // The entries are recorded in the definition order
+        auto firstSeq = m_inputs[from].m_firstRefSeq;
+        for (auto iter = m_refIndex.begin(); iter != m_refIndex.end();) {
+            if (firstSeq <= iter->second.m_seq) {
+                iter = m_refIndex.erase(iter);
+                continue;
+            }
+
+            ++iter;
+        }
+
+        m_refIndexSeq = firstSeq;
+    }
+
+    // The elements allocated in the arenas have been destroyed by now
+    for (auto idx = from; idx < m_inputs.size(); ++idx) {
+        m_inputs[idx].m_arena.reset();
+        m_inputs[idx].m_workerArenas.clear();
+        m_inputs[idx].m_firstRefSeq = std::numeric_limits<std::size_t>::max();
+    }
+
+    m_strings.discard(from);
+}
+
+std::size_t ProtocolImpl::firstDependentInput(std::size_t from) const
+{
+    // The nodes of the streamed inputs are released, the input defining
+    // the element is determined by the position of its top level parent
+    // in the reference index.
+    std::unordered_map<const Object*, std::size_t> seqs;
+    for (auto& e : m_refIndex) {
+        if (e.second.m_obj->objKind() != Object::ObjKind::Namespace) {
+            seqs.insert(std::make_pair(e.second.m_obj, e.second.m_seq));
+        }
+    }
+
+    auto inputIdxFunc =
+        [this, &seqs](const Object& obj) -> std::size_t
+        {
+            auto* elem = &obj;
+            auto iter = seqs.end();
+            while (elem != nullptr) {
+                iter = seqs.find(elem);
+                if (iter != seqs.end()) {
+                    break;
+                }
+
+                elem = elem->getParent();
+            }
+
+            auto result = m_inputs.size();
+            if (iter == seqs.end()) {
+                return result;
+            }
+
+            for (auto idx = 0U; idx < m_inputs.size(); ++idx) {
+                if (m_inputs[idx].m_firstRefSeq <= iter->second) {
+                    result = idx;
+                }
+            }
+
+            return result;
+        };
+
+    // The dependents of the elements in the discarded inputs get discarded
+    // as well, repeat until there are no more inputs to add.
+    auto result = from;
+    while (true) {
+        auto prevResult = result;
+        for (auto& n : m_dependencyGraph) {
+            if (inputIdxFunc(*n.first) < result) {
+                continue;
+            }
+
+            for (auto& e : n.second.m_reverseEdges) {
+                result = std::min(result, inputIdxFunc(*e.m_obj));
+            }
+        }
+
+        if (result == prevResult) {
+            break;
+        }
+    }
+
+    return result;
+}
+
+void ProtocolImpl::deferMessage(MessageImpl& msg)
+{
+    DeferredMessage deferred;
+    deferred.m_msg = &msg;
+    deferred.m_input = m_currInput;
+    deferred.m_logsPos = m_deferralLogs.size();
+    deferred.m_visibleRefs = m_refIndexSeq;
+    m_deferredMessages.push_back(std::move(deferred));
+}
+
+void ProtocolImpl::addToRefIndex(const std::string& ref, Object& obj)
+{
+    auto externalRef = m_strings.intern(ref);
+    obj.setExternalRef(externalRef);
+
+    RefIndexKey key;
+    key.m_kind = obj.objKind();
+    std::string buf;
+    auto& name = refIndexName(key.m_kind, externalRef, buf);
+    if (&name == &externalRef.str()) {
+        key.m_name = externalRef.ptr();
+    }
+    else {
+        key.m_name = m_strings.intern(name).ptr();
+    }
+
+    auto& entry = m_refIndex[key];
+    entry.m_obj = &obj;
+    entry.m_seq = m_refIndexSeq++;
+}
+
+bool ProtocolImpl::loadCache(const std::string& cacheFile, const FilesList& files)
+{
+    if (m_validated || (!m_inputs.empty())) {
+        logError() << "Loading cache after parsing schema files is not allowed";
+        return false;
+    }
+
+    std::uint64_t key = 0U;
+    if (!cacheKey(files, key)) {
+        return false;
+    }
+
+    MappedFile file(cacheFile);
+    if (!file.valid()) {
+        return false;
+    }
+
+    CacheReader header(file.data(), file.size());
+    if ((header.readString() != CacheMagic) ||
+        (header.readUnsigned() != CacheFormatVersion) ||
+        (header.readUnsigned() != key)) {
+        return false;
+    }
+
+    auto hash = header.readUnsigned();
+    auto len = header.readSize();
+    if ((!header.ok()) || ((file.size() - header.pos()) != len)) {
+        return false;
+    }
+
+    auto* payload = file.data() + header.pos();
+    if (fnv1a(payload, len) != hash) {
+        return false;
+    }
+
+    CacheReader reader(payload, len);
+    Arena::Scope arenaScope(m_arena);
+    if (!readModel(reader)) {
+        m_schema.reset();
+        return false;
+    }
+
     m_validated = true;
     return true;
 }
 
+bool ProtocolImpl::saveCache(const std::string& cacheFile, const FilesList& files) const
+{
+    if (!m_validated) {
+        logError() << "Cannot save cache of the schema that hasn't been validated";
+        return false;
+    }
+
+    std::uint64_t key = 0U;
+    if (!cacheKey(files, key)) {
+        return false;
+    }
+
+    CacheWriter payload;
+    writeModel(payload);
+
+    auto& payloadData = payload.data();
+    CacheWriter header;
+    header.writeString(CacheMagic);
+    header.writeUnsigned(CacheFormatVersion);
+    header.writeUnsigned(key);
+    header.writeUnsigned(fnv1a(payloadData.data(), payloadData.size()));
+    header.writeUnsigned(payloadData.size());
+
+    // Write to temporary file first to avoid leaving partially
+    // written cache behind.
+    auto tmpFile = cacheFile + ".tmp";
+    {
+        std::ofstream stream(tmpFile, std::ios_base::binary | std::ios_base::trunc);
+        stream.write(header.data().data(), static_cast<std::streamsize>(header.data().size()));
+        stream.write(payloadData.data(), static_cast<std::streamsize>(payloadData.size()));
+        stream.close();
+        if (!stream) {
+            logError() << "Failed to write cache file \"" << tmpFile << "\".";
+            std::remove(tmpFile.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(tmpFile.c_str(), cacheFile.c_str()) == 0) {
+        return true;
+    }
+
+    // Some platforms (Windows) don't replace an existing destination.
+    std::remove(cacheFile.c_str());
+    if (std::rename(tmpFile.c_str(), cacheFile.c_str()) != 0) {
+        logError() << "Failed to write cache file \"" << cacheFile << "\".";
+        std::remove(tmpFile.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void ProtocolImpl::writeModel(CacheWriter& writer) const
+{
+    m_schema->writeCache(writer);
+    writer.writeContents(m_platforms);
+    writer.writeUnsigned(m_namespaces.size());
+    for (auto& ns : m_namespaces) {
+        writer.writeString(ns.first);
+        ns.second->writeCache(writer);
+    }
+}
+
+bool ProtocolImpl::readModel(CacheReader& reader)
+{
+    // The schema must be in place before fields are created,
+    // the rest is read into temporaries and the current state
+    // is replaced only when the whole model has been loaded.
+    m_schema.reset(new SchemaImpl(nullptr, *this));
+    if (!m_schema->readCache(reader)) {
+        return false;
+    }
+
+    auto platforms = reader.readContents();
+    NamespacesMap namespaces;
+    auto count = reader.readSize();
+    for (auto idx = 0U; idx < count; ++idx) {
+        auto name = reader.readString();
+        NamespaceImpl::Ptr ns(new NamespaceImpl(nullptr, *this));
+        if (!ns->readCache(reader)) {
+            return false;
+        }
+
+        namespaces.emplace_hint(namespaces.end(), std::move(name), std::move(ns));
+    }
+
+    if ((!reader.resolveRefs()) || (!reader.atEnd())) {
+        return false;
+    }
+
+    m_platforms = std::move(platforms);
+    m_namespaces = std::move(namespaces);
+    rebuildRefIndex();
+    cacheLists();
+    return true;
+}
+
+bool ProtocolImpl::compactModel()
+{
+    // The validated model is re-created from its cache representation
+    // in a fresh arena. The copy doesn't refer to any XML nodes (the
+    // positions of the fields are recorded as strings) and its containers
+    // are exactly sized, so the documents and the original model can be
+    // released.
+    CacheWriter writer;
+    writeModel(writer);
+
+    auto prevSchema = std::move(m_schema);
+    Arena arena;
+    bool loaded = false;
+    {
+        Arena::Scope arenaScope(arena);
+        CacheReader reader(writer.data().data(), writer.data().size());
+        loaded = readModel(reader);
+    }
+
+    if (!loaded) {
+        m_schema = std::move(prevSchema);
+        return false;
+    }
+
+    if (m_statsEnabled) {
+        // Both models are alive at this point
+        m_peakModelMemory = std::max(m_peakModelMemory, modelMemory() + arena.reservedBytes());
+    }
+
+    prevSchema.reset();
+    m_inputs.clear();
+    m_inputs.shrink_to_fit();
+
+    // The previous arena gets released on exit
+    m_arena.swap(arena);
+    return true;
+}
+
 Schema ProtocolImpl::schema() const
 {
     if ((!m_validated) && (!m_schema)) {
@@ -125,45 +815,31 @@ const SchemaImpl& ProtocolImpl::schemaImpl() const
     return *m_schema;
 }
 
-ProtocolImpl::NamespacesList ProtocolImpl::namespacesList() const
-{
-    NamespacesList result;
-    result.reserve(m_namespaces.size());
-    for (auto& n : m_namespaces) {
-        result.emplace_back(n.second.get());
-    }
-    return result;
-}
-
 const FieldImpl* ProtocolImpl::findField(const std::string& ref, bool checkRef) const
 {
-    std::string fieldName;
-    auto ns = getNsFromPath(ref, checkRef, fieldName);
-    if (ns == nullptr) {
+    if (!checkRefName(ref, checkRef)) {
         return nullptr;
     }
-    return ns->findField(fieldName);
+
+    return static_cast<const FieldImpl*>(findInRefIndex(Object::ObjKind::Field, ref));
 }
 
 const MessageImpl* ProtocolImpl::findMessage(const std::string& ref, bool checkRef) const
 {
-    std::string msgName;
-    auto ns = getNsFromPath(ref, checkRef, msgName);
-    if (ns == nullptr) {
+    if (!checkRefName(ref, checkRef)) {
         return nullptr;
     }
-    return ns->findMessage(msgName);
+
+    return static_cast<const MessageImpl*>(findInRefIndex(Object::ObjKind::Message, ref));
 }
 
 const InterfaceImpl* ProtocolImpl::findInterface(const std::string& ref, bool checkRef) const
 {
-    std::string name;
-    auto ns = getNsFromPath(ref, checkRef, name);
-    if (ns == nullptr) {
+    if (!checkRefName(ref, checkRef)) {
         return nullptr;
     }
 
-    return ns->findInterface(name);
+    return static_cast<const InterfaceImpl*>(findInRefIndex(Object::ObjKind::Interface, ref));
 }
 
 bool ProtocolImpl::strToEnumValue(
@@ -204,6 +880,7 @@ bool ProtocolImpl::strToEnumValue(
     }
 
     val = enumValueIter->second.m_value;
+    Object::recordValueRef(*field);
     return true;
 }
 
@@ -216,9 +893,9 @@ bool ProtocolImpl::strToNumeric(
     return
         strToValue(
             ref, checkRef,
-            [&val, &isBigUnsigned](const NamespaceImpl& ns, const std::string& str) -> bool
+            [&val, &isBigUnsigned](const FieldImpl& f, const std::string& str) -> bool
             {
-               return ns.strToNumeric(str, val, isBigUnsigned);
+               return f.strToNumeric(str, val, isBigUnsigned);
             });
 }
 
@@ -230,9 +907,9 @@ bool ProtocolImpl::strToFp(
     return
         strToValue(
             ref, checkRef,
-            [&val](const NamespaceImpl& ns, const std::string& str) -> bool
+            [&val](const FieldImpl& f, const std::string& str) -> bool
             {
-               return ns.strToFp(str, val);
+               return f.strToFp(str, val);
             });
 }
 
@@ -244,9 +921,9 @@ bool ProtocolImpl::strToBool(
     return
         strToValue(
             ref, checkRef,
-            [&val](const NamespaceImpl& ns, const std::string& str) -> bool
+            [&val](const FieldImpl& f, const std::string& str) -> bool
             {
-               return ns.strToBool(str, val);
+               return f.strToBool(str, val);
             });
 }
 
@@ -258,59 +935,404 @@ bool ProtocolImpl::strToString(
     return
         strToValue(
             ref, checkRef,
-            [&val](const NamespaceImpl& ns, const std::string& str) -> bool
+            [&val](const FieldImpl& f, const std::string& str) -> bool
+            {
+               return f.strToString(str, val);
+            });
+}
+
+bool ProtocolImpl::strToData(
+    const std::string& ref,
+    bool checkRef,
+    std::vector<std::uint8_t>& val) const
+{
+    return
+        strToValue(
+            ref, checkRef,
+            [&val](const FieldImpl& f, const std::string& str) -> bool
+            {
+               return f.strToData(str, val);
+            });
+}
+
+void ProtocolImpl::cacheLists()
+{
+    for (auto& ns : m_namespaces) {
+        ns.second->cacheLists();
+    }
+
+    m_namespacesList.clear();
+    m_namespacesList.reserve(m_namespaces.size());
+    for (auto& n : m_namespaces) {
+        m_namespacesList.emplace_back(n.second.get());
+    }
+
+    auto total =
+        std::accumulate(
+            m_namespaces.begin(), m_namespaces.end(), static_cast<std::size_t>(0U),
+            [](std::size_t soFar, auto& ns) -> std::size_t
+            {
+                return soFar + ns.second->messages().size();
+            });
+
+    m_allMessages.clear();
+    m_allMessages.reserve(total);
+    for (auto& ns : m_namespaces) {
+        auto& nsMsgs = ns.second->messagesList();
+        m_allMessages.insert(m_allMessages.end(), nsMsgs.begin(), nsMsgs.end());
+    }
+
+    std::sort(
+        m_allMessages.begin(), m_allMessages.end(),
+        [](const auto& msg1, const auto& msg2)
+        {
+            assert(msg1.valid());
+            assert(msg2.valid());
+            auto id1 = msg1.id();
+            auto id2 = msg2.id();
+            if (id1 != id2) {
+                return id1 < id2;
+            }
+
+            return msg1.order() < msg2.order();
+        });
+
+    buildMessageIdIndex();
+    buildDependencyGraph();
+}
+
+void ProtocolImpl::buildMessageIdIndex()
+{
+    m_messageIds.clear();
+    m_messageIdOffsets.clear();
+    m_messageIdTable.clear();
+
+    for (auto idx = 0U; idx < m_allMessages.size(); ++idx) {
+        auto id = m_allMessages[idx].id();
+        if ((!m_messageIds.empty()) && (m_messageIds.back() == id)) {
+            continue;
+        }
+
+        m_messageIds.push_back(id);
+        m_messageIdOffsets.push_back(idx);
+    }
+
+    m_messageIdOffsets.push_back(m_allMessages.size());
+
+    if (m_messageIds.empty()) {
+        return;
+    }
+
+    static const std::uintmax_t MaxTableGapFactor = 2U;
+    static const std::uintmax_t MinTableSize = 64U;
+    auto idsRange = m_messageIds.back() - m_messageIds.front();
+    if ((MinTableSize + (m_messageIds.size() * MaxTableGapFactor)) <= idsRange) {
+        return;
+    }
+
+    m_messageIdTable.resize(static_cast<std::size_t>(idsRange + 1U), m_messageIds.size());
+    for (auto idx = 0U; idx < m_messageIds.size(); ++idx) {
+        m_messageIdTable[static_cast<std::size_t>(m_messageIds[idx] - m_messageIds.front())] = idx;
+    }
+}
+
+void ProtocolImpl::buildDependencyGraph()
+{
+    m_dependencyGraph.clear();
+    for (auto& ns : m_namespaces) {
+        ns.second->collectDependencies(
+            [this](const Object& elem, DependencyKind kind, const Object& obj)
             {
-               return ns.strToString(str, val);
+                if (&elem == &obj) {
+                    return;
+                }
+
+                auto& forwardEdges = m_dependencyGraph[&elem].m_forwardEdges;
+                auto iter =
+                    std::find_if(
+                        forwardEdges.begin(), forwardEdges.end(),
+                        [kind, &obj](auto& e)
+                        {
+                            return (e.m_kind == kind) && (e.m_obj == &obj);
+                        });
+
+                if (iter != forwardEdges.end()) {
+                    return;
+                }
+
+                forwardEdges.push_back(DependencyEdge{kind, &obj});
+                m_dependencyGraph[&obj].m_reverseEdges.push_back(DependencyEdge{kind, &elem});
             });
+    }
+
+    auto toInfoList =
+        [](const DependencyEdgesList& edges)
+        {
+            DependenciesList list;
+            list.reserve(edges.size());
+            for (auto& e : edges) {
+                list.push_back(Protocol::DependencyInfo{e.m_kind, elementInfo(*e.m_obj)});
+            }
+            return list;
+        };
+
+    for (auto& n : m_dependencyGraph) {
+        n.second.m_dependencies = toInfoList(n.second.m_forwardEdges);
+        n.second.m_dependents = toInfoList(n.second.m_reverseEdges);
+    }
+}
+
+const ProtocolImpl::DependencyNode* ProtocolImpl::findDependencyNode(ElementKind kind, const std::string& externalRef) const
+{
+    static const Object::ObjKind Map[] = {
+        /* Field */ Object::ObjKind::Field,
+        /* Message */ Object::ObjKind::Message,
+        /* Interface */ Object::ObjKind::Interface,
+        /* Frame */ Object::ObjKind::Frame,
+    };
+
+    static const std::size_t MapSize = std::extent<decltype(Map)>::value;
+    static_assert(MapSize == static_cast<std::size_t>(ElementKind::NumOfValues), "Invalid map");
+
+    auto idx = static_cast<std::size_t>(kind);
+    if (MapSize <= idx) {
+        return nullptr;
+    }
+
+    auto* obj = findInRefIndex(Map[idx], externalRef);
+    if (obj == nullptr) {
+        return nullptr;
+    }
+
+    auto iter = m_dependencyGraph.find(obj);
+    if (iter == m_dependencyGraph.end()) {
+        return nullptr;
+    }
+
+    return &iter->second;
+}
+
+ProtocolImpl::ElementInfo ProtocolImpl::elementInfo(const Object& obj)
+{
+    ElementInfo info;
+    switch (obj.objKind()) {
+        case Object::ObjKind::Field:
+            info.m_kind = ElementKind::Field;
+            info.m_externalRef = static_cast<const FieldImpl&>(obj).externalRef();
+            break;
+        case Object::ObjKind::Message:
+            info.m_kind = ElementKind::Message;
+            info.m_externalRef = static_cast<const MessageImpl&>(obj).externalRef();
+            break;
+        case Object::ObjKind::Interface:
+            info.m_kind = ElementKind::Interface;
+            info.m_externalRef = static_cast<const InterfaceImpl&>(obj).externalRef();
+            break;
+        case Object::ObjKind::Frame:
+            info.m_kind = ElementKind::Frame;
+            info.m_externalRef = static_cast<const FrameImpl&>(obj).externalRef();
+            break;
+        default: {
+            static constexpr bool Unexpected_element_kind = false;
+            static_cast<void>(Unexpected_element_kind);
+            assert(Unexpected_element_kind);
+            break;
+        }
+    }
+
+    return info;
+}
+
+std::size_t ProtocolImpl::messageIdOrdinal(std::uintmax_t id) const
+{
+    if (m_messageIds.empty() || (id < m_messageIds.front()) || (m_messageIds.back() < id)) {
+        return m_messageIds.size();
+    }
+
+    if (!m_messageIdTable.empty()) {
+        return m_messageIdTable[static_cast<std::size_t>(id - m_messageIds.front())];
+    }
+
+    auto iter = std::lower_bound(m_messageIds.begin(), m_messageIds.end(), id);
+    if ((iter == m_messageIds.end()) || (*iter != id)) {
+        return m_messageIds.size();
+    }
+
+    return static_cast<std::size_t>(std::distance(m_messageIds.begin(), iter));
+}
+
+ProtocolImpl::MessagesRange ProtocolImpl::messagesByIdOrdinal(std::size_t ordinal) const
+{
+    if (m_messageIds.size() <= ordinal) {
+        return std::make_pair(m_allMessages.end(), m_allMessages.end());
+    }
+
+    assert((ordinal + 1U) < m_messageIdOffsets.size());
+    auto begIter = m_allMessages.begin() + static_cast<std::ptrdiff_t>(m_messageIdOffsets[ordinal]);
+    auto endIter = m_allMessages.begin() + static_cast<std::ptrdiff_t>(m_messageIdOffsets[ordinal + 1U]);
+    return std::make_pair(begIter, endIter);
+}
+
+const ProtocolImpl::DependenciesList& ProtocolImpl::dependencies(ElementKind kind, const std::string& externalRef) const
+{
+    auto* node = findDependencyNode(kind, externalRef);
+    if (node == nullptr) {
+        static const DependenciesList EmptyList;
+        return EmptyList;
+    }
+
+    return node->m_dependencies;
+}
+
+const ProtocolImpl::DependenciesList& ProtocolImpl::dependents(ElementKind kind, const std::string& externalRef) const
+{
+    auto* node = findDependencyNode(kind, externalRef);
+    if (node == nullptr) {
+        static const DependenciesList EmptyList;
+        return EmptyList;
+    }
+
+    return node->m_dependents;
+}
+
+ProtocolImpl::ElementsList ProtocolImpl::allDependents(ElementKind kind, const std::string& externalRef) const
+{
+    ElementsList result;
+    auto* node = findDependencyNode(kind, externalRef);
+    if (node == nullptr) {
+        return result;
+    }
+
+    // Breadth first traversal of the reverse edges, the closest dependents are listed first
+    std::vector<const DependencyNode*> queue = {node};
+    std::unordered_set<const DependencyNode*> visited = {node};
+    for (auto idx = 0U; idx < queue.size(); ++idx) {
+        for (auto& e : queue[idx]->m_reverseEdges) {
+            auto iter = m_dependencyGraph.find(e.m_obj);
+            assert(iter != m_dependencyGraph.end());
+            if (!visited.insert(&iter->second).second) {
+                continue;
+            }
+
+            queue.push_back(&iter->second);
+            result.push_back(elementInfo(*e.m_obj));
+        }
+    }
+
+    return result;
+}
+
+ProtocolImpl::Stats ProtocolImpl::stats() const
+{
+    Stats result;
+    if (!m_statsEnabled) {
+        return result;
+    }
+
+    result.m_files = m_fileStats;
+    result.m_phases = m_phaseStats;
+
+    auto countElementsFunc =
+        [&result](ElementKind kind, std::size_t count)
+        {
+            result.m_elementsCount[static_cast<std::size_t>(kind)] += count;
+        };
+
+    std::vector<const NamespaceImpl*> namespaces;
+    for (auto& ns : m_namespaces) {
+        namespaces.push_back(ns.second.get());
+    }
+
+    while (!namespaces.empty()) {
+        auto* ns = namespaces.back();
+        namespaces.pop_back();
+        assert(ns != nullptr);
+        for (auto& n : ns->namespaces()) {
+            namespaces.push_back(n.second.get());
+        }
+
+        ++result.m_namespacesCount;
+        countElementsFunc(ElementKind::Field, ns->fieldsList().size());
+        countElementsFunc(ElementKind::Message, ns->messagesList().size());
+        countElementsFunc(ElementKind::Interface, ns->interfacesList().size());
+        countElementsFunc(ElementKind::Frame, ns->framesList().size());
+        for (auto& f : ns->framesList()) {
+            result.m_layersCount += f.layers().size();
+        }
+    }
+
+    for (auto idx = 0U; idx < result.m_createdFieldsCount.size(); ++idx) {
+        result.m_createdFieldsCount[idx] = m_statsCounters.m_createdFields[idx];
+    }
+
+    result.m_reusedFieldsCount = m_statsCounters.m_reusedFields;
+    result.m_clonedFieldsCount = m_statsCounters.m_clonedFields;
+    result.m_reuseBytes = m_statsCounters.m_reuseBytes;
+    result.m_refLookupsCount = m_statsCounters.m_refLookups;
+    result.m_failedRefLookupsCount = m_statsCounters.m_failedRefLookups;
+    result.m_peakModelMemory = std::max(m_peakModelMemory, modelMemory());
+    result.m_internedStringsCount = m_strings.size();
+    return result;
+}
+
+void ProtocolImpl::recordFieldCreated(Field::Kind kind)
+{
+    if (m_statsEnabled) {
+        ++m_statsCounters.m_createdFields[static_cast<std::size_t>(kind)];
+    }
 }
 
-bool ProtocolImpl::strToData(
-    const std::string& ref,
-    bool checkRef,
-    std::vector<std::uint8_t>& val) const
+void ProtocolImpl::recordFieldCloned()
 {
-    return
-        strToValue(
-            ref, checkRef,
-            [&val](const NamespaceImpl& ns, const std::string& str) -> bool
-            {
-               return ns.strToData(str, val);
-            });
+    if (m_statsEnabled) {
+        ++m_statsCounters.m_clonedFields;
+    }
 }
 
-ProtocolImpl::MessagesList ProtocolImpl::allMessages() const
+void ProtocolImpl::recordFieldReused(std::size_t bytes)
 {
-    auto total =
-        std::accumulate(
-            m_namespaces.begin(), m_namespaces.end(), static_cast<std::size_t>(0U),
-            [](std::size_t soFar, auto& ns) -> std::size_t
-            {
-                return soFar + ns.second->messages().size();
-            });
+    if (m_statsEnabled) {
+        ++m_statsCounters.m_reusedFields;
+        m_statsCounters.m_reuseBytes += bytes;
+    }
+}
 
-    NamespaceImpl::MessagesList messages;
-    messages.reserve(total);
-    for (auto& ns : m_namespaces) {
-        auto nsMsgs = ns.second->messagesList();
-        messages.insert(messages.end(), nsMsgs.begin(), nsMsgs.end());
+void ProtocolImpl::recordFileParsed(const std::string& file, std::uint64_t parseTimeUs)
+{
+    if (m_statsEnabled) {
+        m_fileStats.push_back(Protocol::FileStats{file, parseTimeUs});
     }
+}
 
-    std::sort(
-        messages.begin(), messages.end(),
-        [](const auto& msg1, const auto& msg2)
-        {
-            assert(msg1.valid());
-            assert(msg2.valid());
-            auto id1 = msg1.id();
-            auto id2 = msg2.id();
-            if (id1 != id2) {
-                return id1 < id2;
-            }
+void ProtocolImpl::recordPhase(const std::string& name, StatsClock::time_point start)
+{
+    if (!m_statsEnabled) {
+        return;
+    }
 
-            return msg1.order() < msg2.order();
-        });
+    m_phaseStats.push_back(Protocol::PhaseStats{name, elapsedUs(start)});
+    m_peakModelMemory = std::max(m_peakModelMemory, modelMemory());
+}
+
+std::size_t ProtocolImpl::modelMemory() const
+{
+    return
+        std::accumulate(
+            m_inputs.begin(), m_inputs.end(), m_arena.reservedBytes(),
+            [](std::size_t soFar, const SchemaInput& i) -> std::size_t
+            {
+                if (i.m_arena) {
+                    soFar += i.m_arena->reservedBytes();
+                }
 
-    return messages;
+                return
+                    std::accumulate(
+                        i.m_workerArenas.begin(), i.m_workerArenas.end(), soFar,
+                        [](std::size_t soFarInternal, const ArenaPtr& a) -> std::size_t
+                        {
+                            return soFarInternal + a->reservedBytes();
+                        });
+            });
 }
 
 bool ProtocolImpl::isFeatureSupported(unsigned minDslVersion) const
@@ -349,12 +1371,88 @@ bool ProtocolImpl::isFieldAliasSupported() const
     return isFeatureSupported(3U);
 }
 
+ProtocolImpl::XmlParserCtxtPtr ProtocolImpl::createParserCtxt(XmlErrorsList& errors)
+{
+    XmlParserCtxtPtr ctxt(::xmlNewParserCtxt());
+    if (!ctxt) {
+        return ctxt;
+    }
+
+    // Report errors via the parser context rather than global handler
+    // to allow independent parsing on multiple threads.
+    ctxt->_private = &errors;
+    ctxt->sax->serror = &ProtocolImpl::cbXmlErrorFunc;
+    return ctxt;
+}
+
+ProtocolImpl::ParseResult ProtocolImpl::parseFile(const std::string& input)
+{
+    // Mapping the file doesn't save anything, xmlCtxtReadMemory() copies
+    // the whole buffer.
+    auto parseStart = StatsClock::now();
+    ParseResult result;
+    auto ctxt = createParserCtxt(result.m_errors);
+    if (ctxt) {
+        result.m_doc.reset(::xmlCtxtReadFile(ctxt.get(), input.c_str(), nullptr, 0));
+    }
+    result.m_parseTimeUs = elapsedUs(parseStart);
+    return result;
+}
+
+ProtocolImpl::ParseResult ProtocolImpl::parseMemory(const char* data, std::size_t len, const std::string& name)
+{
+    auto parseStart = StatsClock::now();
+    ParseResult result;
+    auto ctxt = createParserCtxt(result.m_errors);
+    if (ctxt) {
+        result.m_doc.reset(
+            ::xmlCtxtReadMemory(ctxt.get(), data, static_cast<int>(len), name.c_str(), nullptr, 0));
+    }
+    result.m_parseTimeUs = elapsedUs(parseStart);
+    return result;
+}
+
+bool ProtocolImpl::processParseResult(const std::string& input, ParseResult& result)
+{
+    reportXmlErrors(result.m_errors);
+    recordFileParsed(input, result.m_parseTimeUs);
+
+    if (!result.m_doc) {
+        logError() << input << ": Failed to parse the schema.";
+        return false;
+    }
+
+    SchemaInput schemaInput;
+    schemaInput.m_doc = std::move(result.m_doc);
+    m_inputs.push_back(std::move(schemaInput));
+    return true;
+}
+
+void ProtocolImpl::reportXmlErrors(const XmlErrorsList& errors)
+{
+    for (auto& e : errors) {
+        m_logger.report(e.m_level, e.m_msg);
+    }
+}
+
 void ProtocolImpl::cbXmlErrorFunc(void* userData, xmlErrorPtr err)
 {
-    reinterpret_cast<ProtocolImpl*>(userData)->handleXmlError(err);
+    auto* ctxt = reinterpret_cast<::xmlParserCtxtPtr>(userData);
+    assert(ctxt != nullptr);
+    assert(ctxt->_private != nullptr);
+    handleXmlError(err, *reinterpret_cast<XmlErrorsList*>(ctxt->_private));
+}
+
+void ProtocolImpl::cbStreamErrorFunc(void* userData, xmlErrorPtr err)
+{
+    auto* protocol = reinterpret_cast<ProtocolImpl*>(userData);
+    assert(protocol != nullptr);
+    XmlErrorsList errors;
+    handleXmlError(err, errors);
+    protocol->reportXmlErrors(errors);
 }
 
-void ProtocolImpl::handleXmlError(xmlErrorPtr err)
+void ProtocolImpl::handleXmlError(xmlErrorPtr err, XmlErrorsList& errors)
 {
     static const ErrorLevel Map[] = {
         /* XML_ERR_NONE */ ErrorLevel_Debug,
@@ -366,28 +1464,31 @@ void ProtocolImpl::handleXmlError(xmlErrorPtr err)
     static_assert(XML_ERR_NONE == 0, "Invalid assumption");
     static_assert(XML_ERR_FATAL == 3, "Invalid assumption");
 
-    ErrorLevel level = ErrorLevel_Error;
-    if ((XML_ERR_NONE <= err->level) && (err->level <= XML_ERR_FATAL)) {
-        level = Map[err->level];
-    }
-
-    m_logger.setCurrLevel(level);
+    XmlError info;
     do {
         if (err == nullptr) {
             break;
         }
 
+        if ((XML_ERR_NONE <= err->level) && (err->level <= XML_ERR_FATAL)) {
+            info.m_level = Map[err->level];
+        }
+
         if (err->file != nullptr) {
-            m_logger << std::string(err->file) << ':';
+            info.m_msg += err->file;
+            info.m_msg += ':';
         }
 
         if (err->line != 0) {
-            m_logger << err->line << ": ";
+            info.m_msg += std::to_string(err->line);
+            info.m_msg += ": ";
         }
 
-        m_logger << err->message;
+        if (err->message != nullptr) {
+            info.m_msg += err->message;
+        }
     } while (false);
-    m_logger.flush();
+    errors.push_back(std::move(info));
 }
 
 bool ProtocolImpl::validateDoc(::xmlDocPtr doc)
@@ -555,77 +1656,264 @@ bool ProtocolImpl::validateNamespaces(::xmlNodePtr root)
                 return false;
             }
 
-            auto& nsName = ns->name();
-            auto iter = m_namespaces.find(nsName);
-            NamespaceImpl* nsToProcess = nullptr;
-            NamespaceImpl* realNs = nullptr;
-            do {
-                if (iter == m_namespaces.end()) {
-                    m_namespaces.insert(std::make_pair(nsName, std::move(ns)));
-                    iter = m_namespaces.find(nsName);
-                    assert(iter != m_namespaces.end());
-                    nsToProcess = iter->second.get();
-                    break;
-                }
+            if (!addNamespace(std::move(ns))->parseChildren(c)) {
+                return false;
+            }
 
-                nsToProcess = ns.get();
-                realNs = iter->second.get();
-
-                if ((!nsToProcess->description().empty()) &&
-                    (nsToProcess->description() != realNs->description())) {
-                    if (realNs->description().empty()) {
-                        realNs->updateDescription(nsToProcess->description());
-                    }
-                    else {
-                        logWarning() << XmlWrap::logPrefix(nsToProcess->getNode()) <<
-                            "Description of namespace \"" << nsToProcess->name() << "\" differs to "
-                            "one encountered before.";
-                    }
-                }
+            continue;
+        }
+
+        if (!globalNamespace().processChild(c)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ProtocolImpl::validateStream(SchemaInput& input)
+{
+    XmlStream stream(input.m_streamFile, &ProtocolImpl::cbStreamErrorFunc, this);
+    if (!stream.valid()) {
+        logError() << "Failed to open schema file \"" << input.m_streamFile << "\"";
+        return false;
+    }
+
+    m_streamParsing = true;
+    bool result = validateStreamRoot(stream, input);
+    m_streamParsing = false;
+
+    if (stream.failed()) {
+        logError() << "Failed to parse " << input.m_streamFile;
+        return false;
+    }
+
+    return result;
+}
+
+bool ProtocolImpl::validateStreamRoot(XmlStream& stream, SchemaInput& input)
+{
+    if (!stream.nextChild(-1)) {
+        return false;
+    }
+
+    auto* root = stream.node();
+    static const std::string SchemaName("schema");
+    if (SchemaName != reinterpret_cast<const char*>(root->name)) {
+        logError() << "Root element of \"" << input.m_streamFile << "\" is not \"" << SchemaName << '\"';
+        return false;
+    }
 
-                if (!nsToProcess->extraAttributes().empty()) {
-                    for (auto& a : nsToProcess->extraAttributes()) {
-                        auto attIter = realNs->extraAttributes().find(a.first);
-                        if (attIter == realNs->extraAttributes().end()) {
-                            realNs->extraAttributes().insert(a);
-                        }
-                        else if (a.second != attIter->second) {
-                            logWarning() << XmlWrap::logPrefix(nsToProcess->getNode()) <<
-                                "Value of attribute \"" << a.first << "\" differs to one defined before.";
-                        }
-                    }
+    // Only the elements that are not definitions are retained in
+    // the skeleton document, the definitions are processed one at a time
+    // and their nodes are released by the reader.
+    input.m_doc.reset(::xmlNewDoc(root->doc->version));
+    if (root->doc->URL != nullptr) {
+        input.m_doc->URL = ::xmlStrdup(root->doc->URL);
+    }
+
+    auto* skeletonRoot = ::xmlDocCopyNode(root, input.m_doc.get(), 2);
+    ::xmlDocSetRootElement(input.m_doc.get(), skeletonRoot);
+
+    return
+        stream.processChildren(
+            skeletonRoot,
+            NamespaceImpl::supportedChildren(),
+            m_logger,
+            [this, skeletonRoot]()
+            {
+                return
+                    validateSchema(skeletonRoot) &&
+                    validatePlatforms(skeletonRoot);
+            },
+            [this, &stream, skeletonRoot]()
+            {
+                if (common::nsStr() != reinterpret_cast<const char*>(stream.node()->name)) {
+                    return globalNamespace().streamChild(stream, skeletonRoot);
                 }
 
-                realNs->extraChildren().insert(realNs->extraChildren().end(), nsToProcess->extraChildren().begin(), nsToProcess->extraChildren().end());
+                NamespaceImplPtr ns(new NamespaceImpl(stream.copyElement(skeletonRoot), *this));
+                return
+                    NamespaceImpl::streamNamespace(
+                        stream,
+                        std::move(ns),
+                        [this](NamespaceImplPtr childNs)
+                        {
+                            return addNamespace(std::move(childNs));
+                        });
+            });
+}
 
-            } while (false);
+NamespaceImpl* ProtocolImpl::addNamespace(NamespaceImplPtr ns)
+{
+    auto& nsName = ns->name();
+    auto iter = m_namespaces.find(nsName);
+    if (iter == m_namespaces.end()) {
+        auto* nsPtr = ns.get();
+        m_namespaces.insert(std::make_pair(nsName, std::move(ns)));
+        addToRefIndex(nsPtr->name(), *nsPtr);
+        return nsPtr;
+    }
 
-            assert(iter->second);
-            if (!nsToProcess->parseChildren(realNs)) {
-                return false;
-            }
+    auto* realNs = iter->second.get();
+    realNs->mergeProps(*ns);
+    return realNs;
+}
 
-            continue;
+NamespaceImpl& ProtocolImpl::globalNamespace()
+{
+    auto& globalNsPtr = m_namespaces[common::emptyString()]; // create if needed
+    if (!globalNsPtr) {
+        globalNsPtr.reset(new NamespaceImpl(nullptr, *this));
+    }
+
+    return *globalNsPtr;
+}
+
+bool ProtocolImpl::completeDeferredMessage(const MessageImpl& msg)
+{
+    auto iter =
+        std::find_if(
+            m_deferredMessages.begin(), m_deferredMessages.end(),
+            [&msg](const DeferredMessage& m)
+            {
+                return m.m_msg == &msg;
+            });
+
+    if (iter == m_deferredMessages.end()) {
+        assert(msg.fieldsParsed());
+        return true;
+    }
+
+    if (!iter->m_parsed) {
+        // The fields belong to the input that defined the message
+        assert(iter->m_input < m_inputs.size());
+        parseDeferredMessage(*iter, *m_inputs[iter->m_input].m_arena);
+    }
+
+    return iter->m_ok;
+}
+
+bool ProtocolImpl::validateDeferredMessages(bool inputsValid)
+{
+    std::vector<DeferredMessage*> messages;
+    messages.reserve(m_deferredMessages.size());
+    for (auto& m : m_deferredMessages) {
+        if (!m.m_parsed) {
+            messages.push_back(&m);
         }
+    }
 
-        auto& globalNsPtr = m_namespaces[common::emptyString()]; // create if needed
-        if (!globalNsPtr) {
-            globalNsPtr.reset(new NamespaceImpl(nullptr, *this));
+    auto jobs = m_validationJobs;
+    if (jobs == 0U) {
+        jobs = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    // Every worker thread allocates in its own arena of the input
+    // that defined the processed message.
+    auto threadsCount = std::min(static_cast<std::size_t>(jobs), messages.size());
+    for (auto* m : messages) {
+        assert(m->m_input < m_inputs.size());
+        auto& workerArenas = m_inputs[m->m_input].m_workerArenas;
+        while (workerArenas.size() < threadsCount) {
+            workerArenas.emplace_back(new Arena);
         }
+    }
 
-        if (!globalNsPtr->processChild(c)) {
-            return false;
+    std::atomic<std::size_t> nextIdx(0U);
+    std::atomic<bool> failed(false);
+    auto worker =
+        [this, &messages, &nextIdx, &failed](std::size_t threadIdx)
+        {
+            while (!failed) {
+                auto idx = nextIdx++;
+                if (messages.size() <= idx) {
+                    break;
+                }
+
+                auto& deferred = *messages[idx];
+                parseDeferredMessage(deferred, *m_inputs[deferred.m_input].m_workerArenas[threadIdx]);
+                if (!deferred.m_ok) {
+                    failed = true;
+                }
+            }
+        };
+
+    std::vector<std::thread> threads;
+    if (1U < threadsCount) {
+        threads.reserve(threadsCount - 1U);
+        for (auto idx = 1U; idx < threadsCount; ++idx) {
+            threads.emplace_back(worker, idx);
         }
     }
 
-    return true;
+    if (!messages.empty()) {
+        worker(0U);
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // The collected output is reported in the definition order and
+    // stops at the first failure, like with the sequential processing.
+    // The messages following the failed one haven't been processed.
+    auto reportLogsFunc =
+        [this](std::size_t from, std::size_t until)
+        {
+            for (auto idx = from; idx < until; ++idx) {
+                auto& e = m_deferralLogs[idx];
+                m_logger.report(e.m_level, e.m_msg);
+            }
+        };
+
+    bool result = inputsValid;
+    std::size_t logsPos = 0U;
+    for (auto& m : m_deferredMessages) {
+        assert(logsPos <= m.m_logsPos);
+        reportLogsFunc(logsPos, m.m_logsPos);
+        logsPos = m.m_logsPos;
+        reportXmlErrors(m.m_logs);
+        if (!m.m_ok) {
+            // The input needs to be re-validated on update
+            m_validInputs = std::min(m_validInputs, m.m_input);
+            result = false;
+            logsPos = m_deferralLogs.size();
+            break;
+        }
+    }
+
+    reportLogsFunc(logsPos, m_deferralLogs.size());
+    m_deferredMessages.clear();
+    m_deferralLogs.clear();
+    return result;
+}
+
+void ProtocolImpl::parseDeferredMessage(DeferredMessage& deferred, Arena& arena)
+{
+    Arena::Scope arenaScope(arena);
+    StringPool::Scope stringsScope(deferred.m_input);
+    VisibleRefsScope visibleRefsScope(deferred.m_visibleRefs);
+    Logger logger(
+        [&deferred](ErrorLevel level, const std::string& msg)
+        {
+            XmlError info;
+            info.m_level = level;
+            info.m_msg = msg;
+            deferred.m_logs.push_back(std::move(info));
+        });
+    logger.setMinLevel(m_minLevel);
+
+    Logger::Redirect redirect(logger);
+    deferred.m_ok = deferred.m_msg->parseFields();
+    deferred.m_parsed = true;
 }
 
 bool ProtocolImpl::validateAllMessages()
 {
     assert(m_schema);
     bool allowNonUniquIds = m_schema->nonUniqueMsgIdAllowed();
-    auto allMsgs = allMessages();
+    auto& allMsgs = allMessages();
     if (allMsgs.empty()) {
         return true;
     }
@@ -670,120 +1958,171 @@ unsigned ProtocolImpl::countMessageIds() const
             });
 }
 
-const NamespaceImpl* ProtocolImpl::getNsFromPath(const std::string& ref, bool checkRef, std::string& remName) const
+bool ProtocolImpl::strToValue(const std::string& ref, bool checkRef, StrToValueConvertFunc&& func) const
 {
-    if (checkRef) {
+    do {
+        if (!checkRef) {
+            assert(common::isValidRefName(ref));
+            break;
+        }
+
+
         if (!common::isValidRefName(ref)) {
-            logInfo(m_logger) << "Invalid ref name: " << ref;
-            return nullptr;
+            return false;
+        }
+
+    } while (false);
+
+    // Leading elements referring to namespaces are skipped,
+    // the first element that follows is the name of the field.
+    std::size_t fieldPos = 0U;
+    auto dotPos = ref.find_first_of('.');
+    while (dotPos != std::string::npos) {
+        if (findInRefIndex(Object::ObjKind::Namespace, std::string(ref, 0, dotPos)) == nullptr) {
+            break;
         }
+
+        fieldPos = dotPos + 1;
+        dotPos = ref.find_first_of('.', fieldPos);
     }
-    else {
-        assert(common::isValidRefName(ref));
+
+    auto* field = findInRefIndex(Object::ObjKind::Field, std::string(ref, 0, dotPos));
+    if (field == nullptr) {
+        return false;
     }
 
+    std::string subRef;
+    if (dotPos != std::string::npos) {
+        subRef.assign(ref, dotPos + 1, std::string::npos);
+    }
 
-    auto nameSepPos = ref.find_last_of('.');
-    const NamespaceImpl* ns = nullptr;
-    do {
-        if (nameSepPos == std::string::npos) {
-            auto iter = m_namespaces.find(common::emptyString());
-            if (iter == m_namespaces.end()) {
-                return nullptr;
-            }
+    if (!func(static_cast<const FieldImpl&>(*field), subRef)) {
+        return false;
+    }
 
-            remName = ref;
-            ns = iter->second.get();
-            assert(ns != nullptr);
-            break;
-        }
-        
-        auto signedNameSepPos = static_cast<std::ptrdiff_t>(nameSepPos);
-        remName.assign(ref.begin() + signedNameSepPos + 1, ref.end());
-        std::size_t nsNamePos = 0;
-        assert(nameSepPos != std::string::npos);
-        while (nsNamePos < nameSepPos) {
-            auto nextDotPos = ref.find_first_of('.', nsNamePos);
-            assert(nextDotPos != std::string::npos);
-            std::string nsName(
-                    ref.begin() + static_cast<std::ptrdiff_t>(nsNamePos), 
-                    ref.begin() + static_cast<std::ptrdiff_t>(nextDotPos));
-            if (nsName.empty()) {
-                return nullptr;
-            }
+    Object::recordValueRef(*field);
+    return true;
+}
 
-            auto* nsMap = &m_namespaces;
-            if (ns != nullptr) {
-                nsMap = &(ns->namespacesMap());
-            }
+bool ProtocolImpl::checkRefName(const std::string& ref, bool checkRef) const
+{
+    if (!checkRef) {
+        assert(common::isValidRefName(ref));
+        return true;
+    }
 
-            auto iter = nsMap->find(nsName);
-            if (iter == nsMap->end()) {
-                return nullptr;
-            }
+    if (!common::isValidRefName(ref)) {
+        logInfo(logger()) << "Invalid ref name: " << ref;
+        return false;
+    }
+
+    return true;
+}
+
+const Object* ProtocolImpl::findInRefIndex(Object::ObjKind kind, const std::string& ref) const
+{
+    // The name that has never been interned isn't recorded in the index
+    std::string buf;
+    InternedString name;
+    auto iter = m_refIndex.end();
+    if (m_strings.find(refIndexName(kind, ref, buf), name)) {
+        RefIndexKey key;
+        key.m_name = name.ptr();
+        key.m_kind = kind;
+        iter = m_refIndex.find(key);
+    }
 
-            assert(iter->second);
-            ns = iter->second.get();
-            nsNamePos = nextDotPos + 1;
+    bool found = (iter != m_refIndex.end()) && (iter->second.m_seq < VisibleRefsLimit);
+    if (m_statsEnabled) {
+        ++m_statsCounters.m_refLookups;
+        if (!found) {
+            ++m_statsCounters.m_failedRefLookups;
         }
+    }
 
-    } while (false);
+    if (!found) {
+        return nullptr;
+    }
 
-    assert(ns != nullptr);
-    return ns;
+    return iter->second.m_obj;
 }
 
-bool ProtocolImpl::strToValue(const std::string& ref, bool checkRef, StrToValueConvertFunc&& func) const
+void ProtocolImpl::rebuildRefIndex()
 {
-    do {
-        if (!checkRef) {
-            assert(common::isValidRefName(ref));
-            break;
+    m_refIndex.clear();
+    for (auto& ns : m_namespaces) {
+        assert(ns.second);
+        if (!ns.first.empty()) {
+            addToRefIndex(ns.first, *ns.second);
         }
 
+        ns.second->addChildrenToRefIndex();
+    }
+}
 
-        if (!common::isValidRefName(ref)) {
-            return false;
-        }
+const std::string& ProtocolImpl::refIndexName(Object::ObjKind kind, const std::string& ref, std::string& buf)
+{
+    if (kind == Object::ObjKind::Namespace) {
+        return ref;
+    }
 
-    } while (false);
+    // Elements other than namespaces are stored using NamespaceImpl::KeyComp,
+    // which ignores case of the first character.
+    auto namePos = ref.find_last_of('.');
+    if (namePos == std::string::npos) {
+        namePos = 0U;
+    }
+    else {
+        ++namePos;
+    }
 
-    auto redirectToGlobalNs =
-        [this, &func, &ref]() -> bool
-        {
-            auto iter = m_namespaces.find(common::emptyString());
-            if (iter == m_namespaces.end()) {
-                return false;
-            }
-            assert(iter->second);
-            return func(*iter->second, ref);
-        };
+    if (ref.size() <= namePos) {
+        return ref;
+    }
+
+    auto lower = static_cast<char>(std::tolower(static_cast<int>(ref[namePos])));
+    if (lower == ref[namePos]) {
+        return ref;
+    }
+
+    buf = ref;
+    buf[namePos] = lower;
+    return buf;
+}
 
-    auto firstDotPos = ref.find_first_of('.');
-    if (firstDotPos == std::string::npos) {
-        return redirectToGlobalNs();
+bool ProtocolImpl::cacheKey(const FilesList& files, std::uint64_t& key) const
+{
+    // The key covers everything the validated model depends on,
+    // the cache is considered stale if any of it changes.
+    key = FnvOffsetBasis;
+    key = fnv1a(std::to_string(CacheFormatVersion), key);
+    key = fnv1a(std::to_string(COMMSDSL_VERSION), key);
+    for (auto& p : m_extraPrefixes) {
+        key = fnv1a(p, key);
     }
 
-    std::string ns(ref, 0, firstDotPos);
-    assert(!ns.empty());
-    auto nsIter = m_namespaces.find(ns);
-    if (nsIter == m_namespaces.end()) {
-        return redirectToGlobalNs();
+    for (auto& f : files) {
+        MappedFile file(f);
+        if (!file.valid()) {
+            return false;
+        }
+
+        key = fnv1a(f, key);
+        key = fnv1a(std::to_string(file.size()), key);
+        key = fnv1a(file.data(), file.size(), key);
     }
 
-    assert(nsIter->second);
-    std::string subRef(ref, firstDotPos + 1);
-    return func(*nsIter->second, subRef);
+    return true;
 }
 
 LogWrapper ProtocolImpl::logError() const
 {
-    return commsdsl::logError(m_logger);
+    return commsdsl::logError(logger());
 }
 
 LogWrapper ProtocolImpl::logWarning() const
 {
-    return commsdsl::logWarning(m_logger);
+    return commsdsl::logWarning(logger());
 }
 
 bool ProtocolImpl::strToStringValue(
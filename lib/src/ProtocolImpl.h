@@ -18,6 +18,11 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <limits>
 
 #include <libxml/xmlmemory.h>
 #include <libxml/parser.h>
@@ -27,25 +32,46 @@
 #include "commsdsl/ErrorLevel.h"
 #include "commsdsl/Schema.h"
 #include "Logger.h"
+#include "Arena.h"
+#include "StringPool.h"
 #include "SchemaImpl.h"
 #include "NamespaceImpl.h"
 
 namespace commsdsl
 {
 
+class XmlStream;
+class CacheWriter;
+class CacheReader;
 class ProtocolImpl
 {
 public:
     using ErrorReportFunction = Protocol::ErrorReportFunction;
     using NamespacesList = Protocol::NamespacesList;
     using MessagesList = Protocol::MessagesList;
+    using MessageIdsList = Protocol::MessageIdsList;
+    using MessagesRange = Protocol::MessagesRange;
     using ExtraPrefixes = std::vector<std::string>;
     using PlatformsList = Protocol::PlatformsList;
     using NamespacesMap = NamespaceImpl::NamespacesMap;
+    using FilesList = Protocol::FilesList;
+    using ElementKind = Protocol::ElementKind;
+    using DependencyKind = Protocol::DependencyKind;
+    using ElementInfo = Protocol::ElementInfo;
+    using ElementsList = Protocol::ElementsList;
+    using DependenciesList = Protocol::DependenciesList;
+    using Stats = Protocol::Stats;
+    using StatsClock = std::chrono::steady_clock;
 
     ProtocolImpl();
     bool parse(const std::string& input);
+    bool parseAll(const FilesList& files, unsigned jobs);
+    bool parseBuffer(const char* data, std::size_t len, const std::string& name);
+    bool parseStreamed(const std::string& input);
     bool validate();
+    bool update(const std::string& input);
+    bool loadCache(const std::string& cacheFile, const FilesList& files);
+    bool saveCache(const std::string& cacheFile, const FilesList& files) const;
 
     Schema schema() const;
 
@@ -58,8 +84,43 @@ public:
         m_errorReportCb = std::move(cb);
     }
 
-    Logger& logger() const
+    void setCompactModel(bool value)
     {
+        m_compactModel = value;
+    }
+
+    void setValidationJobs(unsigned jobs)
+    {
+        m_validationJobs = jobs;
+    }
+
+    void setStatsEnabled(bool value)
+    {
+        m_statsEnabled = value;
+    }
+
+    bool isStatsEnabled() const
+    {
+        return m_statsEnabled;
+    }
+
+    Stats stats() const;
+    void recordFieldCreated(Field::Kind kind);
+    void recordFieldCloned();
+    void recordFieldReused(std::size_t bytes);
+
+    InternedString intern(const std::string& str) const
+    {
+        return m_strings.intern(str);
+    }
+
+    const Logger& logger() const
+    {
+        auto* redirected = Logger::redirected();
+        if (redirected != nullptr) {
+            return *redirected;
+        }
+
         return m_logger;
     }
 
@@ -68,7 +129,10 @@ public:
         return m_namespaces;
     }
 
-    NamespacesList namespacesList() const;
+    const NamespacesList& namespacesList() const
+    {
+        return m_namespacesList;
+    }
 
     const FieldImpl* findField(const std::string& ref, bool checkRef = true) const;
 
@@ -86,7 +150,26 @@ public:
 
     bool strToStringValue(const std::string& str, std::string& val) const;
 
-    MessagesList allMessages() const;
+    const MessagesList& allMessages() const
+    {
+        return m_allMessages;
+    }
+
+    const MessageIdsList& messageIds() const
+    {
+        return m_messageIds;
+    }
+
+    std::size_t messageIdOrdinal(std::uintmax_t id) const;
+    MessagesRange messagesByIdOrdinal(std::size_t ordinal) const;
+    MessagesRange messagesById(std::uintmax_t id) const
+    {
+        return messagesByIdOrdinal(messageIdOrdinal(id));
+    }
+
+    const DependenciesList& dependencies(ElementKind kind, const std::string& externalRef) const;
+    const DependenciesList& dependents(ElementKind kind, const std::string& externalRef) const;
+    ElementsList allDependents(ElementKind kind, const std::string& externalRef) const;
 
     void addExpectedExtraPrefix(const std::string& value)
     {
@@ -110,6 +193,23 @@ public:
     bool isNonUniqueSpecialsAllowedSupported() const;
     bool isFieldAliasSupported() const;
 
+    bool isStreamParsing() const
+    {
+        return m_streamParsing;
+    }
+
+    bool isMessageParseDeferred() const
+    {
+        // The streamed nodes are released right after processing
+        return (m_validationJobs != 1U) && (!m_streamParsing);
+    }
+
+    void deferMessage(MessageImpl& msg);
+
+    bool completeDeferredMessage(const MessageImpl& msg);
+
+    void addToRefIndex(const std::string& ref, Object& obj);
+
 private:
     struct XmlDocFree
     {
@@ -119,35 +219,221 @@ private:
         }
     };
 
+    struct XmlParserCtxtFree
+    {
+        void operator()(::xmlParserCtxtPtr p) const
+        {
+            ::xmlFreeParserCtxt(p);
+        }
+    };
+
+    struct XmlError
+    {
+        ErrorLevel m_level = ErrorLevel_Error;
+        std::string m_msg;
+    };
+
     using XmlDocPtr = std::unique_ptr<::xmlDoc, XmlDocFree>;
-    using DocsList = std::vector<XmlDocPtr>;
+    using XmlParserCtxtPtr = std::unique_ptr<::xmlParserCtxt, XmlParserCtxtFree>;
+    using XmlErrorsList = std::vector<XmlError>;
+
+    struct ParseResult
+    {
+        XmlDocPtr m_doc;
+        XmlErrorsList m_errors;
+        std::uint64_t m_parseTimeUs = 0U;
+    };
+
+    // Updated concurrently by the validation workers
+    struct StatsCounters
+    {
+        std::array<std::atomic<std::size_t>, static_cast<std::size_t>(Field::Kind::NumOfValues)> m_createdFields = {};
+        std::atomic<std::size_t> m_reusedFields{0U};
+        std::atomic<std::size_t> m_clonedFields{0U};
+        std::atomic<std::size_t> m_reuseBytes{0U};
+        mutable std::atomic<std::size_t> m_refLookups{0U};
+        mutable std::atomic<std::size_t> m_failedRefLookups{0U};
+    };
+
+    struct NamespaceCheckpoint
+    {
+        NamespaceImpl* m_ns = nullptr;
+        std::string m_description;
+        XmlWrap::PropsMap m_extraAttrs;
+        std::size_t m_extraChildrenCount = 0U;
+    };
+
+    // State of the merged properties before the input is validated
+    struct ValidationCheckpoint
+    {
+        PlatformsList m_platforms;
+        XmlWrap::PropsMap m_schemaExtraAttrs;
+        std::size_t m_schemaExtraChildrenCount = 0U;
+        std::vector<NamespaceCheckpoint> m_namespaces;
+    };
+
+    using ArenaPtr = std::unique_ptr<Arena>;
+    using ArenasList = std::vector<ArenaPtr>;
+
+    // The elements defined by the input are allocated in its own arenas,
+    // released when the input is discarded after the elements themselves
+    // have been destroyed.
+    struct SchemaInput
+    {
+        XmlDocPtr m_doc;
+        std::string m_streamFile;
+        ValidationCheckpoint m_checkpoint;
+        ArenaPtr m_arena;
+        ArenasList m_workerArenas;
+        std::size_t m_firstRefSeq = std::numeric_limits<std::size_t>::max();
+    };
+
+    // The fields of the deferred message are parsed as if it was done
+    // at the point of deferral: only the elements defined before it are
+    // visible and the logs are reported in between the ones recorded
+    // before and after it.
+    struct DeferredMessage
+    {
+        MessageImpl* m_msg = nullptr;
+        std::size_t m_input = 0U;
+        std::size_t m_logsPos = 0U;
+        std::size_t m_visibleRefs = 0U;
+        XmlErrorsList m_logs;
+        bool m_parsed = false;
+        bool m_ok = false;
+    };
+
+    // The names in the references index are interned, the keys are
+    // hashed and compared by the pointer to the stored name.
+    struct RefIndexKey
+    {
+        const std::string* m_name = nullptr;
+        Object::ObjKind m_kind = Object::ObjKind::NumOfValues;
+
+        bool operator==(const RefIndexKey& other) const
+        {
+            return (m_name == other.m_name) && (m_kind == other.m_kind);
+        }
+    };
+
+    struct RefIndexKeyHash
+    {
+        std::size_t operator()(const RefIndexKey& key) const
+        {
+            return std::hash<const std::string*>()(key.m_name) ^ static_cast<std::size_t>(key.m_kind);
+        }
+    };
+
+    struct RefIndexEntry
+    {
+        const Object* m_obj = nullptr;
+        std::size_t m_seq = 0U;
+    };
+
+    struct DependencyEdge
+    {
+        DependencyKind m_kind = DependencyKind::NumOfValues;
+        const Object* m_obj = nullptr;
+    };
+
+    using DependencyEdgesList = std::vector<DependencyEdge>;
+
+    struct DependencyNode
+    {
+        DependencyEdgesList m_forwardEdges;
+        DependencyEdgesList m_reverseEdges;
+        DependenciesList m_dependencies;
+        DependenciesList m_dependents;
+    };
+
+    using InputsList = std::vector<SchemaInput>;
     using SchemaImplPtr = std::unique_ptr<SchemaImpl>;
-    using StrToValueConvertFunc = std::function<bool (const NamespaceImpl& ns, const std::string& ref)>;
+    using StrToValueConvertFunc = std::function<bool (const FieldImpl& field, const std::string& ref)>;
+    using RefIndex = std::unordered_map<RefIndexKey, RefIndexEntry, RefIndexKeyHash>;
+    using DependencyGraph = std::unordered_map<const Object*, DependencyNode>;
 
+    static XmlParserCtxtPtr createParserCtxt(XmlErrorsList& errors);
+    static ParseResult parseFile(const std::string& input);
+    static ParseResult parseMemory(const char* data, std::size_t len, const std::string& name);
+    bool processParseResult(const std::string& input, ParseResult& result);
+    void reportXmlErrors(const XmlErrorsList& errors);
     static void cbXmlErrorFunc(void* userData, xmlErrorPtr err);
-    void handleXmlError(xmlErrorPtr err);
+    static void cbStreamErrorFunc(void* userData, xmlErrorPtr err);
+    static void handleXmlError(xmlErrorPtr err, XmlErrorsList& errors);
+    bool validateInputs(std::size_t from);
+    bool processInputs(std::size_t from);
+    bool completeValidation();
+    void saveCheckpoint(ValidationCheckpoint& checkpoint) const;
+    void restoreCheckpoint(const ValidationCheckpoint& checkpoint);
+    void discardInputs(std::size_t from);
+    std::size_t firstDependentInput(std::size_t from) const;
     bool validateDoc(::xmlDocPtr doc);
     bool validateSchema(::xmlNodePtr node);
     bool validatePlatforms(::xmlNodePtr root);
     bool validateSinglePlatform(::xmlNodePtr node);
     bool validateNamespaces(::xmlNodePtr root);
+    bool validateStream(SchemaInput& input);
+    bool validateStreamRoot(XmlStream& stream, SchemaInput& input);
+    NamespaceImpl* addNamespace(NamespaceImplPtr ns);
+    NamespaceImpl& globalNamespace();
+    bool validateDeferredMessages(bool inputsValid);
+    void parseDeferredMessage(DeferredMessage& deferred, Arena& arena);
     bool validateAllMessages();
+    void cacheLists();
+    void buildMessageIdIndex();
+    void buildDependencyGraph();
+    const DependencyNode* findDependencyNode(ElementKind kind, const std::string& externalRef) const;
+    static ElementInfo elementInfo(const Object& obj);
     unsigned countMessageIds() const;
-    const NamespaceImpl* getNsFromPath(const std::string& ref, bool checkRef, std::string& remName) const;
+    bool checkRefName(const std::string& ref, bool checkRef) const;
+    const Object* findInRefIndex(Object::ObjKind kind, const std::string& ref) const;
+    void rebuildRefIndex();
+    static const std::string& refIndexName(Object::ObjKind kind, const std::string& ref, std::string& buf);
     bool strToValue(const std::string& ref, bool checkRef, StrToValueConvertFunc&& func) const;
+    bool cacheKey(const FilesList& files, std::uint64_t& key) const;
+    void writeModel(CacheWriter& writer) const;
+    bool readModel(CacheReader& reader);
+    bool compactModel();
+
+    void recordFileParsed(const std::string& file, std::uint64_t parseTimeUs);
+    void recordPhase(const std::string& name, StatsClock::time_point start);
+    std::size_t modelMemory() const;
 
     LogWrapper logError() const;
     LogWrapper logWarning() const;
 
     ErrorReportFunction m_errorReportCb;
-    DocsList m_docs;
+    InputsList m_inputs;
     bool m_validated = false;
+    bool m_validationStarted = false;
+    std::size_t m_validInputs = 0U;
+    bool m_streamParsing = false;
+    bool m_compactModel = false;
+    unsigned m_validationJobs = 1U;
+    bool m_statsEnabled = false;
+    std::size_t m_currInput = 0U;
+    std::vector<DeferredMessage> m_deferredMessages;
+    XmlErrorsList m_deferralLogs;
     ErrorLevel m_minLevel = ErrorLevel_Info;
-    mutable Logger m_logger;
+    Logger m_logger;
+    mutable StringPool m_strings;
+    Arena m_arena; // must outlive the object model
     SchemaImplPtr m_schema;
     NamespacesMap m_namespaces;
     ExtraPrefixes m_extraPrefixes;
     PlatformsList m_platforms;
+    RefIndex m_refIndex;
+    std::size_t m_refIndexSeq = 0U;
+    NamespacesList m_namespacesList;
+    MessagesList m_allMessages;
+    MessageIdsList m_messageIds;
+    std::vector<std::size_t> m_messageIdOffsets;
+    std::vector<std::size_t> m_messageIdTable; // direct id -> ordinal map for dense ids
+    DependencyGraph m_dependencyGraph;
+    StatsCounters m_statsCounters;
+    Protocol::FileStatsList m_fileStats;
+    Protocol::PhaseStatsList m_phaseStats;
+    std::size_t m_peakModelMemory = 0U;
 };
 
 } // namespace commsdsl
@@ -19,6 +19,8 @@
 #include "common.h"
 #include "ProtocolImpl.h"
 #include "BitfieldFieldImpl.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
@@ -269,4 +271,24 @@ bool RefFieldImpl::strToValue(
 }
 
 
+void RefFieldImpl::collectDependenciesImpl(const DependencyReportFunc& func) const
+{
+    if (m_field != nullptr) {
+        func(DependencyKind::Ref, *m_field);
+    }
+}
+
+void RefFieldImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    writer.writeUnsigned(m_state.m_bitLength);
+    writer.writeObjectRef(m_field);
+}
+
+bool RefFieldImpl::readCacheImpl(CacheReader& reader)
+{
+    m_state.m_bitLength = reader.readUnsigned<std::size_t>();
+    reader.readObjectRef(m_field);
+    return reader.ok();
+}
+
 } // namespace commsdsl
@@ -61,6 +61,9 @@ protected:
     virtual bool strToDataImpl(const std::string& ref, std::vector<std::uint8_t>& val) const override;
     virtual bool validateBitLengthValueImpl(::xmlNodePtr node, std::size_t bitLength) const override;
     virtual bool verifySemanticTypeImpl(::xmlNodePtr node, SemanticType type) const override;
+    virtual void collectDependenciesImpl(const DependencyReportFunc& func) const override;
+    virtual void writeCacheImpl(CacheWriter& writer) const override;
+    virtual bool readCacheImpl(CacheReader& reader) override;
 
 private:
     using StrToValueFieldConvertFunc = std::function<bool (const FieldImpl& f, const std::string& ref)>;
@@ -20,6 +20,8 @@
 #include <iterator>
 
 #include "common.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 #include "ProtocolImpl.h"
 #include "NamespaceImpl.h"
 
@@ -164,4 +166,33 @@ bool SchemaImpl::updateExtraChildren()
     return true;
 }
 
+void SchemaImpl::writeCache(CacheWriter& writer) const
+{
+    writer.writeProps(m_props);
+    writer.writeProps(m_extraAttrs);
+    writer.writeContents(m_extraChildren);
+    writer.writeString(m_name);
+    writer.writeString(m_description);
+    writer.writeUnsigned(m_id);
+    writer.writeUnsigned(m_version);
+    writer.writeUnsigned(m_dslVersion);
+    writer.writeEnum(m_endian);
+    writer.writeBool(m_nonUniqueMsgIdAllowed);
+}
+
+bool SchemaImpl::readCache(CacheReader& reader)
+{
+    m_props = reader.readProps();
+    m_extraAttrs = reader.readProps();
+    m_extraChildren = reader.readContents();
+    m_name = reader.readString();
+    m_description = reader.readString();
+    m_id = reader.readUnsigned<unsigned>();
+    m_version = reader.readUnsigned<unsigned>();
+    m_dslVersion = reader.readUnsigned<unsigned>();
+    m_endian = reader.readEnum<Endian>();
+    m_nonUniqueMsgIdAllowed = reader.readBool();
+    return reader.ok();
+}
+
 } // namespace commsdsl
@@ -23,6 +23,8 @@ namespace commsdsl
 {
 
 class ProtocolImpl;
+class CacheWriter;
+class CacheReader;
 class SchemaImpl
 {
 public:
@@ -98,6 +100,9 @@ public:
         return m_extraChildren;
     }
 
+    void writeCache(CacheWriter& writer) const;
+    bool readCache(CacheReader& reader);
+
 private:
 
     bool updateStringProperty(const PropsMap& map, const std::string& name, std::string& prop);
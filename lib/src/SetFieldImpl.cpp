@@ -25,6 +25,8 @@
 #include "ProtocolImpl.h"
 #include "IntFieldImpl.h"
 #include "util.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
@@ -48,7 +50,7 @@ bool SetFieldImpl::isUnique() const
 {
     unsigned prevIdx = 0;
     bool firstElem = true;
-    for (auto& b : m_state.m_revBits) {
+    for (auto& b : m_state.m_revBits.get()) {
         if (firstElem) {
             prevIdx = b.first;
             firstElem = false;
@@ -138,8 +140,8 @@ std::size_t SetFieldImpl::bitLengthImpl() const
 
 bool SetFieldImpl::isBitCheckableImpl(const std::string& val) const
 {
-    auto iter = m_state.m_bits.find(val);
-    return iter != m_state.m_bits.end();
+    auto iter = m_state.m_bits->find(val);
+    return iter != m_state.m_bits->end();
 }
 
 bool SetFieldImpl::strToNumericImpl(const std::string& ref, std::intmax_t& val, bool& isBigUnsigned) const
@@ -154,8 +156,8 @@ bool SetFieldImpl::strToNumericImpl(const std::string& ref, std::intmax_t& val,
         return true;
     }
 
-    auto iter = m_state.m_bits.find(ref);
-    if (iter == m_state.m_bits.end()) {
+    auto iter = m_state.m_bits->find(ref);
+    if (iter == m_state.m_bits->end()) {
         return false;
     }
 
@@ -174,8 +176,8 @@ bool SetFieldImpl::strToBoolImpl(const std::string& ref, bool& val) const
         return true;
     }
 
-    auto iter = m_state.m_bits.find(ref);
-    if (iter == m_state.m_bits.end()) {
+    auto iter = m_state.m_bits->find(ref);
+    if (iter == m_state.m_bits->end()) {
         return false;
     }
 
@@ -426,8 +428,8 @@ bool SetFieldImpl::updateBits()
 {
     auto bits = XmlWrap::getChildren(getNode(), common::bitStr());
     if (bits.empty()) {
-        if (!m_state.m_bits.empty()) {
-            assert(!m_state.m_revBits.empty());
+        if (!m_state.m_bits->empty()) {
+            assert(!m_state.m_revBits->empty());
             return true; // already has values
         }
 
@@ -505,8 +507,8 @@ bool SetFieldImpl::updateBits()
             return false;
         }
 
-        auto bitsIter = m_state.m_bits.find(nameIter->second);
-        if (bitsIter != m_state.m_bits.end()) {
+        auto bitsIter = m_state.m_bits->find(nameIter->second);
+        if (bitsIter != m_state.m_bits->end()) {
             logError() << XmlWrap::logPrefix(b) << "Bit with name \"" << nameIter->second <<
                           "\" has already been defined for set \"" << name() << "\".";
             return false;
@@ -529,8 +531,8 @@ bool SetFieldImpl::updateBits()
             return false;
         }
         if (!m_state.m_nonUniqueAllowed) {
-            auto revBitsIter = m_state.m_revBits.find(idx);
-            if (revBitsIter != m_state.m_revBits.end()) {
+            auto revBitsIter = m_state.m_revBits->find(idx);
+            if (revBitsIter != m_state.m_revBits->end()) {
                 logError() << XmlWrap::logPrefix(b) <<
                       "Bit \"" << revBitsIter->first << "\" has been already defined "
                       "as \"" << revBitsIter->second << "\".";
@@ -605,19 +607,19 @@ bool SetFieldImpl::updateBits()
         do {
             if (!m_state.m_nonUniqueAllowed) {
                 // The bit hasn't been processed earlier
-                assert(m_state.m_revBits.find(idx) == m_state.m_revBits.end());
+                assert(m_state.m_revBits->find(idx) == m_state.m_revBits->end());
                 break;
             }
 
-            auto revIters = m_state.m_revBits.equal_range(idx);
+            auto revIters = m_state.m_revBits->equal_range(idx);
             if (revIters.first == revIters.second) {
                 // The bit hasn't been processed earlier
                 break;
             }
 
             for (auto rIter = revIters.first; rIter != revIters.second; ++rIter) {
-                auto iter = m_state.m_bits.find(rIter->second);
-                assert(iter != m_state.m_bits.end());
+                auto iter = m_state.m_bits->find(rIter->second);
+                assert(iter != m_state.m_bits->end());
 
                 if (iter->second.m_deprecatedSince <= info.m_sinceVersion) {
                     assert(iter->second.m_sinceVersion < info.m_sinceVersion);
@@ -664,8 +666,8 @@ bool SetFieldImpl::updateBits()
             return false;
         }
 
-        m_state.m_bits.emplace(nameIter->second, info);
-        m_state.m_revBits.emplace(idx, nameIter->second);
+        m_state.m_bits.modify().emplace(nameIter->second, info);
+        m_state.m_revBits.modify().emplace(idx, nameIter->second);
     }
 
     return true;
@@ -686,4 +688,89 @@ bool SetFieldImpl::strToValue(const std::string& str, bool& val) const
     return protocol().strToBool(str, true, val);
 }
 
+void SetFieldImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    writer.writeEnum(m_state.m_type);
+    writer.writeEnum(m_state.m_endian);
+    writer.writeUnsigned(m_state.m_length);
+    writer.writeUnsigned(m_state.m_bitLength);
+    m_state.m_bits.writeCache(
+        writer,
+        [&writer](const Bits& bits)
+        {
+            writer.writeUnsigned(bits.size());
+            for (auto& b : bits) {
+                writer.writeString(b.first);
+                writer.writeUnsigned(b.second.m_idx);
+                writer.writeUnsigned(b.second.m_sinceVersion);
+                writer.writeUnsigned(b.second.m_deprecatedSince);
+                writer.writeString(b.second.m_description);
+                writer.writeString(b.second.m_displayName);
+                writer.writeBool(b.second.m_defaultValue);
+                writer.writeBool(b.second.m_reserved);
+                writer.writeBool(b.second.m_reservedValue);
+            }
+        });
+
+    m_state.m_revBits.writeCache(
+        writer,
+        [&writer](const RevBits& revBits)
+        {
+            writer.writeUnsigned(revBits.size());
+            for (auto& b : revBits) {
+                writer.writeUnsigned(b.first);
+                writer.writeString(b.second);
+            }
+        });
+
+    writer.writeBool(m_state.m_nonUniqueAllowed);
+    writer.writeBool(m_state.m_defaultBitValue);
+    writer.writeBool(m_state.m_reservedBitValue);
+    writer.writeBool(m_state.m_validCheckVersion);
+}
+
+bool SetFieldImpl::readCacheImpl(CacheReader& reader)
+{
+    m_state.m_type = reader.readEnum<Type>();
+    m_state.m_endian = reader.readEnum<Endian>();
+    m_state.m_length = reader.readUnsigned<std::size_t>();
+    m_state.m_bitLength = reader.readUnsigned<std::size_t>();
+    m_state.m_bits.readCache(
+        reader,
+        [&reader](Bits& bits)
+        {
+            auto bitsCount = reader.readSize();
+            for (auto idx = 0U; idx < bitsCount; ++idx) {
+                auto name = reader.readString();
+                BitInfo info;
+                info.m_idx = reader.readUnsigned<unsigned>();
+                info.m_sinceVersion = reader.readUnsigned<unsigned>();
+                info.m_deprecatedSince = reader.readUnsigned<unsigned>();
+                info.m_description = reader.readString();
+                info.m_displayName = reader.readString();
+                info.m_defaultValue = reader.readBool();
+                info.m_reserved = reader.readBool();
+                info.m_reservedValue = reader.readBool();
+                bits.insert(bits.end(), std::make_pair(std::move(name), std::move(info)));
+            }
+        });
+
+    m_state.m_revBits.readCache(
+        reader,
+        [&reader](RevBits& revBits)
+        {
+            auto revBitsCount = reader.readSize();
+            for (auto idx = 0U; idx < revBitsCount; ++idx) {
+                auto bitIdx = reader.readUnsigned<unsigned>();
+                revBits.insert(revBits.end(), std::make_pair(bitIdx, reader.readString()));
+            }
+        });
+
+    m_state.m_nonUniqueAllowed = reader.readBool();
+    m_state.m_defaultBitValue = reader.readBool();
+    m_state.m_reservedBitValue = reader.readBool();
+    m_state.m_validCheckVersion = reader.readBool();
+    return reader.ok();
+}
+
 } // namespace commsdsl
@@ -21,6 +21,7 @@
 
 #include "commsdsl/Endian.h"
 #include "commsdsl/SetField.h"
+#include "CowData.h"
 #include "FieldImpl.h"
 
 namespace commsdsl
@@ -60,12 +61,12 @@ public:
 
     const Bits& bits() const
     {
-        return m_state.m_bits;
+        return m_state.m_bits.get();
     }
 
     const RevBits& revBits() const
     {
-        return m_state.m_revBits;
+        return m_state.m_revBits.get();
     }
 
     bool isNonUniqueAllowed() const
@@ -93,6 +94,8 @@ protected:
     virtual bool strToNumericImpl(const std::string& ref, std::intmax_t& val, bool& isBigUnsigned) const override;
     virtual bool strToBoolImpl(const std::string& ref, bool& val) const override;
     virtual bool validateBitLengthValueImpl(::xmlNodePtr node, std::size_t bitLength) const override;
+    virtual void writeCacheImpl(CacheWriter& writer) const override;
+    virtual bool readCacheImpl(CacheReader& reader) override;
 
 private:
     bool updateEndian();
@@ -111,8 +114,8 @@ private:
         Endian m_endian = Endian_NumOfValues;
         std::size_t m_length = 0U;
         std::size_t m_bitLength = 0U;
-        Bits m_bits;
-        RevBits m_revBits;
+        CowData<Bits> m_bits;
+        CowData<RevBits> m_revBits;
         bool m_nonUniqueAllowed = false;
         bool m_defaultBitValue = false;
         bool m_reservedBitValue = false;
@@ -26,6 +26,8 @@
 #include "IntFieldImpl.h"
 #include "RefFieldImpl.h"
 #include "util.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
@@ -479,4 +481,43 @@ bool StringFieldImpl::strToValue(const std::string& str, std::string& val) const
 }
 
 
+void StringFieldImpl::collectDependenciesImpl(const DependencyReportFunc& func) const
+{
+    if (m_state.m_extPrefixField != nullptr) {
+        func(DependencyKind::LengthPrefix, *m_state.m_extPrefixField);
+        return;
+    }
+
+    if (m_prefixField) {
+        m_prefixField->collectDependencies(func);
+    }
+}
+
+void StringFieldImpl::releaseNodesImpl()
+{
+    releaseNodesOptional(m_prefixField);
+}
+
+void StringFieldImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    writer.writeString(m_state.m_defaultValue);
+    writer.writeString(m_state.m_encoding);
+    writer.writeUnsigned(m_state.m_length);
+    writer.writeObjectRef(m_state.m_extPrefixField);
+    writer.writeString(m_state.m_detachedPrefixField);
+    writer.writeBool(m_state.m_haxZeroSuffix);
+    writeCacheOptional(writer, m_prefixField);
+}
+
+bool StringFieldImpl::readCacheImpl(CacheReader& reader)
+{
+    m_state.m_defaultValue = reader.readString();
+    m_state.m_encoding = reader.readString();
+    m_state.m_length = reader.readUnsigned<std::size_t>();
+    reader.readObjectRef(m_state.m_extPrefixField);
+    m_state.m_detachedPrefixField = reader.readString();
+    m_state.m_haxZeroSuffix = reader.readBool();
+    return readCacheOptional(reader, protocol(), m_prefixField);
+}
+
 } // namespace commsdsl
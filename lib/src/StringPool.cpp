@@ -0,0 +1,97 @@
+//
+// Copyright 2018 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "StringPool.h"
+
+#include "common.h"
+
+namespace commsdsl
+{
+
+namespace
+{
+
+thread_local std::size_t CurrentOwner = 0U;
+
+} // namespace
+
+StringPool::Scope::Scope(std::size_t owner)
+  : m_prev(CurrentOwner)
+{
+    CurrentOwner = owner;
+}
+
+StringPool::Scope::~Scope()
+{
+    CurrentOwner = m_prev;
+}
+
+InternedString::InternedString()
+  : m_str(&common::emptyString())
+{
+}
+
+InternedString StringPool::intern(const std::string& str)
+{
+    if (str.empty()) {
+        return InternedString();
+    }
+
+    std::lock_guard<std::shared_timed_mutex> guard(m_mutex);
+    auto iter = m_strings.insert(std::make_pair(str, CurrentOwner)).first;
+    if (CurrentOwner < iter->second) {
+        iter->second = CurrentOwner;
+    }
+    return InternedString(iter->first);
+}
+
+bool StringPool::find(const std::string& str, InternedString& result) const
+{
+    if (str.empty()) {
+        result = InternedString();
+        return true;
+    }
+
+    // Lookups from the parallel parsing jobs don't block each other
+    std::shared_lock<std::shared_timed_mutex> guard(m_mutex);
+    auto iter = m_strings.find(str);
+    if (iter == m_strings.end()) {
+        return false;
+    }
+
+    result = InternedString(iter->first);
+    return true;
+}
+
+void StringPool::discard(std::size_t from)
+{
+    std::lock_guard<std::shared_timed_mutex> guard(m_mutex);
+    for (auto iter = m_strings.begin(); iter != m_strings.end();) {
+        if (iter->second < from) {
+            ++iter;
+            continue;
+        }
+
+        iter = m_strings.erase(iter);
+    }
+}
+
+std::size_t StringPool::size() const
+{
+    std::shared_lock<std::shared_timed_mutex> guard(m_mutex);
+    return m_strings.size();
+}
+
+} // namespace commsdsl
@@ -0,0 +1,111 @@
+//
+// Copyright 2018 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace commsdsl
+{
+
+// Handle to a string stored in the StringPool, handles interned by the
+// same pool are equal only when they refer to the same stored string.
+class InternedString
+{
+public:
+    InternedString();
+    explicit InternedString(const std::string& pooled) : m_str(&pooled) {}
+
+    const std::string& str() const
+    {
+        return *m_str;
+    }
+
+    operator const std::string&() const
+    {
+        return *m_str;
+    }
+
+    bool empty() const
+    {
+        return m_str->empty();
+    }
+
+    const std::string* ptr() const
+    {
+        return m_str;
+    }
+
+    bool operator==(const InternedString& other) const
+    {
+        return m_str == other.m_str;
+    }
+
+    bool operator!=(const InternedString& other) const
+    {
+        return m_str != other.m_str;
+    }
+
+private:
+    const std::string* m_str = nullptr;
+};
+
+inline std::ostream& operator<<(std::ostream& os, const InternedString& str)
+{
+    return os << str.str();
+}
+
+// Every stored string is owned by the earliest schema input that interned
+// it, the inputs can refer only to the elements of the preceding ones, so
+// the strings owned by the discarded inputs aren't referenced any more.
+class StringPool
+{
+public:
+    class Scope
+    {
+    public:
+        explicit Scope(std::size_t owner);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        std::size_t m_prev = 0U;
+    };
+
+    StringPool() = default;
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    InternedString intern(const std::string& str);
+    bool find(const std::string& str, InternedString& result) const;
+    void discard(std::size_t from);
+
+    std::size_t size() const;
+
+private:
+    using StringsMap = std::unordered_map<std::string, std::size_t>;
+
+    mutable std::shared_timed_mutex m_mutex;
+    StringsMap m_strings;
+};
+
+} // namespace commsdsl
@@ -20,6 +20,8 @@
 
 #include "ProtocolImpl.h"
 #include "common.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
@@ -201,4 +203,36 @@ bool ValueLayerImpl::updatePseudo()
     return true;
 }
 
+void ValueLayerImpl::collectDependenciesImpl(const DependencyReportFunc& func) const
+{
+    for (auto* i : m_interfaces) {
+        func(DependencyKind::Interface, *i);
+    }
+}
+
+void ValueLayerImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    writer.writeUnsigned(m_interfaces.size());
+    for (auto* i : m_interfaces) {
+        writer.writeObjectRef(i);
+    }
+
+    writer.writePropRef(props(), m_fieldName);
+    writer.writeBool(m_pseudo);
+}
+
+bool ValueLayerImpl::readCacheImpl(CacheReader& reader)
+{
+    // The references are resolved later, the list must not be
+    // reallocated after its elements are registered.
+    m_interfaces.resize(reader.readSize());
+    for (auto& i : m_interfaces) {
+        reader.readObjectRef(i);
+    }
+
+    m_fieldName = reader.readPropRef(props());
+    m_pseudo = reader.readBool();
+    return reader.ok();
+}
+
 } // namespace commsdsl
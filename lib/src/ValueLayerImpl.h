@@ -25,7 +25,7 @@ class ValueLayerImpl final : public LayerImpl
 {
     using Base = LayerImpl;
 public:
-    using Interfaces = std::vector<const InterfaceImpl*>;
+    using Interfaces = ArenaVector<const InterfaceImpl*>;
     using InterfacesList = ValueLayer::Interfaces;
     ValueLayerImpl(::xmlNodePtr node, ProtocolImpl& protocol);
 
@@ -49,6 +49,9 @@ protected:
     virtual const XmlWrap::NamesList& extraPropsNamesImpl() const override;
     virtual bool parseImpl() override;
     virtual bool verifyImpl(const LayersList& layers) override;
+    virtual void collectDependenciesImpl(const DependencyReportFunc& func) const override;
+    virtual void writeCacheImpl(CacheWriter& writer) const override;
+    virtual bool readCacheImpl(CacheReader& reader) override;
 
 private:
     bool updateInterfaces();
@@ -24,6 +24,8 @@
 
 #include "ProtocolImpl.h"
 #include "OptionalFieldImpl.h"
+#include "CacheWriter.h"
+#include "CacheReader.h"
 
 namespace commsdsl
 {
@@ -363,4 +365,30 @@ bool VariantFieldImpl::updateIdxHidden()
     return validateAndUpdateBoolPropValue(common::displayIdxReadOnlyHiddenStr(), m_state.m_idxHidden);
 }
 
+void VariantFieldImpl::collectDependenciesImpl(const DependencyReportFunc& func) const
+{
+    for (auto& m : m_members) {
+        m->collectDependencies(func);
+    }
+}
+
+void VariantFieldImpl::releaseNodesImpl()
+{
+    releaseNodesList(m_members);
+}
+
+void VariantFieldImpl::writeCacheImpl(CacheWriter& writer) const
+{
+    writer.writeUnsigned(m_state.m_defaultIdx);
+    writer.writeBool(m_state.m_idxHidden);
+    writeCacheList(writer, m_members);
+}
+
+bool VariantFieldImpl::readCacheImpl(CacheReader& reader)
+{
+    m_state.m_defaultIdx = reader.readUnsigned<std::size_t>();
+    m_state.m_idxHidden = reader.readBool();
+    return readCacheList(reader, protocol(), m_members);
+}
+
 } // namespace commsdsl
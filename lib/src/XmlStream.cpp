@@ -0,0 +1,183 @@
+//
+// Copyright 2018 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "XmlStream.h"
+
+#include <algorithm>
+
+namespace commsdsl
+{
+
+XmlStream::XmlStream(const std::string& file, ::xmlStructuredErrorFunc errFunc, void* errArg)
+  : m_reader(::xmlReaderForFile(file.c_str(), nullptr, 0))
+{
+    if (m_reader) {
+        ::xmlTextReaderSetStructuredErrorHandler(m_reader.get(), errFunc, errArg);
+    }
+}
+
+int XmlStream::depth() const
+{
+    return ::xmlTextReaderDepth(m_reader.get());
+}
+
+::xmlNodePtr XmlStream::node() const
+{
+    return ::xmlTextReaderCurrentNode(m_reader.get());
+}
+
+::xmlNodePtr XmlStream::expand()
+{
+    auto* result = ::xmlTextReaderExpand(m_reader.get());
+    if (result == nullptr) {
+        m_lastResult = -1;
+    }
+    return result;
+}
+
+bool XmlStream::isEmptyElement() const
+{
+    return ::xmlTextReaderIsEmptyElement(m_reader.get()) == 1;
+}
+
+bool XmlStream::nextChild(int parentDepth)
+{
+    while (true) {
+        if (m_advanced) {
+            m_advanced = false;
+        }
+        else {
+            m_lastResult = ::xmlTextReaderRead(m_reader.get());
+        }
+
+        if (m_lastResult != 1) {
+            return false;
+        }
+
+        auto currDepth = depth();
+        if (currDepth <= parentDepth) {
+            return false;
+        }
+
+        if ((currDepth == (parentDepth + 1)) &&
+            (::xmlTextReaderNodeType(m_reader.get()) == XML_READER_TYPE_ELEMENT)) {
+            return true;
+        }
+    }
+}
+
+void XmlStream::skip()
+{
+    // Moves to the next sibling, the nodes of the skipped subtree get released
+    m_lastResult = ::xmlTextReaderNext(m_reader.get());
+    m_advanced = true;
+}
+
+::xmlNodePtr XmlStream::copyElement(::xmlNodePtr skeletonParent) const
+{
+    auto* copy = ::xmlDocCopyNode(node(), skeletonParent->doc, 2);
+    if (copy != nullptr) {
+        ::xmlAddChild(skeletonParent, copy);
+    }
+    return copy;
+}
+
+bool XmlStream::forEachChild(ProcessFunc&& func)
+{
+    if (isEmptyElement()) {
+        return true;
+    }
+
+    auto parentDepth = depth();
+    while (nextChild(parentDepth)) {
+        if (!func()) {
+            return false;
+        }
+    }
+
+    return !failed();
+}
+
+bool XmlStream::processChildren(
+    ::xmlNodePtr skeleton,
+    const XmlWrap::NamesList& definitions,
+    const Logger& logger,
+    FinaliseFunc&& finaliseFunc,
+    ProcessFunc&& processFunc,
+    LateFunc&& lateFunc)
+{
+    bool finalised = false;
+    auto finaliseOnce =
+        [&finalised, &finaliseFunc]()
+        {
+            if (finalised) {
+                return true;
+            }
+
+            finalised = true;
+            return finaliseFunc();
+        };
+
+    bool result =
+        forEachChild(
+            [this, skeleton, &definitions, &logger, &finalised, &finaliseOnce, &processFunc, &lateFunc]()
+            {
+                auto* child = node();
+                auto iter =
+                    std::find_if(
+                        definitions.begin(), definitions.end(),
+                        [child](const std::string& name)
+                        {
+                            return name == reinterpret_cast<const char*>(child->name);
+                        });
+
+                if (iter != definitions.end()) {
+                    return finaliseOnce() && processFunc();
+                }
+
+                if (finalised && lateFunc) {
+                    auto* expanded = expand();
+                    if (expanded == nullptr) {
+                        return false;
+                    }
+
+                    if (lateFunc(expanded)) {
+                        skip();
+                        return true;
+                    }
+                }
+
+                if (finalised) {
+                    commsdsl::logError(logger) << XmlWrap::logPrefix(child) <<
+                        "The \"" << child->name << "\" element must precede all the definitions "
+                        "when the schema is parsed in streaming mode.";
+                    return false;
+                }
+
+                // Properties are kept in the skeleton document
+                auto* expanded = expand();
+                if (expanded == nullptr) {
+                    return false;
+                }
+
+                ::xmlAddChild(skeleton, ::xmlDocCopyNode(expanded, skeleton->doc, 1));
+                skip();
+                return true;
+            });
+
+    return result && finaliseOnce();
+}
+
+} // namespace commsdsl
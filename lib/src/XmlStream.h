@@ -0,0 +1,85 @@
+//
+// Copyright 2018 - 2020 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <libxml/xmlreader.h>
+
+#include "Logger.h"
+#include "XmlWrap.h"
+
+namespace commsdsl
+{
+
+class XmlStream
+{
+public:
+    using FinaliseFunc = std::function<bool ()>;
+    using ProcessFunc = std::function<bool ()>;
+    using LateFunc = std::function<bool (::xmlNodePtr node)>;
+
+    XmlStream(const std::string& file, ::xmlStructuredErrorFunc errFunc, void* errArg);
+
+    XmlStream(const XmlStream&) = delete;
+    XmlStream& operator=(const XmlStream&) = delete;
+
+    bool valid() const
+    {
+        return static_cast<bool>(m_reader);
+    }
+
+    bool failed() const
+    {
+        return m_lastResult < 0;
+    }
+
+    int depth() const;
+    ::xmlNodePtr node() const;
+    ::xmlNodePtr expand();
+    bool isEmptyElement() const;
+    bool nextChild(int parentDepth);
+    void skip();
+    ::xmlNodePtr copyElement(::xmlNodePtr skeletonParent) const;
+
+    bool forEachChild(ProcessFunc&& func);
+    bool processChildren(
+        ::xmlNodePtr skeleton,
+        const XmlWrap::NamesList& definitions,
+        const Logger& logger,
+        FinaliseFunc&& finaliseFunc,
+        ProcessFunc&& processFunc,
+        LateFunc&& lateFunc = LateFunc());
+
+private:
+    struct ReaderFree
+    {
+        void operator()(::xmlTextReaderPtr p) const
+        {
+            ::xmlFreeTextReader(p);
+        }
+    };
+
+    using ReaderPtr = std::unique_ptr<::xmlTextReader, ReaderFree>;
+
+    ReaderPtr m_reader;
+    int m_lastResult = 1;
+    bool m_advanced = false;
+};
+
+} // namespace commsdsl
@@ -17,6 +17,7 @@
 
 #include <cassert>
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 
 #include "ProtocolImpl.h"
@@ -24,6 +25,94 @@
 namespace commsdsl
 {
 
+namespace
+{
+
+bool isWhiteSpace(char ch)
+{
+    return (ch == ' ') || (ch == '\r') || (ch == '\n') || (ch == '\t');
+}
+
+bool nameEquals(const ::xmlChar* xmlName, const std::string& name)
+{
+    return name == reinterpret_cast<const char*>(xmlName);
+}
+
+XmlWrap::NamesList::const_iterator findName(const XmlWrap::NamesList& names, const ::xmlChar* xmlName)
+{
+    return
+        std::find_if(
+            names.begin(), names.end(),
+            [xmlName](const std::string& n)
+            {
+                return nameEquals(xmlName, n);
+            });
+}
+
+// Whitespace trimmed view of the attribute value. The libxml2 owned text
+// is referenced in place, the copy is made only when the value
+// is not a single text node (contains entity references).
+class PropView
+{
+public:
+    PropView(::xmlNodePtr node, ::xmlAttrPtr prop)
+    {
+        auto* child = prop->children;
+        if ((child != nullptr) && (child->next == nullptr) && (child->type == XML_TEXT_NODE)) {
+            m_value = reinterpret_cast<const char*>(child->content);
+        }
+        else if (child != nullptr) {
+            m_storage.reset(::xmlNodeListGetString(node->doc, child, 1));
+            m_value = reinterpret_cast<const char*>(m_storage.get());
+        }
+
+        if (m_value == nullptr) {
+            return;
+        }
+
+        auto* end = m_value + std::strlen(m_value);
+        while ((m_value < end) && isWhiteSpace(*m_value)) {
+            ++m_value;
+        }
+
+        while ((m_value < end) && isWhiteSpace(*(end - 1))) {
+            --end;
+        }
+
+        m_size = static_cast<std::size_t>(end - m_value);
+    }
+
+    std::string str() const
+    {
+        if (m_size == 0U) {
+            return std::string();
+        }
+
+        return std::string(m_value, m_size);
+    }
+
+private:
+    const char* m_value = nullptr;
+    std::size_t m_size = 0U;
+    XmlWrap::StringPtr m_storage;
+};
+
+::xmlAttrPtr findProp(::xmlNodePtr node, const std::string& name)
+{
+    auto* prop = node->properties;
+    while (prop != nullptr) {
+        if (nameEquals(prop->name, name)) {
+            return prop;
+        }
+
+        prop = prop->next;
+    }
+
+    return nullptr;
+}
+
+} // namespace
+
 const XmlWrap::NamesList& XmlWrap::emptyNamesList()
 {
     static const NamesList List;
@@ -36,25 +125,32 @@ XmlWrap::PropsMap XmlWrap::parseNodeProps(::xmlNodePtr node)
     PropsMap map;
     auto* prop = node->properties;
     while (prop != nullptr) {
-        StringPtr valuePtr(::xmlNodeListGetString(node->doc, prop->children, 1));
-        auto iter = map.insert(
-            std::make_pair(
-                reinterpret_cast<const char*>(prop->name),
-                reinterpret_cast<const char*>(valuePtr.get())));
-        common::removeHeadingTrailingWhitespaces(iter->second);
+        map.emplace(reinterpret_cast<const char*>(prop->name), PropView(node, prop).str());
         prop = prop->next;
     }
 
     return map;
 }
 
+bool XmlWrap::hasProp(::xmlNodePtr node, const std::string& name)
+{
+    assert(node != nullptr);
+    return findProp(node, name) != nullptr;
+}
+
 XmlWrap::NodesList XmlWrap::getChildren(::xmlNodePtr node, const std::string& name)
 {
-    NamesList names;
-    if (!name.empty()) {
-        names.push_back(name);
+    NodesList result;
+    auto* cur = node->children;
+    while (cur != nullptr) {
+        if ((cur->type == XML_ELEMENT_NODE) &&
+            (name.empty() || nameEquals(cur->name, name))) {
+            result.push_back(cur);
+        }
+
+        cur = cur->next;
     }
-    return getChildren(node, names);
+    return result;
 }
 
 XmlWrap::NodesList XmlWrap::getChildren(::xmlNodePtr node, const NamesList& names)
@@ -72,8 +168,7 @@ XmlWrap::NodesList XmlWrap::getChildren(::xmlNodePtr node, const NamesList& name
                 break;
             }
 
-            std::string elemName(reinterpret_cast<const char*>(cur->name));
-            auto iter = std::find(names.begin(), names.end(), elemName);
+            auto iter = findName(names, cur->name);
             if (iter != names.end()) {
                 result.push_back(cur);
                 break;
@@ -110,17 +205,15 @@ std::string XmlWrap::getText(::xmlNodePtr node)
 
 bool XmlWrap::parseNodeValue(
     ::xmlNodePtr node,
-    Logger& logger,
+    const Logger& logger,
     std::string& value,
     bool mustHaveValue)
 {
-    auto props = parseNodeProps(node);
     static const std::string ValueAttr("value");
-    auto valIter = props.find(ValueAttr);
     std::string valueTmp;
-    if (valIter != props.end()) {
-        valueTmp = valIter->second;
-        common::removeHeadingTrailingWhitespaces(valueTmp);
+    auto* valueProp = findProp(node, ValueAttr);
+    if (valueProp != nullptr) {
+        valueTmp = PropView(node, valueProp).str();
     }
 
     auto text = getText(node);
@@ -156,14 +249,16 @@ bool XmlWrap::parseNodeValue(
 bool XmlWrap::parseChildrenAsProps(
     ::xmlNodePtr node,
     const NamesList& names,
-    Logger& logger,
+    const Logger& logger,
     PropsMap& result,
     bool mustHaveValue)
 {
-    auto children = getChildren(node);
-    for (auto* c : children) {
-        std::string cName(reinterpret_cast<const char*>(c->name));
-        auto iter = std::find(names.begin(), names.end(), cName);
+    for (auto* c = node->children; c != nullptr; c = c->next) {
+        if (c->type != XML_ELEMENT_NODE) {
+            continue;
+        }
+
+        auto iter = findName(names, c->name);
         if (iter == names.end()) {
             continue;
         }
@@ -177,7 +272,7 @@ bool XmlWrap::parseChildrenAsProps(
             continue;
         }
 
-        result.insert(std::make_pair(cName, std::move(value)));
+        result.insert(std::make_pair(*iter, std::move(value)));
     }
 
     return true;
@@ -185,14 +280,14 @@ bool XmlWrap::parseChildrenAsProps(
 
 XmlWrap::PropsMap XmlWrap::getUnknownProps(::xmlNodePtr node, const XmlWrap::NamesList& names)
 {
-    auto props = parseNodeProps(node);
-    for (auto& n : names) {
-        auto iters = props.equal_range(n);
-        if (iters.first == iters.second) {
-            continue;
+    PropsMap props;
+    auto* prop = node->properties;
+    while (prop != nullptr) {
+        if (findName(names, prop->name) == names.end()) {
+            props.emplace(reinterpret_cast<const char*>(prop->name), PropView(node, prop).str());
         }
 
-        props.erase(iters.first, iters.second);
+        prop = prop->next;
     }
     return props;
 }
@@ -200,11 +295,8 @@ XmlWrap::PropsMap XmlWrap::getUnknownProps(::xmlNodePtr node, const XmlWrap::Nam
 XmlWrap::NodesList XmlWrap::getUnknownChildren(::xmlNodePtr node, const XmlWrap::NamesList& names)
 {
     NodesList result;
-    auto children = getChildren(node);
-    for (auto* c : children) {
-        std::string cName(reinterpret_cast<const char*>(c->name));
-        auto iter = std::find(names.begin(), names.end(), cName);
-        if (iter == names.end()) {
+    for (auto* c = node->children; c != nullptr; c = c->next) {
+        if ((c->type == XML_ELEMENT_NODE) && (findName(names, c->name) == names.end())) {
             result.push_back(c);
         }
     }
@@ -240,7 +332,11 @@ XmlWrap::ContentsList XmlWrap::getUnknownChildrenContents(::xmlNodePtr node, con
 
 std::string XmlWrap::logPrefix(::xmlNodePtr node)
 {
-    assert(node != nullptr);
+    if (node == nullptr) {
+        // Released streamed node, the objects record their position
+        return std::string();
+    }
+
     assert(node->doc != nullptr);
     assert(node->doc->URL != nullptr);
     return std::string(reinterpret_cast<const char*>(node->doc->URL)) + ":" + std::to_string(node->line) + ": ";
@@ -250,7 +346,7 @@ bool XmlWrap::validateSinglePropInstance(
     ::xmlNodePtr node,
     const PropsMap& props,
     const std::string& str,
-    Logger& logger,
+    const Logger& logger,
     bool mustHave)
 {
     auto count = props.count(str);
@@ -269,7 +365,7 @@ bool XmlWrap::validateSinglePropInstance(
     return true;
 }
 
-bool XmlWrap::validateNoPropInstance(::xmlNodePtr node, const XmlWrap::PropsMap& props, const std::string& str, Logger& logger)
+bool XmlWrap::validateNoPropInstance(::xmlNodePtr node, const XmlWrap::PropsMap& props, const std::string& str, const Logger& logger)
 {
     auto iter = props.find(str);
     if (iter != props.end()) {
@@ -283,12 +379,8 @@ bool XmlWrap::validateNoPropInstance(::xmlNodePtr node, const XmlWrap::PropsMap&
 
 bool XmlWrap::hasAnyChild(::xmlNodePtr node, const XmlWrap::NamesList& names)
 {
-    ContentsList result;
-    auto children = getChildren(node);
-    for (auto* c : children) {
-        std::string cName(reinterpret_cast<const char*>(c->name));
-        auto iter = std::find(names.begin(), names.end(), cName);
-        if (iter != names.end()) {
+    for (auto* c = node->children; c != nullptr; c = c->next) {
+        if ((c->type == XML_ELEMENT_NODE) && (findName(names, c->name) != names.end())) {
             return true;
         }
     }
@@ -300,7 +392,7 @@ void XmlWrap::reportUnexpectedPropertyValue(
     const std::string& elemName,
     const std::string& propName,
     const std::string& propValue,
-    Logger& logger)
+    const Logger& logger)
 {
     commsdsl::logError(logger) << XmlWrap::logPrefix(node) <<
                   "Property \"" << propName << "\" of element \"" << elemName <<
@@ -57,19 +57,20 @@ struct XmlWrap
 
     static const NamesList& emptyNamesList();
     static PropsMap parseNodeProps(::xmlNodePtr node);
+    static bool hasProp(::xmlNodePtr node, const std::string& name);
     static NodesList getChildren(::xmlNodePtr node, const std::string& name = common::emptyString());
     static NodesList getChildren(::xmlNodePtr node, const NamesList& names);
     static std::string getText(::xmlNodePtr node);
     static bool parseNodeValue(
         ::xmlNodePtr node,
-        Logger& logger,
+        const Logger& logger,
         std::string& value,
         bool mustHaveValue = true);
 
     static bool parseChildrenAsProps(
         ::xmlNodePtr node,
         const NamesList& names,
-        Logger& logger,
+        const Logger& logger,
         PropsMap& props,
         bool mustHaveValues = true);
 
@@ -82,14 +83,14 @@ struct XmlWrap
         ::xmlNodePtr node,
         const PropsMap& props,
         const std::string& str,
-        Logger& logger,
+        const Logger& logger,
         bool mustHave = false);
 
     static bool validateNoPropInstance(
         ::xmlNodePtr node,
         const PropsMap& props,
         const std::string& str,
-        Logger& logger);
+        const Logger& logger);
 
     static bool hasAnyChild(::xmlNodePtr node, const NamesList& names);
 
@@ -98,7 +99,7 @@ struct XmlWrap
         const std::string& elemName,
         const std::string& propName,
         const std::string& propValue,
-        Logger& logger);
+        const Logger& logger);
 
     static bool checkVersions(
         ::xmlNodePtr node,
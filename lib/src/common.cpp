@@ -19,6 +19,8 @@
 #include <iterator>
 #include <cctype>
 #include <cmath>
+#include <cerrno>
+#include <cstdlib>
 #include <cassert>
 #include <limits>
 
@@ -32,9 +34,181 @@ namespace
 {
 
 const std::size_t MaxPossibleLength = std::numeric_limits<std::size_t>::max();
+const unsigned InvalidDigit = 36U;
 
+bool isSpaceChar(char ch)
+{
+    return (ch == ' ') || (('\t' <= ch) && (ch <= '\r'));
+}
+
+unsigned digitValue(char ch)
+{
+    if (('0' <= ch) && (ch <= '9')) {
+        return static_cast<unsigned>(ch - '0');
+    }
+
+    if (('a' <= ch) && (ch <= 'z')) {
+        return static_cast<unsigned>(ch - 'a') + 10U;
+    }
+
+    if (('A' <= ch) && (ch <= 'Z')) {
+        return static_cast<unsigned>(ch - 'A') + 10U;
+    }
+
+    return InvalidDigit;
+}
+
+// Follows the strtoull() rules: leading white spaces, optional sign,
+// "0x" / "0" prefixes when base is 0 and the longest run of digits,
+// trailing characters are ignored. Doesn't depend on the locale.
+bool parseIntLiteral(const std::string& str, int base, std::uintmax_t& magnitude, bool& negative)
+{
+    assert((base == 0) || ((2 <= base) && (base <= 36)));
+    auto* pos = str.c_str();
+    while (isSpaceChar(*pos)) {
+        ++pos;
+    }
+
+    negative = (*pos == '-');
+    if ((*pos == '-') || (*pos == '+')) {
+        ++pos;
+    }
+
+    bool hexPrefix =
+        (pos[0] == '0') &&
+        ((pos[1] == 'x') || (pos[1] == 'X')) &&
+        (digitValue(pos[2]) < 16U);
+
+    if (((base == 0) || (base == 16)) && hexPrefix) {
+        base = 16;
+        pos += 2;
+    }
+    else if (base == 0) {
+        base = (pos[0] == '0') ? 8 : 10;
+    }
+
+    auto baseVal = static_cast<unsigned>(base);
+    static const std::uintmax_t MaxValue = std::numeric_limits<std::uintmax_t>::max();
+    magnitude = 0U;
+    bool overflow = false;
+    auto* digitsStart = pos;
+    while (true) {
+        auto digit = digitValue(*pos);
+        if (baseVal <= digit) {
+            break;
+        }
+
+        ++pos;
+        if (overflow) {
+            continue;
+        }
+
+        if (((MaxValue - digit) / baseVal) < magnitude) {
+            overflow = true;
+            continue;
+        }
+
+        magnitude = (magnitude * baseVal) + digit;
+    }
+
+    return (digitsStart != pos) && (!overflow);
 }
 
+// Exact conversion of simple decimal literals: when both the mantissa and
+// the power of 10 are exactly representable a single multiplication or
+// division gives correctly rounded result.
+bool parseSimpleDouble(const std::string& str, double& result)
+{
+    static const std::uint64_t MaxExactMantissa = std::uint64_t(1U) << 53U;
+    static const int MaxExactPow10 = 22;
+    static const double Pow10[MaxExactPow10 + 1] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    auto* pos = str.c_str();
+    bool negative = (*pos == '-');
+    if ((*pos == '-') || (*pos == '+')) {
+        ++pos;
+    }
+
+    std::uint64_t mantissa = 0U;
+    int exp = 0;
+    unsigned digitsCount = 0U;
+    bool seenDot = false;
+    while (true) {
+        if ((*pos == '.') && (!seenDot)) {
+            seenDot = true;
+            ++pos;
+            continue;
+        }
+
+        auto digit = digitValue(*pos);
+        if (10U <= digit) {
+            break;
+        }
+
+        ++pos;
+        ++digitsCount;
+        if (MaxExactMantissa < ((mantissa * 10U) + digit)) {
+            return false;
+        }
+
+        mantissa = (mantissa * 10U) + digit;
+        if (seenDot) {
+            --exp;
+        }
+    }
+
+    if (digitsCount == 0U) {
+        return false;
+    }
+
+    if ((*pos == 'e') || (*pos == 'E')) {
+        ++pos;
+        bool negExp = (*pos == '-');
+        if ((*pos == '-') || (*pos == '+')) {
+            ++pos;
+        }
+
+        int expVal = 0;
+        auto* expStart = pos;
+        while (digitValue(*pos) < 10U) {
+            if (MaxExactPow10 < expVal) {
+                return false;
+            }
+
+            expVal = (expVal * 10) + static_cast<int>(digitValue(*pos));
+            ++pos;
+        }
+
+        if (expStart == pos) {
+            return false;
+        }
+
+        exp += negExp ? -expVal : expVal;
+    }
+
+    if ((*pos != '\0') || (exp < -MaxExactPow10) || (MaxExactPow10 < exp)) {
+        return false;
+    }
+
+    result = static_cast<double>(mantissa);
+    if (exp < 0) {
+        result /= Pow10[-exp];
+    }
+    else {
+        result *= Pow10[exp];
+    }
+
+    if (negative) {
+        result = -result;
+    }
+    return true;
+}
+
+} // namespace
+
 const std::string& emptyString()
 {
     static const std::string Str;
@@ -733,53 +907,75 @@ const std::string& forceGenStr()
 
 unsigned strToUnsigned(const std::string& str, bool* ok, int base)
 {
-    unsigned result = 0U;
-    try {
-        result = static_cast<decltype(result)>(std::stoul(str, 0, base));
-        if (ok != nullptr) {
-            *ok = true;
-        }
+    std::uintmax_t magnitude = 0U;
+    bool negative = false;
+    bool result =
+        parseIntLiteral(str, base, magnitude, negative) &&
+        (magnitude <= std::numeric_limits<unsigned long>::max());
 
-    } catch (...) {
-        if (ok != nullptr) {
-            *ok = false;
-        }
+    if (ok != nullptr) {
+        *ok = result;
     }
-    return result;
+
+    if (!result) {
+        return 0U;
+    }
+
+    auto value = static_cast<unsigned long>(magnitude);
+    if (negative) {
+        value = 0UL - value;
+    }
+
+    return static_cast<unsigned>(value);
 }
 
 std::intmax_t strToIntMax(const std::string& str, bool* ok, int base)
 {
-    std::intmax_t result = 0;
-    try {
-        result = std::stoll(str, 0, base);
-        if (ok != nullptr) {
-            *ok = true;
-        }
+    std::uintmax_t magnitude = 0U;
+    bool negative = false;
+    bool result = parseIntLiteral(str, base, magnitude, negative);
+    static const auto MaxValue = static_cast<std::uintmax_t>(std::numeric_limits<std::intmax_t>::max());
+    if (result) {
+        result = (magnitude <= MaxValue) || (negative && (magnitude == (MaxValue + 1U)));
+    }
 
-    } catch (...) {
-        if (ok != nullptr) {
-            *ok = false;
-        }
+    if (ok != nullptr) {
+        *ok = result;
     }
-    return result;
+
+    if (!result) {
+        return 0;
+    }
+
+    if (!negative) {
+        return static_cast<std::intmax_t>(magnitude);
+    }
+
+    if (magnitude == (MaxValue + 1U)) {
+        return std::numeric_limits<std::intmax_t>::min();
+    }
+
+    return -static_cast<std::intmax_t>(magnitude);
 }
 
 std::uintmax_t strToUintMax(const std::string& str, bool* ok, int base)
 {
-    std::uintmax_t result = 0U;
-    try {
-        result = std::stoull(str, 0, base);
-        if (ok != nullptr) {
-            *ok = true;
-        }
+    std::uintmax_t magnitude = 0U;
+    bool negative = false;
+    bool result = parseIntLiteral(str, base, magnitude, negative);
+    if (ok != nullptr) {
+        *ok = result;
+    }
 
-    } catch (...) {
-        if (ok != nullptr) {
-            *ok = false;
-        }
+    if (!result) {
+        return 0U;
     }
-    return result;
+
+    if (negative) {
+        return std::uintmax_t(0U) - magnitude;
+    }
+
+    return magnitude;
 }
 
 double strToDouble(const std::string& str, bool* ok, bool allowSpecials)
@@ -807,16 +1003,37 @@ double strToDouble(const std::string& str, bool* ok, bool allowSpecials)
     }
 
     double result = 0.0;
-    try {
-        result = std::stod(str, 0);
+    if (parseSimpleDouble(str, result)) {
         updateOk(true);
+        return result;
+    }
 
-    } catch (...) {
+    // Hex floats, long mantissas, big exponents, textual specials
+    auto* begin = str.c_str();
+    char* end = nullptr;
+    errno = 0;
+    result = std::strtod(begin, &end);
+    if ((end == begin) || (errno == ERANGE)) {
         updateOk(false);
+        return 0.0;
     }
+
+    updateOk(true);
     return result;
 }
 
+bool decodeHexByte(char high, char low, std::uint8_t& byte)
+{
+    auto highVal = digitValue(high);
+    auto lowVal = digitValue(low);
+    if ((16U <= highVal) || (16U <= lowVal)) {
+        return false;
+    }
+
+    byte = static_cast<std::uint8_t>((highVal << 4U) | lowVal);
+    return true;
+}
+
 bool strToBool(const std::string& str, bool* ok)
 {
     auto updateOkFunc =
@@ -152,6 +152,7 @@ unsigned strToUnsigned(const std::string& str, bool* ok = nullptr, int base = 0)
 std::intmax_t strToIntMax(const std::string& str, bool* ok = nullptr, int base = 0);
 std::uintmax_t strToUintMax(const std::string& str, bool* ok = nullptr, int base = 0);
 double strToDouble(const std::string& str, bool* ok = nullptr, bool allowSpecials = true);
+bool decodeHexByte(char high, char low, std::uint8_t& byte);
 bool strToBool(const std::string& str, bool* ok = nullptr);
 bool isFpSpecial(const std::string& str);
 Units strToUnits(const std::string& str, bool* ok = nullptr);
@@ -13,7 +13,37 @@ void CommonTestSuite::commonTearDown()
 
 CommonTestSuite::ProtocolPtr CommonTestSuite::prepareProtocol(const std::string& schema)
 {
-    static_cast<void>(schema);
+    auto protocol = createProtocol();
+    bool parseResult = protocol->parse(schema);
+    TS_ASSERT_EQUALS(parseResult, m_status.m_expParseResult);
+    finaliseProtocol(*protocol, schema);
+    return protocol;
+}
+
+CommonTestSuite::ProtocolPtr CommonTestSuite::prepareProtocol(const FilesList& schemas, unsigned jobs)
+{
+    TS_ASSERT(!schemas.empty());
+    auto protocol = createProtocol();
+    bool parseResult = protocol->parseAll(schemas, jobs);
+    TS_ASSERT_EQUALS(parseResult, m_status.m_expParseResult);
+    finaliseProtocol(*protocol, schemas.front());
+    return protocol;
+}
+
+CommonTestSuite::ProtocolPtr CommonTestSuite::prepareStreamedProtocol(const FilesList& schemas)
+{
+    TS_ASSERT(!schemas.empty());
+    auto protocol = createProtocol();
+    for (auto& s : schemas) {
+        bool parseResult = protocol->parseStreamed(s);
+        TS_ASSERT_EQUALS(parseResult, m_status.m_expParseResult);
+    }
+    finaliseProtocol(*protocol, schemas.front());
+    return protocol;
+}
+
+CommonTestSuite::ProtocolPtr CommonTestSuite::createProtocol()
+{
     ProtocolPtr protocol(new commsdsl::Protocol);
     protocol->setErrorReportCallback(
         [this](commsdsl::ErrorLevel level, const std::string& msg)
@@ -50,14 +80,16 @@ CommonTestSuite::ProtocolPtr CommonTestSuite::prepareProtocol(const std::string&
             m_status.m_expErrors.erase(m_status.m_expErrors.begin());
         });
 
-    bool parseResult = protocol->parse(schema);
-    TS_ASSERT_EQUALS(parseResult, m_status.m_expParseResult);
+    return protocol;
+}
 
+void CommonTestSuite::finaliseProtocol(commsdsl::Protocol& protocol, const std::string& schema)
+{
     if (m_status.m_preValidateFunc) {
-        m_status.m_preValidateFunc(*protocol);
+        m_status.m_preValidateFunc(protocol);
     }
 
-    bool validateResult = protocol->validate();
+    bool validateResult = protocol.validate();
     TS_ASSERT_EQUALS(validateResult, m_status.m_expValidateResult);
 
     auto dotPos = schema.find_last_of('.');
@@ -77,6 +109,5 @@ CommonTestSuite::ProtocolPtr CommonTestSuite::prepareProtocol(const std::string&
     TS_ASSERT_LESS_THAN(slashPos, dotPos);
     ++slashPos;
     auto expSchemaName = schema.substr(slashPos, dotPos - slashPos);
-    TS_ASSERT_EQUALS(protocol->schema().name(), expSchemaName);
-    return protocol;
+    TS_ASSERT_EQUALS(protocol.schema().name(), expSchemaName);
 }
@@ -23,9 +23,12 @@ protected:
     using ProtocolPtr = std::unique_ptr<commsdsl::Protocol>;
     using ErrLevelList = std::vector<commsdsl::ErrorLevel>;
     using PreValidateFunc = std::function<void (commsdsl::Protocol& protocol)>;
+    using FilesList = commsdsl::Protocol::FilesList;
 
 
     ProtocolPtr prepareProtocol(const std::string& schema);
+    ProtocolPtr prepareProtocol(const FilesList& schemas, unsigned jobs = 0U);
+    ProtocolPtr prepareStreamedProtocol(const FilesList& schemas);
 
     struct TestStatus
     {
@@ -36,4 +39,8 @@ protected:
     };
 
     TestStatus m_status;
+
+private:
+    ProtocolPtr createProtocol();
+    void finaliseProtocol(commsdsl::Protocol& protocol, const std::string& schema);
 };